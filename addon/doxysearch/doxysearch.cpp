@@ -23,6 +23,8 @@
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <cstring>
 
 // Xapian includes
 #include <xapian.h>
@@ -31,6 +33,9 @@
 #include <windows.h>
 #else
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 #define FIELD_TYPE 1
@@ -67,6 +72,17 @@ bool dirExists(const std::string& dirName)
   return false;
 }
 
+bool fileExists(const std::string& fileName)
+{
+#ifdef _WIN32
+  DWORD ftyp = GetFileAttributesA(fileName.c_str());
+  return ftyp!=INVALID_FILE_ATTRIBUTES && !(ftyp & FILE_ATTRIBUTE_DIRECTORY);
+#else
+  struct stat sb;
+  return stat(fileName.c_str(), &sb)==0 && S_ISREG(sb.st_mode);
+#endif
+}
+
 
 /** decodes a URI encoded string into a normal string. */
 static std::string uriDecode(const std::string & sSrc)
@@ -306,6 +322,267 @@ static void showError(const std::string &callback,const std::string &error)
   exit(0);
 }
 
+/** Writes the part of the JSONP result that precedes the items */
+static void writeResultHeader(const std::string &callback,const std::string &searchFor,
+                              unsigned int hits,unsigned int offset,int num,int page,
+                              unsigned int pages)
+{
+  std::cout << callback.c_str() << "(";
+  std::cout << "{" << std::endl 
+            << "  \"hits\":"   << hits   << "," << std::endl
+            << "  \"first\":"  << offset << "," << std::endl
+            << "  \"count\":"  << num    << "," << std::endl
+            << "  \"page\":"   << page   << "," << std::endl
+            << "  \"pages\":"  << pages  << "," << std::endl
+            << "  \"query\": \""  << escapeString(searchFor)  << "\"," << std::endl
+            << "  \"items\":[" << std::endl;
+}
+
+//------------------------------------------------------------------------
+
+/** Document as stored in the compact index */
+struct CompactDoc
+{
+  const char *type;
+  const char *name;
+  const char *args;
+  const char *tag;
+  const char *url;
+};
+
+/** Read-only view on the compact search index that doxygen writes when
+ *  SEARCHDATA_INDEX is set. See SearchIndexExternal::writeCompactIndex() 
+ *  in doxygen's searchindex.cpp for the file format. The file is mapped
+ *  into memory, so a query only touches the parts of the index it needs.
+ */
+class CompactIndex
+{
+  public:
+    CompactIndex() : m_data(0), m_size(0), m_numTerms(0), m_numBlocks(0), 
+                     m_numDocs(0), m_blockIndex(0), m_docIndex(0)
+#ifdef _WIN32
+                     , m_file(INVALID_HANDLE_VALUE), m_mapping(0)
+#endif
+    {}
+   ~CompactIndex() { close(); }
+    bool open(const std::string &fileName);
+    void close();
+    /** Adds the scores of the documents containing \a term to \a scores.
+     *  Returns false if the term is not in the index. */
+    bool addPostings(const std::string &term,std::map<unsigned int,int> &scores) const;
+    CompactDoc document(unsigned int index) const;
+    unsigned int numDocs() const { return m_numDocs; }
+
+  private:
+    unsigned int readInt(unsigned int offset) const
+    {
+      const unsigned char *p = m_data+offset;
+      return (p[0]<<24)+(p[1]<<16)+(p[2]<<8)+p[3];
+    }
+    unsigned int readVarint(unsigned int &offset) const
+    {
+      unsigned int v=0;
+      int shift=0;
+      while (offset<m_size && shift<32)
+      {
+        unsigned char c = m_data[offset++];
+        v|=(c&0x7f)<<shift;
+        if ((c&0x80)==0) break;
+        shift+=7;
+      }
+      return v;
+    }
+    const unsigned char *m_data;
+    unsigned int m_size;
+    unsigned int m_numTerms;
+    unsigned int m_numBlocks;
+    unsigned int m_numDocs;
+    unsigned int m_blockIndex;
+    unsigned int m_docIndex;
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif
+};
+
+// must match compactTermsPerBlock in doxygen's searchindex.cpp
+#define COMPACT_TERMS_PER_BLOCK 16
+
+bool CompactIndex::open(const std::string &fileName)
+{
+#ifdef _WIN32
+  m_file = CreateFileA(fileName.c_str(),GENERIC_READ,FILE_SHARE_READ,0,
+                       OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,0);
+  if (m_file==INVALID_HANDLE_VALUE) return false;
+  m_size = GetFileSize(m_file,0);
+  m_mapping = CreateFileMappingA(m_file,0,PAGE_READONLY,0,0,0);
+  if (m_mapping==0) { close(); return false; }
+  m_data = (const unsigned char *)MapViewOfFile(m_mapping,FILE_MAP_READ,0,0,0);
+  if (m_data==0) { close(); return false; }
+#else
+  int fd = ::open(fileName.c_str(),O_RDONLY);
+  if (fd==-1) return false;
+  struct stat sb;
+  if (fstat(fd,&sb)!=0 || sb.st_size==0) { ::close(fd); return false; }
+  void *data = mmap(0,sb.st_size,PROT_READ,MAP_SHARED,fd,0);
+  ::close(fd);
+  if (data==MAP_FAILED) return false;
+  m_data = (const unsigned char *)data;
+  m_size = sb.st_size;
+#endif
+  if (m_size<28 || memcmp(m_data,"DOXC",4)!=0 || readInt(4)!=1)
+  {
+    close();
+    return false;
+  }
+  m_numTerms   = readInt(8);
+  m_numBlocks  = readInt(12);
+  m_numDocs    = readInt(16);
+  m_blockIndex = readInt(20);
+  m_docIndex   = readInt(24);
+  if (m_blockIndex>m_size || m_numBlocks>(m_size-m_blockIndex)/4 ||
+      m_docIndex>m_size   || m_numDocs>(m_size-m_docIndex)/4 ||
+      (m_numDocs>0 && (m_docIndex==0 || m_data[m_docIndex-1]!=0)))
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void CompactIndex::close()
+{
+#ifdef _WIN32
+  if (m_data)    UnmapViewOfFile(m_data);
+  if (m_mapping) CloseHandle(m_mapping);
+  if (m_file!=INVALID_HANDLE_VALUE) CloseHandle(m_file);
+  m_mapping = 0;
+  m_file = INVALID_HANDLE_VALUE;
+#else
+  if (m_data) munmap((void*)m_data,m_size);
+#endif
+  m_data = 0;
+  m_size = 0;
+}
+
+bool CompactIndex::addPostings(const std::string &term,
+                               std::map<unsigned int,int> &scores) const
+{
+  if (m_numBlocks==0) return false;
+  // find the last block whose first term is not larger than term
+  unsigned int lo=0,hi=m_numBlocks;
+  while (hi-lo>1)
+  {
+    unsigned int mid = (lo+hi)/2;
+    unsigned int offset = readInt(m_blockIndex+mid*4);
+    readVarint(offset); // length of the shared prefix, always 0
+    unsigned int len = readVarint(offset);
+    if (offset>m_size || len>m_size-offset) return false;
+    if (term.compare(0,std::string::npos,(const char *)m_data+offset,len)<0)
+      hi=mid;
+    else
+      lo=mid;
+  }
+  // scan the block
+  unsigned int offset = readInt(m_blockIndex+lo*4);
+  unsigned int remaining = m_numTerms-lo*COMPACT_TERMS_PER_BLOCK;
+  unsigned int i,n = remaining<COMPACT_TERMS_PER_BLOCK ? remaining : COMPACT_TERMS_PER_BLOCK;
+  std::string word;
+  for (i=0;i<n;i++)
+  {
+    unsigned int shared = readVarint(offset);
+    unsigned int len    = readVarint(offset);
+    if (shared>word.length() || offset>m_size || len>m_size-offset) return false;
+    word.replace(shared,std::string::npos,(const char *)m_data+offset,len);
+    offset+=len;
+    unsigned int count    = readVarint(offset);
+    unsigned int postings = readVarint(offset);
+    if (word==term)
+    {
+      unsigned int j,doc=0;
+      for (j=0;j<count && postings<m_size;j++)
+      {
+        doc+=readVarint(postings);
+        unsigned int freq = readVarint(postings);
+        // every occurrence counts, high priority documents get a bonus
+        scores[doc] += (freq>>1) + ((freq&1) ? 100 : 0);
+      }
+      return true;
+    }
+    else if (word>term)
+    {
+      break;
+    }
+  }
+  return false;
+}
+
+CompactDoc CompactIndex::document(unsigned int index) const
+{
+  CompactDoc doc;
+  const char *p = (const char *)m_data+readInt(m_docIndex+index*4);
+  doc.type = p; p+=strlen(p)+1;
+  doc.name = p; p+=strlen(p)+1;
+  doc.args = p; p+=strlen(p)+1;
+  doc.tag  = p; p+=strlen(p)+1;
+  doc.url  = p;
+  return doc;
+}
+
+/** Class representing the '>' operator for (document,score) pairs based on score. */
+struct Score_greater
+{
+  bool operator()(const std::pair<unsigned int,int> &p1,
+                  const std::pair<unsigned int,int> &p2)
+  {
+    return p1.second>p2.second || (p1.second==p2.second && p1.first<p2.first);
+  }
+};
+
+/** Searches for \a words in the compact \a index and writes the results as JSONP */
+static void searchCompactIndex(const CompactIndex &index,
+                               const std::string &callback,const std::string &searchFor,
+                               const std::vector<std::string> &words,int num,int page)
+{
+  std::map<unsigned int,int> scores;
+  for (std::vector<std::string>::const_iterator it=words.begin();it!=words.end();++it)
+  {
+    std::string lword = *it;
+    std::transform(lword.begin(), lword.end(), lword.begin(), ::tolower);
+    index.addPostings(lword,scores);
+  }
+  std::vector< std::pair<unsigned int,int> > matches;
+  for (std::map<unsigned int,int>::const_iterator it=scores.begin();it!=scores.end();++it)
+  {
+    if (it->first<index.numDocs()) matches.push_back(*it);
+  }
+  std::sort(matches.begin(),matches.end(),Score_greater());
+
+  unsigned int hits    = matches.size();
+  unsigned int offset  = page*num;
+  unsigned int pages   = num>0 ? (hits+num-1)/num : 0;
+  if (offset>hits)     offset=hits;
+  if (offset+num>hits) num=hits-offset;
+
+  writeResultHeader(callback,searchFor,hits,offset,num,page,pages);
+  for (unsigned int o=offset;o<offset+num;o++)
+  {
+    CompactDoc doc = index.document(matches[o].first);
+    std::cout << "  {\"type\": \"" << doc.type << "\"," << std::endl
+              << "   \"name\": \"" << doc.name << doc.args << "\"," << std::endl
+              << "   \"tag\": \""  << doc.tag << "\"," << std::endl
+              << "   \"url\": \""  << doc.url << "\"," << std::endl
+              << "   \"fragments\":[" << std::endl
+              << "   ]" << std::endl
+              << "  }";
+    if (o<offset+num-1) std::cout << ",";
+    std::cout << std::endl;
+  }
+  std::cout << " ]" << std::endl << "})" << std::endl;
+}
+
+//------------------------------------------------------------------------
+
 /** Main routine */
 int main(int argc,char **argv)
 {
@@ -348,11 +625,12 @@ int main(int argc,char **argv)
       }
     }
 
-    std::string indexDir = "doxysearch.db";
+    std::string indexDir  = "doxysearch.db";
+    std::string indexFile = "doxysearch.idx"; // compact index written by doxygen
 
     if (queryString=="test") // user test
     {
-      bool dbOk = dirExists(indexDir);
+      bool dbOk = fileExists(indexFile) || dirExists(indexDir);
       if (dbOk)
       {
         std::cout << "Test successful.";
@@ -364,11 +642,22 @@ int main(int argc,char **argv)
       exit(0);
     }
 
+    std::vector<std::string> words = split(searchFor,' ');
+    if (fileExists(indexFile)) // use the compact index
+    {
+      CompactIndex index;
+      if (!index.open(indexFile))
+      {
+        showError(callback,"Cannot read search index "+indexFile);
+      }
+      searchCompactIndex(index,callback,searchFor,words,num,page);
+      return 0;
+    }
+
     // create query
     Xapian::Database db(indexDir);
     Xapian::Enquire enquire(db);
     Xapian::Query query;
-    std::vector<std::string> words = split(searchFor,' ');
     for (std::vector<std::string>::const_iterator it=words.begin();it!=words.end();++it)
     {
       query = Xapian::Query(Xapian::Query::OP_OR,query,Xapian::Query(*it));
@@ -384,15 +673,7 @@ int main(int argc,char **argv)
     if (offset+num>hits) num=hits-offset;
 
     // write results as JSONP
-    std::cout << callback.c_str() << "(";
-    std::cout << "{" << std::endl 
-              << "  \"hits\":"   << hits   << "," << std::endl
-              << "  \"first\":"  << offset << "," << std::endl
-              << "  \"count\":"  << num    << "," << std::endl
-              << "  \"page\":"   << page   << "," << std::endl
-              << "  \"pages\":"  << pages  << "," << std::endl
-              << "  \"query\": \""  << escapeString(searchFor)  << "\"," << std::endl
-              << "  \"items\":[" << std::endl;
+    writeResultHeader(callback,searchFor,hits,offset,num,page,pages);
     // foreach search result
     unsigned int o = offset;
     for (Xapian::MSetIterator i = matches.begin(); i != matches.end(); ++i,++o) 
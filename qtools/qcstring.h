@@ -180,14 +180,31 @@ Q_EXPORT QDataStream &operator>>( QDataStream &, QByteArray & );
 
 class QRegExp;
 
+// size of the reference count stored in front of the characters of a string
+#define QCSTRING_HEADER_SIZE 8
+
 /** This is an alternative implementation of QCString. It provides basically
  *  the same functions but uses less memory for administration. This class
- *  is just a wrapper around a plain C string requiring only 4 bytes "overhead".
- *  QCString features sharing of data and stores the string length, but 
- *  requires 4 + 12 bytes for this (even for the empty string). As doxygen 
- *  uses a LOT of string during a run it saves a lot of memory to use a 
- *  more memory efficient implementation at the cost of relatively low
- *  runtime overhead.
+ *  is just a wrapper around a pointer to a C string, which is preceded by
+ *  a reference count. The empty string does not use any memory.
+ *
+ *  Copies of a string share the characters, which are copied only when one
+ *  of the copies is modified. Since the non-const data(), at() and
+ *  operator[] return a pointer or reference through which the string can
+ *  be modified, calling them on a shared string gives it its own copy as
+ *  well. Their const versions only read the string and never copy it.
+ *  The reference counts are updated atomically, so strings can be
+ *  copied between threads.
+ *
+ *  A pointer or reference obtained from the non-const data(), at() or
+ *  operator[] may only be used to modify the string until the string is
+ *  copied. After <code>char *p=s.data(); QCString t=s;</code> writing
+ *  through \c p changes \c t as well. Call data() again after a copy.
+ *
+ *  Strings that are kept for a long time and have many equal values,
+ *  such as names, types and file names, can be stored with intern(), so
+ *  all equal strings share the same characters. clearInternPool() drops
+ *  the pool; the interned strings stay valid.
  */
 class QCString 
 {
@@ -199,14 +216,18 @@ public:
     QCString( const char *str, uint maxlen );
     ~QCString();
 
-    QCString    &operator=( const QCString &s );// deep copy
+    QCString    &operator=( const QCString &s );// shares data
     QCString    &operator=( const char *str );	// deep copy
 
     bool        isNull()        const;
     bool	isEmpty()	const;
     uint	length()	const;
     uint        size()          const { return m_data ? length()+1 : 0; }
-    char *      data()          const { return m_data; }
+    char *      data()
+		{ return isShared() ? detach() : m_data; }
+    const char *data()          const { return m_data; }
+    QCString	intern()	const;
+    static void clearInternPool();
     bool	resize( uint newlen );
     bool	truncate( uint pos );
     bool	fill( char c, int len = -1 );
@@ -265,57 +286,30 @@ public:
 		operator const char *() const;
     QCString    &operator+=( const char *str );
     QCString    &operator+=( char c );
-    char &at( uint index ) const;
-    char &operator[]( int i ) const { return at(i); }
+    char &at( uint index );
+    char at( uint index ) const { return m_data[index]; }
+    char &operator[]( int i ) { return at(i); }
+    char operator[]( int i ) const { return m_data[i]; }
     
   private:
     static void msg_index( uint );
-    void duplicate( const QCString &s );
-    void duplicate( const char *str);
-    QCString &duplicate( const char *str, int);
+    bool isShared() const
+    {
+#if defined(__ATOMIC_RELAXED)
+      return m_data && __atomic_load_n((const int *)(m_data-QCSTRING_HEADER_SIZE),__ATOMIC_RELAXED)>1;
+#else
+      return m_data && *(const volatile int *)(m_data-QCSTRING_HEADER_SIZE)>1;
+#endif
+    }
+    char *detach() const;
+    char *reserve( uint size );
 
     char *      m_data;
 };
 
-inline char &QCString::at( uint index ) const
+inline char &QCString::at( uint index )
 {
-  return m_data[index];
-}
-
-inline void QCString::duplicate( const QCString &s )
-{
-  if (!s.isEmpty()) 
-  {
-    uint l = (uint)strlen(s.data());
-    m_data = (char *)malloc(l+1);
-    if (m_data) memcpy(m_data,s.data(),l+1);
-  }
-  else 
-  {
-    m_data=0; 
-  }
-}
-
-inline void QCString::duplicate( const char *str)
-{
-  if (str && str[0]!='\0') 
-  {
-    uint l = (uint)strlen(str);
-    m_data = (char *)malloc(l+1);
-    if (m_data) memcpy(m_data,str,l+1);
-  }
-  else 
-  {
-    m_data=0;
-  }
-}
-
-inline QCString &QCString::duplicate( const char *str, int)
-{
-  if (m_data==str) return *this;
-  if (m_data) free(m_data);
-  duplicate(str);
-  return *this;
+  return data()[index];
 }
 
 /*****************************************************************************
@@ -330,26 +324,23 @@ Q_EXPORT QDataStream &operator>>( QDataStream &, QCString & );
   QCString inline functions
  *****************************************************************************/
 
-inline QCString &QCString::operator=( const QCString &s )
-{ return (QCString&)assign( s ); }
-
 inline QCString &QCString::operator=( const char *str )
-{ return (QCString&)duplicate( str, qstrlen(str)+1 ); }
+{ return assign( str ); }
 
 inline bool QCString::isNull() const
-{ return data() == 0; }
+{ return m_data == 0; }
 
 inline bool QCString::isEmpty() const
-{ return data() == 0 || *data() == '\0'; }
+{ return m_data == 0 || *m_data == '\0'; }
 
 inline uint QCString::length() const
-{ return qstrlen( data() ); }
+{ return qstrlen( m_data ); }
 
 inline bool QCString::truncate( uint pos )
 { return resize(pos+1); }
 
 inline QCString QCString::copy() const
-{ return QCString( data() ); }
+{ return QCString( m_data ); }
 
 inline QCString &QCString::prepend( const char *s )
 { return insert(0,s); }
@@ -373,7 +364,7 @@ inline QCString &QCString::setNum( float n, char f, int prec )
 { return setNum((double)n,f,prec); }
 
 inline QCString::operator const char *() const
-{ return (const char *)data(); }
+{ return (const char *)m_data; }
 
 
 /*****************************************************************************
@@ -381,49 +372,49 @@ inline QCString::operator const char *() const
  *****************************************************************************/
 
 Q_EXPORT inline bool operator==( const QCString &s1, const QCString &s2 )
-{ return qstrcmp(s1.data(),s2.data()) == 0; }
+{ return qstrcmp(s1,s2) == 0; }
 
 Q_EXPORT inline bool operator==( const QCString &s1, const char *s2 )
-{ return qstrcmp(s1.data(),s2) == 0; }
+{ return qstrcmp(s1,s2) == 0; }
 
 Q_EXPORT inline bool operator==( const char *s1, const QCString &s2 )
-{ return qstrcmp(s1,s2.data()) == 0; }
+{ return qstrcmp(s1,s2) == 0; }
 
 Q_EXPORT inline bool operator!=( const QCString &s1, const QCString &s2 )
-{ return qstrcmp(s1.data(),s2.data()) != 0; }
+{ return qstrcmp(s1,s2) != 0; }
 
 Q_EXPORT inline bool operator!=( const QCString &s1, const char *s2 )
-{ return qstrcmp(s1.data(),s2) != 0; }
+{ return qstrcmp(s1,s2) != 0; }
 
 Q_EXPORT inline bool operator!=( const char *s1, const QCString &s2 )
-{ return qstrcmp(s1,s2.data()) != 0; }
+{ return qstrcmp(s1,s2) != 0; }
 
 Q_EXPORT inline bool operator<( const QCString &s1, const QCString& s2 )
-{ return qstrcmp(s1.data(),s2.data()) < 0; }
+{ return qstrcmp(s1,s2) < 0; }
 
 Q_EXPORT inline bool operator<( const QCString &s1, const char *s2 )
-{ return qstrcmp(s1.data(),s2) < 0; }
+{ return qstrcmp(s1,s2) < 0; }
 
 Q_EXPORT inline bool operator<( const char *s1, const QCString &s2 )
-{ return qstrcmp(s1,s2.data()) < 0; }
+{ return qstrcmp(s1,s2) < 0; }
 
 Q_EXPORT inline bool operator<=( const QCString &s1, const char *s2 )
-{ return qstrcmp(s1.data(),s2) <= 0; }
+{ return qstrcmp(s1,s2) <= 0; }
 
 Q_EXPORT inline bool operator<=( const char *s1, const QCString &s2 )
-{ return qstrcmp(s1,s2.data()) <= 0; }
+{ return qstrcmp(s1,s2) <= 0; }
 
 Q_EXPORT inline bool operator>( const QCString &s1, const char *s2 )
-{ return qstrcmp(s1.data(),s2) > 0; }
+{ return qstrcmp(s1,s2) > 0; }
 
 Q_EXPORT inline bool operator>( const char *s1, const QCString &s2 )
-{ return qstrcmp(s1,s2.data()) > 0; }
+{ return qstrcmp(s1,s2) > 0; }
 
 Q_EXPORT inline bool operator>=( const QCString &s1, const char *s2 )
-{ return qstrcmp(s1.data(),s2) >= 0; }
+{ return qstrcmp(s1,s2) >= 0; }
 
 Q_EXPORT inline bool operator>=( const char *s1, const QCString &s2 )
-{ return qstrcmp(s1,s2.data()) >= 0; }
+{ return qstrcmp(s1,s2) >= 0; }
 
 Q_EXPORT inline QCString operator+( const QCString &s1, const QCString &s2 )
 {
@@ -453,7 +444,7 @@ Q_EXPORT inline QCString operator+( const char *s1, const QCString &s2 )
 
 Q_EXPORT inline QCString operator+( const QCString &s1, char c2 )
 {
-    QCString tmp( s1.data() );
+    QCString tmp( s1 );
     tmp += c2;
     return tmp;
 }
@@ -473,7 +464,7 @@ inline const char *qPrint(const char *s)
 
 inline const char *qPrint(const QCString &s)
 {
-  if (!s.isEmpty()) return s.data(); else return "";
+  if (!s.isEmpty()) return s; else return "";
 }
 
 
@@ -637,8 +637,7 @@ int64 QFile::pos() const
 {
   if (isOpen())
   {
-    // TODO: support 64 bit size
-    return ftell( fh );
+    return ftello( fh );
   }
   return -1;
 }
@@ -647,10 +646,9 @@ int64 QFile::toEnd()
 {
   if (isOpen())
   {
-     // TODO: support 64 bit size
-     if (fseek( fh, 0, SEEK_END )!=-1)
+     if (fseeko( fh, 0, SEEK_END )!=-1)
      {
-       return ftell( fh );
+       return ftello( fh );
      }
   }
   return -1;
@@ -660,8 +658,7 @@ bool QFile::seek( int64 pos )
 {
   if (isOpen())
   {
-    // TODO: support 64 bit size
-    return fseek( fh, (long)pos, SEEK_SET )!=-1;
+    return fseeko( fh, (off_t)pos, SEEK_SET )!=-1;
   }
   return FALSE;
 }
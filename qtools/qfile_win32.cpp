@@ -645,8 +645,11 @@ int64 QFile::pos() const
 {
   if (isOpen())
   {
-    // TODO: support 64 bit size
-    return ftell( fh );
+#if defined(__MINGW32__)
+    return ftello64( fh );
+#else
+    return _ftelli64( fh );
+#endif
   }
   return -1;
 }
@@ -655,11 +658,17 @@ int64 QFile::toEnd()
 {
   if (isOpen())
   {
-     // TODO: support 64 bit size
-     if (fseek( fh, 0, SEEK_END )!=-1)
+#if defined(__MINGW32__)
+     if (fseeko64( fh, 0, SEEK_END )!=-1)
+     {
+       return ftello64( fh );
+     }
+#else
+     if (_fseeki64( fh, 0, SEEK_END )!=-1)
      {
-       return ftell( fh );
+       return _ftelli64( fh );
      }
+#endif
   }
   return -1;
 }
@@ -668,8 +677,11 @@ bool QFile::seek( int64 pos )
 {
   if (isOpen())
   {
-    // TODO: support 64 bit size
-    return fseek( fh, pos, SEEK_SET )!=-1;
+#if defined(__MINGW32__)
+    return fseeko64( fh, pos, SEEK_SET )!=-1;
+#else
+    return _fseeki64( fh, pos, SEEK_SET )!=-1;
+#endif
   }
   return FALSE;
 }
@@ -78,17 +78,42 @@ public:
   Default implementation of special and virtual functions
  *****************************************************************************/
 
-/*!
-  \internal
-  Returns the hash key for \e key, when key is a string.
+/*
+  Hash values are computed with FNV-1a followed by a final mixing step,
+  so that all bits of the key affect the low bits of the hash that
+  select the slot in the table. The full hash value is stored in each
+  bucket, so most mismatches in a chain are rejected without comparing
+  the keys and the table can be grown without hashing the keys again.
+
+  The order in which iterators visit the items is the order of the
+  classic implementation: a table with the size given to the constructor
+  or to resize(), indexed by the classic hash of the key modulo that size,
+  with the most recently inserted item first in each slot. That table
+  only links the buckets in this order. It is not used for lookups and
+  does not grow, so the output of programs that depend on the order of
+  a dictionary does not change.
 */
 
-int QGDict::hashKeyString( const QString &key )
+static inline uint hashMix( uint h )
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline uint hashInt( ulong k )
+{
+    // two shifts, since long may be 32 bit
+    return hashMix( (uint)k ^ (uint)(k >> 16 >> 16) );
+}
+
+// the classic hash functions, which determine the iteration order
+
+static uint orderHashString( const QString &key, bool cases )
 {
-#if defined(CHECK_NULL)
-    if ( key.isNull() ) 
-	qWarning( "QGDict::hashStringKey: Invalid null key" ); 
-#endif
     int i;
     register uint h=0;
     uint g;
@@ -109,26 +134,13 @@ int QGDict::hashKeyString( const QString &key )
 	    h &= ~g;
 	}
     }
-    int index = h;
-    if ( index < 0 )				// adjust index to table size
-	index = -index;
-    return index;
+    return h;
 }
 
-/*!
-  \internal
-  Returns the hash key for \a key, which is a C string.
-*/
-
-int QGDict::hashKeyAscii( const char *key )
+static uint orderHashAscii( const char *key, bool cases )
 {
-#if defined(CHECK_NULL)
     if ( key == 0 )
-    {
-	qWarning( "QGDict::hashAsciiKey: Invalid null key" );
-        return 0;
-    }
-#endif
+	return 0;
     register const char *k = key;
     register uint h=0;
     uint g;
@@ -148,10 +160,72 @@ int QGDict::hashKeyAscii( const char *key )
 	    k++;
 	}
     }
-    int index = h;
-    if ( index < 0 )				// adjust index to table size
-	index = -index;
-    return index;
+    return h;
+}
+
+// largest power of 2 not larger than len, so the table never uses
+// more memory than the size that was asked for
+static uint tableSize( uint len )
+{
+    uint size = 1;
+    while ( size <= len/2 )
+	size <<= 1;
+    return size;
+}
+
+/*!
+  \internal
+  Returns the hash key for \e key, when key is a string.
+*/
+
+uint QGDict::hashKeyString( const QString &key )
+{
+#if defined(CHECK_NULL)
+    if ( key.isNull() ) 
+	qWarning( "QGDict::hashStringKey: Invalid null key" ); 
+#endif
+    int i;
+    register uint h=2166136261U;
+    int len = key.length();
+    const QChar *p = key.unicode();
+    if ( cases ) {				// case sensitive
+	for ( i=0; i<len; i++ ) {
+	    h = (h ^ p[i].unicode()) * 16777619U;
+	}
+    } else {					// case insensitive
+	for ( i=0; i<len; i++ ) {
+	    h = (h ^ p[i].lower().unicode()) * 16777619U;
+	}
+    }
+    return hashMix( h );
+}
+
+/*!
+  \internal
+  Returns the hash key for \a key, which is a C string.
+*/
+
+uint QGDict::hashKeyAscii( const char *key )
+{
+#if defined(CHECK_NULL)
+    if ( key == 0 )
+    {
+	qWarning( "QGDict::hashAsciiKey: Invalid null key" );
+        return 0;
+    }
+#endif
+    register const uchar *k = (const uchar *)key;
+    register uint h=2166136261U;
+    if ( cases ) {				// case sensitive
+	while ( *k ) {
+	    h = (h ^ *k++) * 16777619U;
+	}
+    } else {					// case insensitive
+	while ( *k ) {
+	    h = (h ^ (uchar)tolower(*k++)) * 16777619U;
+	}
+    }
+    return hashMix( h );
 }
 
 #ifndef QT_NO_DATASTREAM
@@ -201,9 +275,12 @@ QGDict::QGDict( uint len, KeyType kt, bool caseSensitive, bool copyKeys )
 
 void QGDict::init( uint len, KeyType kt, bool caseSensitive, bool copyKeys )
 {
-    vec = new QBaseBucket *[vlen = len];		// allocate hash table
+    vec = new QBaseBucket *[vlen = tableSize(len)]; // allocate hash table
     CHECK_PTR( vec );
     memset( (char*)vec, 0, vlen*sizeof(QBaseBucket*) );
+    ord = new QBaseBucket *[olen = len];	// allocate order table
+    CHECK_PTR( ord );
+    memset( (char*)ord, 0, olen*sizeof(QBaseBucket*) );
     numItems  = 0;
     iterators = 0;
     // The caseSensitive and copyKey options don't make sense for
@@ -233,7 +310,7 @@ void QGDict::init( uint len, KeyType kt, bool caseSensitive, bool copyKeys )
 QGDict::QGDict( const QGDict & dict )
     : QCollection( dict )
 {
-    init( dict.vlen, (KeyType)dict.keytype, dict.cases, dict.copyk );
+    init( dict.olen, (KeyType)dict.keytype, dict.cases, dict.copyk );
     QGDictIterator it( dict );
     while ( it.get() ) {			// copy from other dict
 	switch ( keytype ) {
@@ -264,6 +341,7 @@ QGDict::~QGDict()
 {
     clear();					// delete everything
     delete [] vec;
+    delete [] ord;
     if ( !iterators )				// no iterators for this dict
 	return;
     QGDictIterator *i = iterators->first();
@@ -344,7 +422,7 @@ QGDict &QGDict::operator=( const QGDict &dict )
 /*!
   \fn uint QGDict::size() const
   \internal
-  Returns the size of the hash array.
+  Returns the size of the table that determines the iteration order.
 */
 
 
@@ -356,19 +434,20 @@ QGDict &QGDict::operator=( const QGDict &dict )
 QCollection::Item QGDict::look_string( const QString &key, QCollection::Item d, int op )
 {
     QStringBucket *n;
-    int	index = hashKeyString(key) % vlen;
+    uint h = hashKeyString(key);
+    uint index = h & (vlen-1);
     if ( op == op_find ) {			// find
 	if ( cases ) {
 	    for ( n=(QStringBucket*)vec[index]; n;
 		  n=(QStringBucket*)n->getNext() ) {
-		if ( key == n->getKey() )
+		if ( n->getHash() == h && key == n->getKey() )
 		    return n->getData();	// item found
 	    }
 	} else {
 	    QString k = key.lower();
 	    for ( n=(QStringBucket*)vec[index]; n;
 		  n=(QStringBucket*)n->getNext() ) {
-		if ( k == n->getKey().lower() )
+		if ( n->getHash() == h && k == n->getKey().lower() )
 		    return n->getData();	// item found
 	    }
 	}
@@ -379,14 +458,13 @@ QCollection::Item QGDict::look_string( const QString &key, QCollection::Item d,
 	    remove_string( key );
     }
     // op_insert or op_replace
-    n = new QStringBucket(key,newItem(d),vec[index]);
+    n = new QStringBucket(key,newItem(d),vec[index],h);
     CHECK_PTR( n );
 #if defined(CHECK_NULL)
     if ( n->getData() == 0 )
 	qWarning( "QDict: Cannot insert null item" );
 #endif
-    vec[index] = n;
-    numItems++;
+    insert_common( index, n, orderHashString(key,cases) % olen );
     return n->getData();
 }
 
@@ -396,18 +474,19 @@ QCollection::Item QGDict::look_string( const QString &key, QCollection::Item d,
 QCollection::Item QGDict::look_ascii( const char *key, QCollection::Item d, int op )
 {
     QAsciiBucket *n;
-    int	index = hashKeyAscii(key) % vlen;
+    uint h = hashKeyAscii(key);
+    uint index = h & (vlen-1);
     if ( op == op_find ) {			// find
 	if ( cases ) {
 	    for ( n=(QAsciiBucket*)vec[index]; n;
 		  n=(QAsciiBucket*)n->getNext() ) {
-		if ( qstrcmp(n->getKey(),key) == 0 )
+		if ( n->getHash() == h && qstrcmp(n->getKey(),key) == 0 )
 		    return n->getData();	// item found
 	    }
 	} else {
 	    for ( n=(QAsciiBucket*)vec[index]; n;
 		  n=(QAsciiBucket*)n->getNext() ) {
-		if ( qstricmp(n->getKey(),key) == 0 )
+		if ( n->getHash() == h && qstricmp(n->getKey(),key) == 0 )
 		    return n->getData();	// item found
 	    }
 	}
@@ -418,14 +497,13 @@ QCollection::Item QGDict::look_ascii( const char *key, QCollection::Item d, int
 	    remove_ascii( key );
     }
     // op_insert or op_replace
-    n = new QAsciiBucket(copyk ? qstrdup(key) : key,newItem(d),vec[index]);
+    n = new QAsciiBucket(copyk ? qstrdup(key) : key,newItem(d),vec[index],h);
     CHECK_PTR( n );
 #if defined(CHECK_NULL)
     if ( n->getData() == 0 )
 	qWarning( "QAsciiDict: Cannot insert null item" );
 #endif
-    vec[index] = n;
-    numItems++;
+    insert_common( index, n, orderHashAscii(key,cases) % olen );
     return n->getData();
 }
 
@@ -435,7 +513,8 @@ QCollection::Item QGDict::look_ascii( const char *key, QCollection::Item d, int
 QCollection::Item QGDict::look_int( long key, QCollection::Item d, int op )
 {
     QIntBucket *n;
-    int index = (int)((ulong)key % vlen);	// simple hash
+    uint h = hashInt((ulong)key);
+    uint index = h & (vlen-1);
     if ( op == op_find ) {			// find
 	for ( n=(QIntBucket*)vec[index]; n;
 	      n=(QIntBucket*)n->getNext() ) {
@@ -449,14 +528,13 @@ QCollection::Item QGDict::look_int( long key, QCollection::Item d, int op )
 	    remove_int( key );
     }
     // op_insert or op_replace
-    n = new QIntBucket(key,newItem(d),vec[index]);
+    n = new QIntBucket(key,newItem(d),vec[index],h);
     CHECK_PTR( n );
 #if defined(CHECK_NULL)
     if ( n->getData() == 0 )
 	qWarning( "QIntDict: Cannot insert null item" );
 #endif
-    vec[index] = n;
-    numItems++;
+    insert_common( index, n, (uint)((ulong)key % olen) );
     return n->getData();
 }
 
@@ -466,7 +544,8 @@ QCollection::Item QGDict::look_int( long key, QCollection::Item d, int op )
 QCollection::Item QGDict::look_ptr( void *key, QCollection::Item d, int op )
 {
     QPtrBucket *n;
-    int index = (int)((uintptr_t)key % vlen);	// simple hash
+    uint h = hashInt((uintptr_t)key);
+    uint index = h & (vlen-1);
     if ( op == op_find ) {			// find
 	for ( n=(QPtrBucket*)vec[index]; n;
 	      n=(QPtrBucket*)n->getNext() ) {
@@ -480,18 +559,60 @@ QCollection::Item QGDict::look_ptr( void *key, QCollection::Item d, int op )
 	    remove_ptr( key );
     }
     // op_insert or op_replace
-    n = new QPtrBucket(key,newItem(d),vec[index]);
+    n = new QPtrBucket(key,newItem(d),vec[index],h);
     CHECK_PTR( n );
 #if defined(CHECK_NULL)
     if ( n->getData() == 0 )
 	qWarning( "QPtrDict: Cannot insert null item" );
 #endif
-    vec[index] = n;
-    numItems++;
+    insert_common( index, n, (uint)((uintptr_t)key % olen) );
     return n->getData();
 }
 
 
+/*!
+  \internal
+  Links the new bucket \a node in front of the chain at \a index and
+  in front of the items in order slot \a slot, and doubles the size of
+  the hash table when there are more items than entries.
+*/
+
+void QGDict::insert_common( uint index, QBaseBucket *node, uint slot )
+{
+    vec[index] = node;
+    node->setSlot( slot );
+    node->setNextItem( ord[slot] );
+    if ( ord[slot] )
+	ord[slot]->setPrevItem( node );
+    ord[slot] = node;
+    numItems++;
+    if ( numItems > vlen && vlen < 0x80000000U )
+	rehash( vlen*2 );
+}
+
+
+/*!
+  \internal
+  Returns the order slot of bucket \a n for the current size of the
+  order table.
+*/
+
+uint QGDict::orderSlot( QBaseBucket *n ) const
+{
+    switch ( keytype ) {
+	case StringKey:
+	    return orderHashString( ((QStringBucket*)n)->getKey(), cases ) % olen;
+	case AsciiKey:
+	    return orderHashAscii( ((QAsciiBucket*)n)->getKey(), cases ) % olen;
+	case IntKey:
+	    return (uint)((ulong)(long)((QIntBucket*)n)->getKey() % olen);
+	case PtrKey:
+	    return (uint)((uintptr_t)((QPtrBucket*)n)->getKey() % olen);
+    }
+    return 0;
+}
+
+
 /*!
   \internal
   Changes the size of the hashtable.
@@ -500,70 +621,29 @@ QCollection::Item QGDict::look_ptr( void *key, QCollection::Item d, int op )
 */
 void QGDict::resize( uint newsize )
 {
-    // Save old information
-    QBaseBucket **old_vec = vec;
-    uint old_vlen  = vlen;
-    bool old_copyk = copyk;
-
-    vec = new QBaseBucket *[vlen = newsize];
-    CHECK_PTR( vec );
-    memset( (char*)vec, 0, vlen*sizeof(QBaseBucket*) );
-    numItems = 0;
-    copyk = FALSE;
-
-    // Reinsert every item from vec, deleting vec as we go
-    for ( uint index = 0; index < old_vlen; index++ ) {
-	switch ( keytype ) {
-	    case StringKey:
-		{
-		    QStringBucket *n=(QStringBucket *)old_vec[index];
-		    while ( n ) {
-			look_string( n->getKey(), n->getData(), op_insert );
-			QStringBucket *t=(QStringBucket *)n->getNext();
-			delete n;
-			n = t;
-		    }
-		}
-		break;
-	    case AsciiKey:
-		{
-		    QAsciiBucket *n=(QAsciiBucket *)old_vec[index];
-		    while ( n ) {
-			look_ascii( n->getKey(), n->getData(), op_insert );
-			QAsciiBucket *t=(QAsciiBucket *)n->getNext();
-			delete n;
-			n = t;
-		    }
-		}
-		break;
-	    case IntKey:
-		{
-		    QIntBucket *n=(QIntBucket *)old_vec[index];
-		    while ( n ) {
-			look_int( n->getKey(), n->getData(), op_insert );
-			QIntBucket *t=(QIntBucket *)n->getNext();
-			delete n;
-			n = t;
-		    }
-		}
-		break;
-	    case PtrKey:
-		{
-		    QPtrBucket *n=(QPtrBucket *)old_vec[index];
-		    while ( n ) {
-			look_ptr( n->getKey(), n->getData(), op_insert );
-			QPtrBucket *t=(QPtrBucket *)n->getNext();
-			delete n;
-			n = t;
-		    }
-		}
-		break;
+    // Relink every item in the order a classic table of the new size
+    // would have, visiting the items in the current order
+    QBaseBucket **old_ord = ord;
+    uint old_olen = olen;
+    ord = new QBaseBucket *[olen = newsize];
+    CHECK_PTR( ord );
+    memset( (char*)ord, 0, olen*sizeof(QBaseBucket*) );
+    for ( uint index = 0; index < old_olen; index++ ) {
+	QBaseBucket *n = old_ord[index];
+	while ( n ) {
+	    QBaseBucket *next = n->getNextItem();
+	    uint slot = orderSlot( n );
+	    n->setSlot( slot );
+	    n->setPrevItem( 0 );
+	    n->setNextItem( ord[slot] );
+	    if ( ord[slot] )
+		ord[slot]->setPrevItem( n );
+	    ord[slot] = n;
+	    n = next;
 	}
     }
-    delete [] old_vec;
-
-    // Restore state
-    copyk = old_copyk;
+    delete [] old_ord;
+    rehash( newsize );
 
     // Invalidate all iterators, since order is lost
     if ( iterators && iterators->count() ) {
@@ -575,6 +655,43 @@ void QGDict::resize( uint newsize )
     }
 }
 
+
+/*!
+  \internal
+  Rebuilds the hash table used for lookups with \a newsize entries,
+  rounded down to a power of 2. The order of the items does not change,
+  so iterators on the dictionary stay valid.
+*/
+void QGDict::rehash( uint newsize )
+{
+    delete [] vec;
+    vec = new QBaseBucket *[vlen = tableSize( newsize )];
+    CHECK_PTR( vec );
+    memset( (char*)vec, 0, vlen*sizeof(QBaseBucket*) );
+
+    // Move the buckets to the new table using the stored hash values.
+    // Buckets are appended to the chains in iteration order, so of
+    // several items with the same key, find() returns the one that an
+    // iterator visits first, like the classic implementation did.
+    QBaseBucket **tails = new QBaseBucket *[vlen];
+    CHECK_PTR( tails );
+    for ( uint index = 0; index < olen; index++ ) {
+	QBaseBucket *n = ord[index];
+	while ( n ) {
+	    QBaseBucket *next = n->getNextItem();
+	    uint i = n->getHash() & (vlen-1);
+	    n->setNext( 0 );
+	    if ( vec[i] )
+		tails[i]->setNext( n );
+	    else
+		vec[i] = n;
+	    tails[i] = n;
+	    n = next;
+	}
+    }
+    delete [] tails;
+}
+
 /*!
   \internal
   Unlinks the bucket with the specified key (and specified data pointer,
@@ -595,6 +712,12 @@ void QGDict::unlink_common( int index, QBaseBucket *node, QBaseBucket *prev )
 	prev->setNext( node->getNext() );
     else
 	vec[index] = node->getNext();
+    if ( node->getPrevItem() )			// unlink from order slot
+	node->getPrevItem()->setNextItem( node->getNextItem() );
+    else
+	ord[node->getSlot()] = node->getNextItem();
+    if ( node->getNextItem() )
+	node->getNextItem()->setPrevItem( node->getPrevItem() );
     numItems--;
 }
 
@@ -604,11 +727,12 @@ QStringBucket *QGDict::unlink_string( const QString &key, QCollection::Item d )
 	return 0;
     QStringBucket *n;
     QStringBucket *prev = 0;
-    int index = hashKeyString(key) % vlen;
+    uint h = hashKeyString(key);
+    uint index = h & (vlen-1);
     if ( cases ) {
 	for ( n=(QStringBucket*)vec[index]; n;
 	      n=(QStringBucket*)n->getNext() ) {
-	    bool found = (key == n->getKey());
+	    bool found = (n->getHash() == h && key == n->getKey());
 	    if ( found && d )
 		found = (n->getData() == d);
 	    if ( found ) {
@@ -621,7 +745,7 @@ QStringBucket *QGDict::unlink_string( const QString &key, QCollection::Item d )
 	QString k = key.lower();
 	for ( n=(QStringBucket*)vec[index]; n;
 	      n=(QStringBucket*)n->getNext() ) {
-	    bool found = (k == n->getKey().lower());
+	    bool found = (n->getHash() == h && k == n->getKey().lower());
 	    if ( found && d )
 		found = (n->getData() == d);
 	    if ( found ) {
@@ -640,10 +764,12 @@ QAsciiBucket *QGDict::unlink_ascii( const char *key, QCollection::Item d )
 	return 0;
     QAsciiBucket *n;
     QAsciiBucket *prev = 0;
-    int index = hashKeyAscii(key) % vlen;	
+    uint h = hashKeyAscii(key);
+    uint index = h & (vlen-1);
     for ( n=(QAsciiBucket *)vec[index]; n; n=(QAsciiBucket *)n->getNext() ) {
-	bool found = (cases ? qstrcmp(n->getKey(),key)
-		       : qstricmp(n->getKey(),key)) == 0;
+	bool found = n->getHash() == h &&
+		     (cases ? qstrcmp(n->getKey(),key)
+		            : qstricmp(n->getKey(),key)) == 0;
 	if ( found && d )
 	    found = (n->getData() == d);
 	if ( found ) {
@@ -661,7 +787,7 @@ QIntBucket *QGDict::unlink_int( long key, QCollection::Item d )
 	return 0;
     QIntBucket *n;
     QIntBucket *prev = 0;
-    int index = (int)((ulong)key % vlen);
+    uint index = hashInt((ulong)key) & (vlen-1);
     for ( n=(QIntBucket *)vec[index]; n; n=(QIntBucket *)n->getNext() ) {
 	bool found = (n->getKey() == key);
 	if ( found && d )
@@ -681,7 +807,7 @@ QPtrBucket *QGDict::unlink_ptr( void *key, QCollection::Item d )
 	return 0;
     QPtrBucket *n;
     QPtrBucket *prev = 0;
-    int index = (int)((uintptr_t)key % vlen);
+    uint index = hashInt((uintptr_t)key) & (vlen-1);
     for ( n=(QPtrBucket *)vec[index]; n; n=(QPtrBucket *)n->getNext() ) {
 	bool found = (n->getKey() == key);
 	if ( found && d )
@@ -886,6 +1012,7 @@ void QGDict::clear()
 	    vec[j] = 0;				// detach list of buckets
 	}
     }
+    memset( (char*)ord, 0, olen*sizeof(QBaseBucket*) );
     if ( iterators && iterators->count() ) {	// invalidate all iterators
 	QGDictIterator *i = iterators->first();
 	while ( i ) {
@@ -915,9 +1042,9 @@ void QGDict::statistics() const
 	return;
     }
     real = 0.0;
-    ideal = (float)count()/(2.0*size())*(count()+2.0*size()-1);
+    ideal = (float)count()/(2.0*vlen)*(count()+2.0*vlen-1);
     uint i = 0;
-    while ( i<size() ) {
+    while ( i<vlen ) {
 	QBaseBucket *n = vec[i];
 	int b = 0;
 	while ( n ) {				// count number of buckets
@@ -935,7 +1062,7 @@ void QGDict::statistics() const
 	qDebug( "%s", buf );
 	i++;
     }
-    qDebug( "Array size = %d", size() );
+    qDebug( "Array size = %d", vlen );
     qDebug( "# items    = %d", count() );
     qDebug( "Real dist  = %g", real );
     qDebug( "Rand dist  = %g", ideal );
@@ -1029,8 +1156,8 @@ QDataStream& QGDict::write( QDataStream &s ) const
 {
     s << count();				// write number of items
     uint i = 0;
-    while ( i<size() ) {
-	QBaseBucket *n = vec[i];
+    while ( i<olen ) {
+	QBaseBucket *n = ord[i];
 	while ( n ) {				// write all buckets
 	    switch ( keytype ) {
 		case StringKey:
@@ -1047,7 +1174,7 @@ QDataStream& QGDict::write( QDataStream &s ) const
 		    break;
 	    }
 	    write( s, n->getData() );		// write data
-	    n = n->getNext();
+	    n = n->getNextItem();
 	}
 	i++;
     }
@@ -1145,10 +1272,10 @@ QCollection::Item QGDictIterator::toFirst()
 	return 0;
     }
     register uint i = 0;
-    register QBaseBucket **v = dict->vec;
+    register QBaseBucket **v = dict->ord;
     while ( !(*v++) )
 	i++;
-    curNode = dict->vec[i];
+    curNode = dict->ord[i];
     curIndex = i;
     return curNode->getData();
 }
@@ -1189,17 +1316,17 @@ QCollection::Item QGDictIterator::operator++()
     }
     if ( !curNode )
 	return 0;
-    curNode = curNode->getNext();
+    curNode = curNode->getNextItem();
     if ( !curNode ) {				// no next bucket
-	register uint i = curIndex + 1;		// look from next vec element
-	register QBaseBucket **v = &dict->vec[i];
-	while ( i < dict->size() && !(*v++) )
+	register uint i = curIndex + 1;		// look from next slot
+	register QBaseBucket **v = &dict->ord[i];
+	while ( i < dict->olen && !(*v++) )
 	    i++;
-	if ( i == dict->size() ) {		// nothing found
+	if ( i == dict->olen ) {		// nothing found
 	    curNode = 0;
 	    return 0;
 	}
-	curNode = dict->vec[i];
+	curNode = dict->ord[i];
 	curIndex = i;
     }
     return curNode->getData();
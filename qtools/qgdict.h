@@ -54,17 +54,30 @@ public:
     QCollection::Item	 setData( QCollection::Item d ) { return data = d; }
     QBaseBucket		*getNext()			{ return next; }
     void		 setNext( QBaseBucket *n)	{ next = n; }
+    uint		 getHash() const		{ return hash; }
+    uint		 getSlot() const		{ return slot; }
+    void		 setSlot( uint s )		{ slot = s; }
+    QBaseBucket		*getPrevItem()			{ return prevItem; }
+    QBaseBucket		*getNextItem()			{ return nextItem; }
+    void		 setPrevItem( QBaseBucket *n )	{ prevItem = n; }
+    void		 setNextItem( QBaseBucket *n )	{ nextItem = n; }
 protected:
-    QBaseBucket( QCollection::Item d, QBaseBucket *n ) : data(d), next(n) {}
+    QBaseBucket( QCollection::Item d, QBaseBucket *n, uint h )
+	: data(d), next(n), hash(h), slot(0), prevItem(0), nextItem(0) {}
     QCollection::Item	 data;
     QBaseBucket		*next;
+    uint		 hash;			// full hash value of the key
+    uint		 slot;			// slot in the iteration order
+    QBaseBucket		*prevItem;		// next/previous item in the slot
+    QBaseBucket		*nextItem;
 };
 
 class QStringBucket : public QBaseBucket
 {
 public:
-    QStringBucket( const QString &k, QCollection::Item d, QBaseBucket *n )
-	: QBaseBucket(d,n), key(k)		{}
+    QStringBucket( const QString &k, QCollection::Item d, QBaseBucket *n,
+		   uint h )
+	: QBaseBucket(d,n,h), key(k)		{}
     const QString  &getKey() const		{ return key; }
 private:
     QString	    key;
@@ -73,8 +86,8 @@ private:
 class QAsciiBucket : public QBaseBucket
 {
 public:
-    QAsciiBucket( const char *k, QCollection::Item d, QBaseBucket *n )
-	: QBaseBucket(d,n), key(k) {}
+    QAsciiBucket( const char *k, QCollection::Item d, QBaseBucket *n, uint h )
+	: QBaseBucket(d,n,h), key(k) {}
     const char *getKey() const { return key; }
 private:
     const char *key;
@@ -83,8 +96,8 @@ private:
 class QIntBucket : public QBaseBucket
 {
 public:
-    QIntBucket( intptr_t k, QCollection::Item d, QBaseBucket *n )
-	: QBaseBucket(d,n), key(k) {}
+    QIntBucket( intptr_t k, QCollection::Item d, QBaseBucket *n, uint h )
+	: QBaseBucket(d,n,h), key(k) {}
     intptr_t  getKey() const { return key; }
 private:
     intptr_t  key;
@@ -93,8 +106,8 @@ private:
 class QPtrBucket : public QBaseBucket
 {
 public:
-    QPtrBucket( void *k, QCollection::Item d, QBaseBucket *n )
-	: QBaseBucket(d,n), key(k) {}
+    QPtrBucket( void *k, QCollection::Item d, QBaseBucket *n, uint h )
+	: QBaseBucket(d,n,h), key(k) {}
     void *getKey() const { return key; }
 private:
     void *key;
@@ -105,7 +118,7 @@ class Q_EXPORT QGDict : public QCollection	// generic dictionary class
 {
 public:
     uint	count() const	{ return numItems; }
-    uint	size()	const	{ return vlen; }
+    uint	size()	const	{ return olen; }
     QCollection::Item look_string( const QString& key, QCollection::Item,
 				   int );
     QCollection::Item look_ascii( const char *key, QCollection::Item, int );
@@ -136,8 +149,8 @@ protected:
     void	clear();
     void	resize( uint );
 
-    int		hashKeyString( const QString & );
-    int		hashKeyAscii( const char * );
+    uint	hashKeyString( const QString & );
+    uint	hashKeyAscii( const char * );
 
     void	statistics() const;
 
@@ -146,13 +159,18 @@ protected:
     virtual QDataStream &write( QDataStream &, QCollection::Item ) const;
 #endif
 private:
-    QBaseBucket **vec;
+    QBaseBucket **vec;				// hash table for lookups
     uint	vlen;
+    QBaseBucket **ord;				// slots in iteration order
+    uint	olen;
     uint	numItems;
     uint	keytype	: 2;
     uint	cases	: 1;
     uint	copyk	: 1;
     QGDItList  *iterators;
+    void	   insert_common( uint, QBaseBucket *, uint );
+    uint	   orderSlot( QBaseBucket * ) const;
+    void	   rehash( uint );
     void	   unlink_common( int, QBaseBucket *, QBaseBucket * );
     QStringBucket *unlink_string( const QString &,
 				  QCollection::Item item = 0 );
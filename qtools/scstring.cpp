@@ -13,18 +13,13 @@
  *
  */
 
-// with this switch you can choose between the original qcstring implementation,
-// which implicitly shares data so copying is faster, but requires at least 12 bytes, and
-// the new implementation in this file, which has a smaller footprint (only 4 bytes for
-// an empty string), but always copies strings.
-#define SMALLSTRING
-
-#include "qcstring.h"
-#ifndef SMALLSTRING
-#include "qcstring.cpp"
-#else
 #define SCString QCString
 
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <windows.h>
+#endif
+
+#include "qcstring.h"
 #include <qstring.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -32,13 +27,125 @@
 #include <ctype.h>
 #include <qregexp.h>
 #include <qdatastream.h>
+#include <qasciidict.h>
+#include <qmutex.h>
+
+//---------------------------------------------------------------------------
+// The characters of a string are stored in a block that starts with a
+// reference count of QCSTRING_HEADER_SIZE bytes. m_data points to the first
+// character after the reference count.
+
+static inline int *refCount(char *d)
+{
+  return (int *)(d-QCSTRING_HEADER_SIZE);
+}
+
+static inline void refData(char *d)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  InterlockedIncrement((volatile LONG *)refCount(d));
+#else
+  __sync_add_and_fetch(refCount(d),1);
+#endif
+}
+
+static inline bool derefData(char *d) // returns TRUE if d is no longer used
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return InterlockedDecrement((volatile LONG *)refCount(d))==0;
+#else
+  return __sync_sub_and_fetch(refCount(d),1)==0;
+#endif
+}
+
+static inline bool replaceData(char **pd,char *oldData,char *newData)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return InterlockedCompareExchangePointer((PVOID volatile *)pd,newData,oldData)==oldData;
+#else
+  return __sync_bool_compare_and_swap(pd,oldData,newData);
+#endif
+}
+
+// returns a new unshared block for size characters
+static char *allocData(uint size)
+{
+  char *b = (char *)malloc(size+QCSTRING_HEADER_SIZE);
+  if (b==0) return 0;
+  *(int *)b = 1;
+  return b+QCSTRING_HEADER_SIZE;
+}
+
+// changes the size of unshared block d, which may be 0
+static char *reallocData(char *d,uint size)
+{
+  if (d==0) return allocData(size);
+  char *b = (char *)realloc(d-QCSTRING_HEADER_SIZE,size+QCSTRING_HEADER_SIZE);
+  return b ? b+QCSTRING_HEADER_SIZE : 0;
+}
+
+static inline void releaseData(char *d)
+{
+  if (d && derefData(d)) free(d-QCSTRING_HEADER_SIZE);
+}
+
+// returns an unshared copy of str, or 0 for the empty string
+static char *duplicateData(const char *str)
+{
+  if (str==0 || str[0]=='\0') return 0;
+  uint l = qstrlen(str);
+  char *d = allocData(l+1);
+  if (d) memcpy(d,str,l+1);
+  return d;
+}
+
+char *SCString::detach() const
+{
+  char *oldData = m_data;
+  char *newData = allocData(qstrlen(oldData)+1);
+  if (newData==0) return oldData;
+  strcpy(newData,oldData);
+  // data() is const, so two threads may detach the same string at once
+  if (replaceData((char **)&m_data,oldData,newData))
+  {
+    releaseData(oldData);
+  }
+  else
+  {
+    releaseData(newData);
+  }
+  return m_data;
+}
+
+// makes sure the string is unshared and has room for size characters,
+// returns 0 if there is not enough memory
+char *SCString::reserve( uint size )
+{
+  char *d;
+  if (isShared())
+  {
+    d = allocData(size);
+    if (d==0) return 0;
+    uint l = QMIN(qstrlen(m_data)+1,size);
+    memcpy(d,m_data,l);
+    releaseData(m_data);
+  }
+  else
+  {
+    d = reallocData(m_data,size);
+    if (d==0) return 0;
+  }
+  m_data = d;
+  return d;
+}
 
+//---------------------------------------------------------------------------
 
 SCString::SCString(int size)
 {
   if (size>0)
   {
-    m_data = (char *)malloc(size);
+    m_data = allocData(size);
     if (m_data)
     {
       if (size>1) memset(m_data,' ',size-1);
@@ -53,12 +160,13 @@ SCString::SCString(int size)
 
 SCString::SCString( const SCString &s ) 
 { 
-  duplicate(s);
+  m_data = s.m_data;
+  if (m_data && m_data[0]!='\0') refData(m_data); else m_data=0;
 }
 
 SCString::SCString( const char *str )
 { 
-  duplicate(str);
+  m_data = duplicateData(str);
 }
 
 SCString::SCString( const char *str, uint maxlen )
@@ -66,9 +174,12 @@ SCString::SCString( const char *str, uint maxlen )
   uint l;
   if (str && ( l = QMIN(qstrlen(str),maxlen) )) 
   { 
-    m_data=(char *)malloc(l+1);
-    strncpy(m_data,str,l+1);
-    m_data[l]='\0';
+    m_data=allocData(l+1);
+    if (m_data)
+    {
+      memcpy(m_data,str,l);
+      m_data[l]='\0';
+    }
   } 
   else
   {
@@ -78,34 +189,88 @@ SCString::SCString( const char *str, uint maxlen )
 
 SCString::~SCString()
 {
-  if (m_data) free(m_data);
+  releaseData(m_data);
   m_data=0;
 }
 
+SCString &SCString::operator=( const SCString &s )
+{
+  char *d = s.m_data;
+  if (m_data==d) return *this;
+  if (d && d[0]!='\0') refData(d); else d=0;
+  releaseData(m_data);
+  m_data=d;
+  return *this;
+}
+
 SCString &SCString::assign( const char *str )
 {
   if (m_data==str) return *this;
-  if (m_data) free(m_data);
-  duplicate(str);
+  char *d = duplicateData(str); // str may point into m_data
+  releaseData(m_data);
+  m_data=d;
   return *this;
 }
 
-bool SCString::resize( uint newlen )
+// The pool of interned strings. It holds a reference to each of its strings,
+// so they are not modified while they are in the pool.
+static QMutex            g_internMutex;
+static QAsciiDict<char> *g_internPool = 0;
+
+// the pool is cleared when it reaches this number of strings
+static const uint maxInternPoolCount = 1<<20;
+
+static void clearInternPoolLocked()
 {
-  if (newlen==0)
+  if (g_internPool==0) return;
+  QAsciiDictIterator<char> it(*g_internPool);
+  char *d;
+  for (;(d=it.current());++it)
   {
-    if (m_data) { free(m_data); m_data=0; }
-    return TRUE;
+    releaseData(d);
   }
-  if (m_data==0) // newlen>0
+  delete g_internPool;
+  g_internPool = 0;
+}
+
+QCString SCString::intern() const
+{
+  if (isEmpty()) return QCString();
+  QMutexLocker locker(&g_internMutex);
+  if (g_internPool && g_internPool->count()>=maxInternPoolCount)
   {
-    m_data = (char *)malloc(newlen);
+    // strings interned from now on no longer share with older ones
+    clearInternPoolLocked();
   }
-  else
+  if (g_internPool==0) g_internPool = new QAsciiDict<char>(10007,TRUE,FALSE);
+  char *d = g_internPool->find(m_data);
+  if (d==0)
   {
-    m_data = (char *)realloc(m_data,newlen);
+    d = duplicateData(m_data);
+    if (d==0) return *this;
+    g_internPool->insert(d,d);
   }
-  if (m_data==0) return FALSE;
+  QCString result;
+  refData(d);
+  result.m_data = d;
+  return result;
+}
+
+void SCString::clearInternPool()
+{
+  QMutexLocker locker(&g_internMutex);
+  clearInternPoolLocked();
+}
+
+bool SCString::resize( uint newlen )
+{
+  if (newlen==0)
+  {
+    releaseData(m_data);
+    m_data=0;
+    return TRUE;
+  }
+  if (reserve(newlen)==0) return FALSE;
   m_data[newlen-1]='\0';
   return TRUE;
 }
@@ -116,10 +281,10 @@ bool SCString::fill( char c, int len )
   if (len<0) len=l;
   if ((uint)len!=l) 
   {
-    if (m_data) free(m_data);
+    releaseData(m_data);
     if (len>0)
     {
-      m_data=(char *)malloc(len+1);
+      m_data=allocData(len+1);
       if (m_data==0) return FALSE;
       m_data[len]='\0';
     }
@@ -128,6 +293,10 @@ bool SCString::fill( char c, int len )
       m_data=0;
     }
   }
+  else if (isShared())
+  {
+    detach();
+  }
   if (len>0)
   {
     uint i;
@@ -144,12 +313,13 @@ SCString &SCString::sprintf( const char *format, ... )
   const uint minlen=4095;
   if (l<minlen)
   {
-    if (m_data) 
-      m_data = (char *)realloc(m_data,minlen+1);
-    else
-      m_data = (char *)malloc(minlen+1);
+    reserve(minlen+1);
     m_data[minlen]='\0';
   }
+  else if (isShared())
+  {
+    detach();
+  }
   vsnprintf( m_data, minlen, format, ap );
   resize( qstrlen(m_data) + 1 );              // truncate
   va_end( ap );
@@ -211,7 +381,7 @@ int SCString::find( const char *str, int index, bool cs ) const
 
 int SCString::find( const QCString &str, int index, bool cs ) const
 {
-  return find(str.data(),index,cs);
+  return find(str.m_data,index,cs);
 }
 
 int SCString::find( const QRegExp &rx, int index ) const
@@ -318,7 +488,7 @@ int SCString::contains( char c, bool cs ) const
 int SCString::contains( const char *str, bool cs ) const
 {
   int count = 0;
-  char *d = data();
+  char *d = m_data;
   if ( !d )
     return 0;
   int len = qstrlen( str );
@@ -389,7 +559,7 @@ SCString SCString::mid( uint index, uint len) const
   } 
   else 
   {
-    register char *p = data()+index;
+    register char *p = m_data+index;
     SCString s( len+1 );
     strncpy( s.data(), p, len );
     *(s.data()+len) = '\0';
@@ -459,7 +629,7 @@ SCString SCString::simplifyWhiteSpace() const
     return *this;
 
   SCString result( length()+1 );
-  char *from  = data();
+  char *from  = m_data;
   char *to    = result.data();
   char *first = to;
   while ( TRUE ) 
@@ -489,14 +659,13 @@ SCString &SCString::insert( uint index, const char *s )
   int nlen = olen + len;                      
   if ( index >= olen )  // insert after end of string
   {                     
-    m_data = (char *)realloc(m_data,nlen+index-olen+1);
-    if ( m_data ) 
+    if ( reserve(nlen+index-olen+1) )
     {
       memset( m_data+olen, ' ', index-olen );
       memcpy( m_data+index, s, len+1 );
     }
   } 
-  else if ( (m_data = (char *)realloc(m_data,nlen+1)) )  // normal insert
+  else if ( reserve(nlen+1) )  // normal insert
   { 
     memmove( m_data+index+len, m_data+index, olen-index+1 );
     memcpy( m_data+index, s, len );
@@ -517,10 +686,8 @@ SCString& SCString::operator+=( const char *str )
   if ( !str ) return *this;  // nothing to append
   uint len1 = length();
   uint len2 = qstrlen(str);
-  char *newData = (char *)realloc( m_data, len1 + len2 + 1 );
-  if (newData)
+  if (reserve( len1 + len2 + 1 ))
   {
-    m_data = newData;
     memcpy( m_data + len1, str, len2 + 1 );
   }
   return *this;      
@@ -529,10 +696,8 @@ SCString& SCString::operator+=( const char *str )
 SCString &SCString::operator+=( char c )
 {
   uint len = length();
-  char *newData = (char *)realloc( m_data, length()+2 );
-  if (newData)
+  if (reserve( len+2 ))
   {
-    m_data = newData;
     m_data[len] = c;
     m_data[len+1] = '\0';
   }
@@ -551,6 +716,7 @@ SCString &SCString::remove( uint index, uint len )
   } 
   else if ( len != 0 ) 
   {
+    if (isShared()) detach();
     memmove( m_data+index, m_data+index+len, olen-index-len+1 );
     resize( olen-len+1 );
   }
@@ -664,6 +830,7 @@ bool SCString::stripPrefix(const char *prefix)
   {
     uint len    = qstrlen(m_data);
     uint newlen = len-plen+1;
+    if (isShared()) detach();
     qmemmove(m_data,m_data+plen,newlen);
     resize(newlen);
     return TRUE;
@@ -769,7 +936,7 @@ QDataStream &operator>>( QDataStream &s, QByteArray &a )
 
 QDataStream &operator<<( QDataStream &s, const SCString &str )
 {
-    return s.writeBytes( str.data(), str.size() );
+    return s.writeBytes( (const char *)str, str.size() );
 }
 
 QDataStream &operator>>( QDataStream &s, SCString &str )
@@ -792,7 +959,3 @@ QDataStream &operator>>( QDataStream &s, SCString &str )
 }
 
 #endif //QT_NO_DATASTREAM
-
-
-
-#endif
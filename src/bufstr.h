@@ -98,6 +98,16 @@ class BufStr
     { 
       return m_writeOffset; 
     }
+    /*! Frees the memory of the buffer, after which it is empty.
+     *  Can be used to drop the contents as soon as they are consumed.
+     */
+    void release()
+    {
+      free(m_buf);
+      m_buf=0;
+      m_size=0;
+      m_writeOffset=0;
+    }
     void dropFromStart(uint bytes)
     {
       if (bytes>m_size) bytes=m_size;
@@ -110,7 +120,9 @@ class BufStr
     {
       if (m_writeOffset+size>=m_size) 
       {
-        resize(m_size+size+m_spareRoom);
+        // grow by at least half the current size, so appending to a large
+        // buffer does not copy it again for every m_spareRoom bytes
+        resize(QMAX(m_size+size+m_spareRoom,m_size+m_size/2));
       }
     }
     uint m_size;
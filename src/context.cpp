@@ -65,6 +65,102 @@ template<class T> class ScopedPtr
     void reset(T *p=0) { if (p!=m_ptr) { delete m_ptr; m_ptr = p; } }
 };
 
+/** @brief Base class for the lazily allocated cache of a context object
+ *
+ *  A cache that is allocated while a {% create %} block renders a file is
+ *  linked into a global list, and is released again when that block has
+ *  written the file. The variables of the created file are popped by then,
+ *  so nothing refers to the cached values anymore. Caches that are
+ *  allocated outside a create block live as long as their owner.
+ */
+class ContextCacheBase
+{
+  public:
+    ContextCacheBase() : m_level(-1), m_prev(0), m_next(0) {}
+    virtual ~ContextCacheBase() { unlink(); }
+
+    /** Marks the start of a file that is written by a create block */
+    static void beginCreate() { s_depth++; }
+
+    /** Releases all caches that were allocated since the matching
+     *  beginCreate() call.
+     */
+    static void endCreate()
+    {
+      while (s_last && s_last->m_level>=s_depth)
+      {
+        ContextCacheBase *c = s_last;
+        c->unlink();
+        c->release(); // may delete other caches, which unlink themselves
+      }
+      s_depth--;
+    }
+
+  protected:
+    virtual void release() = 0;
+    void link()
+    {
+      m_level = s_depth;
+      m_prev  = s_last;
+      if (s_last) s_last->m_next = this; else s_first = this;
+      s_last  = this;
+    }
+
+  private:
+    void unlink()
+    {
+      if (m_level==-1) return;
+      if (m_prev) m_prev->m_next = m_next; else s_first = m_next;
+      if (m_next) m_next->m_prev = m_prev; else s_last  = m_prev;
+      m_prev = m_next = 0;
+      m_level = -1;
+    }
+    int m_level;
+    ContextCacheBase *m_prev;
+    ContextCacheBase *m_next;
+    static ContextCacheBase *s_first;
+    static ContextCacheBase *s_last;
+    static int s_depth;
+};
+
+ContextCacheBase *ContextCacheBase::s_first = 0;
+ContextCacheBase *ContextCacheBase::s_last  = 0;
+int ContextCacheBase::s_depth = 0;
+
+/** @brief Cache of type \a T that is allocated on first access */
+template<class T> class ContextCache : public ContextCacheBase
+{
+  private:
+    T *m_data;
+    ContextCache(const ContextCache &);
+    ContextCache &operator=(const ContextCache &);
+
+  public:
+    ContextCache() : m_data(0) {}
+   ~ContextCache() { delete m_data; }
+    T *operator->()
+    {
+      if (m_data==0)
+      {
+        m_data = new T;
+        link();
+      }
+      return m_data;
+    }
+
+  protected:
+    void release() { delete m_data; m_data=0; }
+};
+
+/** @brief Releases the context caches filled for each file that
+ *  is written by a create block */
+class ContextCacheReleaser : public TemplateCreateIntf
+{
+  public:
+    void beginCreate(const QCString &) { ContextCacheBase::beginCreate(); }
+    void endCreate(const QCString &)   { ContextCacheBase::endCreate(); }
+};
+
 /** @brief Template List iterator support */
 template<class T>
 class GenericConstIterator : public TemplateListIntf::ConstIterator
@@ -151,47 +247,30 @@ class GenericNodeListContext : public TemplateListIntf
 
 //------------------------------------------------------------------------
 
-/** @brief Helper class to map a property name to a handler member function */
+/** @brief Helper class to map a property name to a handler member function
+ *
+ *  The map is shared by all objects of type \a T. It is filled by the
+ *  constructor of the first object, so creating further objects is cheap.
+ */
+template<typename T>
 class PropertyMapper
 {
-  private:
-    struct PropertyFuncIntf
-    {
-      virtual ~PropertyFuncIntf() {}
-      virtual TemplateVariant operator()() const = 0;
-    };
-    template<typename T>
-    struct PropertyFunc : public PropertyFuncIntf
-    {
-      typedef TemplateVariant (T::*Handler)() const;
-      PropertyFunc(const T *o,Handler h) : obj(o), handler(h) {}
-      TemplateVariant operator()() const
-      {
-        return (obj->*handler)();
-      }
-      const T *obj;
-      Handler handler;
-    };
-
   public:
-    PropertyMapper() { m_map.setAutoDelete(TRUE); }
+    typedef TemplateVariant (T::*Handler)() const;
 
     /** Add a property to the map
      *  @param[in] name   The name of the property to add.
-     *  @param[in] obj    The object handling access to the property.
      *  @param[in] handle The method to call when the property is accessed.
      */
-    template<typename T>
-    void addProperty(const char *name,const T* obj,
-                     typename PropertyFunc<T>::Handler handle)
+    void addProperty(const char *name,Handler handle)
     {
-      if (m_map.find(name))
+      if (map().find(name))
       {
         err("Error: adding property '%s' more than once",name);
       }
       else
       {
-        m_map.insert(name,new PropertyFunc<T>(obj,handle));
+        map().insert(name,new Handler(handle));
       }
     }
 
@@ -204,16 +283,24 @@ class PropertyMapper
     {
       //printf("PropertyMapper::get(%s)\n",name);
       TemplateVariant result;
-      PropertyFuncIntf *func = m_map.find(name);
-      if (func)
+      Handler *handle = map().find(name);
+      if (handle)
       {
-        result = (*func)();
+        result = (static_cast<const T*>(this)->*(*handle))();
       }
       return result;
     }
 
   private:
-    QDict<PropertyFuncIntf> m_map;
+    struct HandlerMap : public QDict<Handler>
+    {
+      HandlerMap() { this->setAutoDelete(TRUE); }
+    };
+    static QDict<Handler> &map()
+    {
+      static HandlerMap m;
+      return m;
+    }
 };
 
 
@@ -289,7 +376,7 @@ TemplateVariant ConfigContext::get(const char *name) const
 
 //%% struct Doxygen: global information
 //%% {
-class DoxygenContext::Private : public PropertyMapper
+class DoxygenContext::Private : public PropertyMapper<DoxygenContext::Private>
 {
   public:
     TemplateVariant version() const
@@ -302,10 +389,15 @@ class DoxygenContext::Private : public PropertyMapper
     }
     Private()
     {
-      //%% string version
-      addProperty("version",this,&Private::version); //makeProperty(this,&Private::version));
-      //%% string date
-      addProperty("date",   this,&Private::date);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% string version
+        addProperty("version",&Private::version); //makeProperty(this,&Private::version));
+        //%% string date
+        addProperty("date",   &Private::date);
+        init=TRUE;
+      }
     }
 };
 //%% }
@@ -329,7 +421,7 @@ TemplateVariant DoxygenContext::get(const char *n) const
 
 //%% struct Translator: translation methods
 //%% {
-class TranslateContext::Private : public PropertyMapper
+class TranslateContext::Private : public PropertyMapper<TranslateContext::Private>
 {
   public:
 
@@ -671,96 +763,101 @@ class TranslateContext::Private : public PropertyMapper
     }
     Private()
     {
-      //%% string generatedBy
-      addProperty("generatedby",       this,&Private::generatedBy);
-      //%% string generatedAt
-      addProperty("generatedAt",       this,&Private::generatedAt);
-      //%% string search
-      addProperty("search",            this,&Private::search);
-      //%% string mainPage
-      addProperty("mainPage",          this,&Private::mainPage);
-      //%% string classes
-      addProperty("classes",           this,&Private::classes);
-      //%% string classList
-      addProperty("classList",         this,&Private::classList);
-      //%% string classIndex
-      addProperty("classIndex",        this,&Private::classIndex);
-      //%% string classHierarchy
-      addProperty("classHierarchy",    this,&Private::classHierarchy);
-      //%% string classMembers
-      addProperty("classMembers",      this,&Private::classMembers);
-      //%% string modules
-      addProperty("modules",           this,&Private::modules);
-      //%% string namespaces
-      addProperty("namespaces",        this,&Private::namespaces);
-      //%% string files
-      addProperty("files",             this,&Private::files);
-      //%% string pages
-      addProperty("pages",             this,&Private::pages);
-      //%% string examples
-      addProperty("examples",          this,&Private::examples);
-      //%% string namespaceList
-      addProperty("namespaceList",     this,&Private::namespaceList);
-      //%% string namespaceMembers
-      addProperty("namespaceMembers",  this,&Private::namespaceMembers);
-      //%% srting fileList
-      addProperty("fileList",          this,&Private::fileList);
-      //%% string fileMembers
-      addProperty("fileMembers",       this,&Private::fileMembers);
-      //%% string relatedPagesDescripiton
-      addProperty("relatedPagesDesc",  this,&Private::relatedPagesDesc);
-      //%% string more
-      addProperty("more",              this,&Private::more);
-      //%% string detailedDescription
-      addProperty("detailedDesc",      this,&Private::detailedDesc);
-      //%% string inheritanceDiagramFor
-      addProperty("inheritanceDiagramFor", this,&Private::inheritanceDiagramFor);
-      //%% string collaborationDiagramFor
-      addProperty("collaborationDiagramFor", this,&Private::collaborationDiagramFor);
-      //%% markerstring inheritsList
-      addProperty("inheritsList",      this,&Private::inheritsList);
-      //%% markerstring inheritedByList
-      addProperty("inheritedByList",   this,&Private::inheritedByList);
-      //%% markerstring definedAtLineInSourceFile
-      addProperty("definedAtLineInSourceFile", this,&Private::definedAtLineInSourceFile);
-      //%% string typeConstraints
-      addProperty("typeConstraints",   this,&Private::typeConstraints);
-      //%% string exampleList
-      addProperty("exampleList",       this,&Private::exampleList);
-      //%% string listOfAllMembers
-      addProperty("listOfAllMembers",  this,&Private::listOfAllMembers);
-      //%% string memberList
-      addProperty("memberList",        this,&Private::memberList);
-      //%% string theListOfAllMembers
-      addProperty("theListOfAllMembers",this,&Private::theListOfAllMembers);
-      //%% string incInheritedMembers
-      addProperty("incInheritedMembers",this,&Private::incInheritedMembers);
-      //%% string defineValue
-      addProperty("defineValue",        this,&Private::defineValue);
-      //%% string initialValue
-      addProperty("initialValue",       this,&Private::initialValue);
-      //%% string enumerationValues
-      addProperty("enumerationValues",  this,&Private::enumerationValues);
-      //%% markerstring implements
-      addProperty("implements",         this,&Private::implements);
-      //%% markerstring reimplements
-      addProperty("reimplements",       this,&Private::reimplements);
-      //%% markerstring implementedBy
-      addProperty("implementedBy",      this,&Private::implementedBy);
-      //%% markerstring reimplementedBy
-      addProperty("reimplementedBy",    this,&Private::reimplementedBy);
-      //%% markerstring sourceRefs
-      addProperty("sourceRefs",         this,&Private::sourceRefs);
-      //%% markerstring sourceRefBys
-      addProperty("sourceRefBys",       this,&Private::sourceRefBys);
-      //%% string callGraph
-      addProperty("callGraph",          this,&Private::callGraph);
-      //%% string callerGraph
-      addProperty("callerGraph",        this,&Private::callerGraph);
-      //%% markerstring inheritedFrom
-      addProperty("inheritedFrom",      this,&Private::inheritedFrom);
-      //%% string addtionalInheritedMembers
-      addProperty("additionalInheritedMembers",this,&Private::additionalInheritedMembers);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% string generatedBy
+        addProperty("generatedby",       &Private::generatedBy);
+        //%% string generatedAt
+        addProperty("generatedAt",       &Private::generatedAt);
+        //%% string search
+        addProperty("search",            &Private::search);
+        //%% string mainPage
+        addProperty("mainPage",          &Private::mainPage);
+        //%% string classes
+        addProperty("classes",           &Private::classes);
+        //%% string classList
+        addProperty("classList",         &Private::classList);
+        //%% string classIndex
+        addProperty("classIndex",        &Private::classIndex);
+        //%% string classHierarchy
+        addProperty("classHierarchy",    &Private::classHierarchy);
+        //%% string classMembers
+        addProperty("classMembers",      &Private::classMembers);
+        //%% string modules
+        addProperty("modules",           &Private::modules);
+        //%% string namespaces
+        addProperty("namespaces",        &Private::namespaces);
+        //%% string files
+        addProperty("files",             &Private::files);
+        //%% string pages
+        addProperty("pages",             &Private::pages);
+        //%% string examples
+        addProperty("examples",          &Private::examples);
+        //%% string namespaceList
+        addProperty("namespaceList",     &Private::namespaceList);
+        //%% string namespaceMembers
+        addProperty("namespaceMembers",  &Private::namespaceMembers);
+        //%% srting fileList
+        addProperty("fileList",          &Private::fileList);
+        //%% string fileMembers
+        addProperty("fileMembers",       &Private::fileMembers);
+        //%% string relatedPagesDescripiton
+        addProperty("relatedPagesDesc",  &Private::relatedPagesDesc);
+        //%% string more
+        addProperty("more",              &Private::more);
+        //%% string detailedDescription
+        addProperty("detailedDesc",      &Private::detailedDesc);
+        //%% string inheritanceDiagramFor
+        addProperty("inheritanceDiagramFor", &Private::inheritanceDiagramFor);
+        //%% string collaborationDiagramFor
+        addProperty("collaborationDiagramFor", &Private::collaborationDiagramFor);
+        //%% markerstring inheritsList
+        addProperty("inheritsList",      &Private::inheritsList);
+        //%% markerstring inheritedByList
+        addProperty("inheritedByList",   &Private::inheritedByList);
+        //%% markerstring definedAtLineInSourceFile
+        addProperty("definedAtLineInSourceFile", &Private::definedAtLineInSourceFile);
+        //%% string typeConstraints
+        addProperty("typeConstraints",   &Private::typeConstraints);
+        //%% string exampleList
+        addProperty("exampleList",       &Private::exampleList);
+        //%% string listOfAllMembers
+        addProperty("listOfAllMembers",  &Private::listOfAllMembers);
+        //%% string memberList
+        addProperty("memberList",        &Private::memberList);
+        //%% string theListOfAllMembers
+        addProperty("theListOfAllMembers",&Private::theListOfAllMembers);
+        //%% string incInheritedMembers
+        addProperty("incInheritedMembers",&Private::incInheritedMembers);
+        //%% string defineValue
+        addProperty("defineValue",        &Private::defineValue);
+        //%% string initialValue
+        addProperty("initialValue",       &Private::initialValue);
+        //%% string enumerationValues
+        addProperty("enumerationValues",  &Private::enumerationValues);
+        //%% markerstring implements
+        addProperty("implements",         &Private::implements);
+        //%% markerstring reimplements
+        addProperty("reimplements",       &Private::reimplements);
+        //%% markerstring implementedBy
+        addProperty("implementedBy",      &Private::implementedBy);
+        //%% markerstring reimplementedBy
+        addProperty("reimplementedBy",    &Private::reimplementedBy);
+        //%% markerstring sourceRefs
+        addProperty("sourceRefs",         &Private::sourceRefs);
+        //%% markerstring sourceRefBys
+        addProperty("sourceRefBys",       &Private::sourceRefBys);
+        //%% string callGraph
+        addProperty("callGraph",          &Private::callGraph);
+        //%% string callerGraph
+        addProperty("callerGraph",        &Private::callerGraph);
+        //%% markerstring inheritedFrom
+        addProperty("inheritedFrom",      &Private::inheritedFrom);
+        //%% string addtionalInheritedMembers
+        addProperty("additionalInheritedMembers",&Private::additionalInheritedMembers);
+        init=TRUE;
+      }
 
       m_javaOpt    = Config_getBool("OPTIMIZE_OUTPUT_JAVA");
       m_fortranOpt = Config_getBool("OPTIMIZE_FOR_FORTRAN");
@@ -828,65 +925,45 @@ static TemplateVariant parseCode(MemberDef *md,const QCString &scopeName,const Q
 //%% struct Symbol: shared info for all symbols
 //%% {
 template<typename T>
-class DefinitionContext : public PropertyMapper
+class DefinitionContext : public PropertyMapper<T>
 {
   public:
     DefinitionContext(Definition *d) : m_def(d)
     {
-      //%% string name: the name of the symbol
-      addProperty("name",this,&DefinitionContext::name);
-      //%% string bareName: the bare name of the symbol with scope info
-      addProperty("bareName",this,&DefinitionContext::bareName);
-      //%% string relPath: the relative path to the root of the output (CREATE_SUBDIRS)
-      addProperty("relPath",this,&DefinitionContext::relPath);
-      //%% string fileName: the file name of the output file associated with the symbol (without extension)
-      addProperty("fileName",this,&DefinitionContext::fileName);
-      //%% string anchor: anchor within the page
-      addProperty("anchor",this,&DefinitionContext::anchor);
-      //%% string details: the detailed documentation for this symbol
-      addProperty("details",this,&DefinitionContext::details);
-      //%% string brief: the brief description for this symbol
-      addProperty("brief",this,&DefinitionContext::brief);
-      //%% string inbodyDocs: the documentation found in the body
-      addProperty("inbodyDocs",this,&DefinitionContext::inbodyDocs);
-      //%% string sourceFileName: the file name of the source file (without extension)
-      addProperty("sourceFileName",this,&DefinitionContext::sourceFileName);
-      //%% bool isLinkable: can the symbol be linked to?
-      addProperty("isLinkable",this,&DefinitionContext::isLinkable);
-      //%% bool isLinkableInProject: can the symbol be linked within this project?
-      addProperty("isLinkableInProject",this,&DefinitionContext::isLinkableInProject);
-      //%% int dynSectionId: identifier that can be used for collapsable sections
-      addProperty("dynSectionId",this,&DefinitionContext::dynSectionId);
-      //%% string language: the programming language in which the symbol is written
-      addProperty("language",this,&DefinitionContext::language);
-      //%% string sourceDef: A link to the source definition
-      addProperty("sourceDef",this,&DefinitionContext::sourceDef);
-      //%% list[Definition] navigationPath: Breadcrumb navigation path to this item
-      addProperty("navigationPath",this,&DefinitionContext::navigationPath);
-
-      if (m_def && !m_def->getSourceFileBase().isEmpty())
-      {
-        m_sourceDef.append(&m_lineLink);
-        m_sourceDef.append(&m_fileLink);
-        m_lineLink.set("text",m_def->getStartBodyLine());
-        m_lineLink.set("isLinkable",TRUE);
-        m_lineLink.set("fileName",m_def->getSourceFileBase());
-        m_lineLink.set("anchor",m_def->getSourceAnchor());
-        if (m_def->definitionType()==Definition::TypeFile)
-        {
-          m_fileLink.set("text",m_def->name());
-        }
-        else if (m_def->getBodyDef())
-        {
-          m_fileLink.set("text",m_def->getBodyDef()->name());
-        }
-        else
-        {
-          m_fileLink.set("text",name());
-        }
-        m_fileLink.set("isLinkable",TRUE);
-        m_fileLink.set("fileName",m_def->getSourceFileBase());
-        m_fileLink.set("anchor",QCString());
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% string name: the name of the symbol
+        this->addProperty("name",&DefinitionContext::name);
+        //%% string bareName: the bare name of the symbol with scope info
+        this->addProperty("bareName",&DefinitionContext::bareName);
+        //%% string relPath: the relative path to the root of the output (CREATE_SUBDIRS)
+        this->addProperty("relPath",&DefinitionContext::relPath);
+        //%% string fileName: the file name of the output file associated with the symbol (without extension)
+        this->addProperty("fileName",&DefinitionContext::fileName);
+        //%% string anchor: anchor within the page
+        this->addProperty("anchor",&DefinitionContext::anchor);
+        //%% string details: the detailed documentation for this symbol
+        this->addProperty("details",&DefinitionContext::details);
+        //%% string brief: the brief description for this symbol
+        this->addProperty("brief",&DefinitionContext::brief);
+        //%% string inbodyDocs: the documentation found in the body
+        this->addProperty("inbodyDocs",&DefinitionContext::inbodyDocs);
+        //%% string sourceFileName: the file name of the source file (without extension)
+        this->addProperty("sourceFileName",&DefinitionContext::sourceFileName);
+        //%% bool isLinkable: can the symbol be linked to?
+        this->addProperty("isLinkable",&DefinitionContext::isLinkable);
+        //%% bool isLinkableInProject: can the symbol be linked within this project?
+        this->addProperty("isLinkableInProject",&DefinitionContext::isLinkableInProject);
+        //%% int dynSectionId: identifier that can be used for collapsable sections
+        this->addProperty("dynSectionId",&DefinitionContext::dynSectionId);
+        //%% string language: the programming language in which the symbol is written
+        this->addProperty("language",&DefinitionContext::language);
+        //%% string sourceDef: A link to the source definition
+        this->addProperty("sourceDef",&DefinitionContext::sourceDef);
+        //%% list[Definition] navigationPath: Breadcrumb navigation path to this item
+        this->addProperty("navigationPath",&DefinitionContext::navigationPath);
+        init=TRUE;
       }
     }
     TemplateVariant fileName() const
@@ -928,44 +1005,44 @@ class DefinitionContext : public PropertyMapper
     }
     TemplateVariant details() const
     {
-      if (!m_cache.details)
+      if (!m_cache->details)
       {
-        m_cache.details.reset(new TemplateVariant(parseDoc(m_def,m_def->docFile(),m_def->docLine(),
+        m_cache->details.reset(new TemplateVariant(parseDoc(m_def,m_def->docFile(),m_def->docLine(),
                                             relPathAsString(),m_def->documentation(),FALSE)));
       }
-      return *m_cache.details;
+      return *m_cache->details;
     }
     TemplateVariant brief() const
     {
-      if (!m_cache.brief)
+      if (!m_cache->brief)
       {
         if (m_def->hasBriefDescription())
         {
-          m_cache.brief.reset(new TemplateVariant(parseDoc(m_def,m_def->briefFile(),m_def->briefLine(),
+          m_cache->brief.reset(new TemplateVariant(parseDoc(m_def,m_def->briefFile(),m_def->briefLine(),
                              relPathAsString(),m_def->briefDescription(),TRUE)));
         }
         else
         {
-          m_cache.brief.reset(new TemplateVariant(""));
+          m_cache->brief.reset(new TemplateVariant(""));
         }
       }
-      return *m_cache.brief;
+      return *m_cache->brief;
     }
     TemplateVariant inbodyDocs() const
     {
-      if (!m_cache.inbodyDocs)
+      if (!m_cache->inbodyDocs)
       {
         if (!m_def->inbodyDocumentation().isEmpty())
         {
-          m_cache.inbodyDocs.reset(new TemplateVariant(parseDoc(m_def,m_def->inbodyFile(),m_def->inbodyLine(),
+          m_cache->inbodyDocs.reset(new TemplateVariant(parseDoc(m_def,m_def->inbodyFile(),m_def->inbodyLine(),
                                            relPathAsString(),m_def->inbodyDocumentation(),FALSE)));
         }
         else
         {
-          m_cache.inbodyDocs.reset(new TemplateVariant(""));
+          m_cache->inbodyDocs.reset(new TemplateVariant(""));
         }
       }
-      return *m_cache.inbodyDocs;
+      return *m_cache->inbodyDocs;
     }
     TemplateVariant dynSectionId() const
     {
@@ -997,9 +1074,39 @@ class DefinitionContext : public PropertyMapper
     }
     TemplateVariant sourceDef() const
     {
-      if (m_sourceDef.count()==2)
+      if (m_def && !m_def->getSourceFileBase().isEmpty())
       {
-        return &m_sourceDef;
+        if (!m_cache->sourceDef)
+        {
+          TemplateStruct *lineLink = new TemplateStruct;
+          lineLink->set("text",m_def->getStartBodyLine());
+          lineLink->set("isLinkable",TRUE);
+          lineLink->set("fileName",m_def->getSourceFileBase());
+          lineLink->set("anchor",m_def->getSourceAnchor());
+          m_cache->lineLink.reset(lineLink);
+          TemplateStruct *fileLink = new TemplateStruct;
+          if (m_def->definitionType()==Definition::TypeFile)
+          {
+            fileLink->set("text",m_def->name());
+          }
+          else if (m_def->getBodyDef())
+          {
+            fileLink->set("text",m_def->getBodyDef()->name());
+          }
+          else
+          {
+            fileLink->set("text",name());
+          }
+          fileLink->set("isLinkable",TRUE);
+          fileLink->set("fileName",m_def->getSourceFileBase());
+          fileLink->set("anchor",QCString());
+          m_cache->fileLink.reset(fileLink);
+          TemplateList *list = new TemplateList;
+          list->append(lineLink);
+          list->append(fileLink);
+          m_cache->sourceDef.reset(list);
+        }
+        return m_cache->sourceDef.get();
       }
       else
       {
@@ -1020,17 +1127,17 @@ class DefinitionContext : public PropertyMapper
       }
       NavPathElemContext *elem = new NavPathElemContext(def);
       list->append(elem);
-      m_cache.navPathElems.append(elem);
+      m_cache->navPathElems.append(elem);
     }
     TemplateVariant navigationPath() const
     {
-      if (!m_cache.navPath)
+      if (!m_cache->navPath)
       {
         TemplateList *list = new TemplateList;
         fillPath(m_def,list);
-        m_cache.navPath.reset(list);
+        m_cache->navPath.reset(list);
       }
-      return m_cache.navPath.get();
+      return m_cache->navPath.get();
     }
 
   private:
@@ -1043,11 +1150,11 @@ class DefinitionContext : public PropertyMapper
       ScopedPtr<TemplateVariant> inbodyDocs;
       ScopedPtr<TemplateList>    navPath;
       QList<NavPathElemContext>  navPathElems;
+      ScopedPtr<TemplateList>    sourceDef;
+      ScopedPtr<TemplateStruct>  fileLink;
+      ScopedPtr<TemplateStruct>  lineLink;
     };
-    mutable Cachable m_cache;
-    TemplateList m_sourceDef;
-    TemplateStruct m_fileLink;
-    TemplateStruct m_lineLink;
+    mutable ContextCache<Cachable> m_cache;
 };
 //%% }
 
@@ -1055,22 +1162,28 @@ class DefinitionContext : public PropertyMapper
 
 //%% struct IncludeInfo: include file information
 //%% {
-class IncludeInfoContext::Private : public PropertyMapper
+class IncludeInfoContext::Private : public PropertyMapper<IncludeInfoContext::Private>
 {
   public:
     Private(IncludeInfo *info,SrcLangExt lang) :
       m_info(info),
-      m_fileContext(info && info->fileDef ? info->fileDef : 0),
       m_lang(lang)
     {
-      if (m_info)
+      static bool init=FALSE;
+      if (!init)
       {
-        addProperty("file",this,&Private::file);
-        addProperty("name",this,&Private::name);
-        addProperty("isImport",this,&Private::isImport);
-        addProperty("isLocal",this,&Private::isLocal);
+        addProperty("file",&Private::file);
+        addProperty("name",&Private::name);
+        addProperty("isImport",&Private::isImport);
+        addProperty("isLocal",&Private::isLocal);
+        init=TRUE;
       }
     }
+    TemplateVariant get(const char *name) const
+    {
+      // without include info the object has no properties
+      return m_info ? PropertyMapper<Private>::get(name) : TemplateVariant();
+    }
     TemplateVariant isLocal() const
     {
       bool isIDLorJava = m_lang==SrcLangExt_IDL || m_lang==SrcLangExt_Java;
@@ -1084,7 +1197,11 @@ class IncludeInfoContext::Private : public PropertyMapper
     {
       if (m_info->fileDef)
       {
-        return &m_fileContext;
+        if (!m_fileContext)
+        {
+          m_fileContext.reset(new FileContext(m_info->fileDef));
+        }
+        return m_fileContext.get();
       }
       else
       {
@@ -1097,7 +1214,7 @@ class IncludeInfoContext::Private : public PropertyMapper
     }
   private:
     IncludeInfo *m_info;
-    FileContext m_fileContext;
+    mutable ScopedPtr<FileContext> m_fileContext;
     SrcLangExt m_lang;
 };
 
@@ -1125,73 +1242,77 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
 {
   public:
     Private(ClassDef *cd) : DefinitionContext<ClassContext::Private>(cd) ,
-       m_classDef(cd), m_usedFiles(cd),
-       m_includeInfo(cd ? cd->includeInfo() : 0, cd ? cd->getLanguage() : SrcLangExt_Unknown)
-    {
-      addProperty("title",                     this,&Private::title);
-      addProperty("highlight",                 this,&Private::highlight);
-      addProperty("subhighlight",              this,&Private::subHighlight);
-      addProperty("hasDetails",                this,&Private::hasDetails);
-      addProperty("generatedFromFiles",        this,&Private::generatedFromFiles);
-      addProperty("usedFiles",                 this,&Private::usedFiles);
-      addProperty("hasInheritanceDiagram",     this,&Private::hasInheritanceDiagram);
-      addProperty("inheritanceDiagram",        this,&Private::inheritanceDiagram);
-      addProperty("hasCollaborationDiagram",   this,&Private::hasCollaborationDiagram);
-      addProperty("collaborationDiagram",      this,&Private::collaborationDiagram);
-      addProperty("includeInfo",               this,&Private::includeInfo);
-      addProperty("includeStatement",          this,&Private::includeStatement);
-      addProperty("inherits",                  this,&Private::inherits);
-      addProperty("inheritedBy",               this,&Private::inheritedBy);
-      addProperty("unoIDLServices",            this,&Private::unoIDLServices);
-      addProperty("unoIDLInterfaces",          this,&Private::unoIDLInterfaces);
-      addProperty("signals",                   this,&Private::signals);
-      addProperty("publicTypes",               this,&Private::publicTypes);
-      addProperty("publicMethods",             this,&Private::publicMethods);
-      addProperty("publicStaticMethods",       this,&Private::publicStaticMethods);
-      addProperty("publicAttributes",          this,&Private::publicAttributes);
-      addProperty("publicStaticAttributes",    this,&Private::publicStaticAttributes);
-      addProperty("publicSlots",               this,&Private::publicSlots);
-      addProperty("protectedTypes",            this,&Private::protectedTypes);
-      addProperty("protectedMethods",          this,&Private::protectedMethods);
-      addProperty("protectedStaticMethods",    this,&Private::protectedStaticMethods);
-      addProperty("protectedAttributes",       this,&Private::protectedAttributes);
-      addProperty("protectedStaticAttributes", this,&Private::protectedStaticAttributes);
-      addProperty("protectedSlots",            this,&Private::protectedSlots);
-      addProperty("privateTypes",              this,&Private::privateTypes);
-      addProperty("privateMethods",            this,&Private::privateMethods);
-      addProperty("privateStaticMethods",      this,&Private::privateStaticMethods);
-      addProperty("privateAttributes",         this,&Private::privateAttributes);
-      addProperty("privateStaticAttributes",   this,&Private::privateStaticAttributes);
-      addProperty("privateSlots",              this,&Private::privateSlots);
-      addProperty("packageTypes",              this,&Private::packageTypes);
-      addProperty("packageMethods",            this,&Private::packageMethods);
-      addProperty("packageStaticMethods",      this,&Private::packageStaticMethods);
-      addProperty("packageAttributes",         this,&Private::packageAttributes);
-      addProperty("packageStaticAttributes",   this,&Private::packageStaticAttributes);
-      addProperty("properties",                this,&Private::properties);
-      addProperty("events",                    this,&Private::events);
-      addProperty("friends",                   this,&Private::friends);
-      addProperty("related",                   this,&Private::related);
-      addProperty("detailedTypedefs",          this,&Private::detailedTypedefs);
-      addProperty("detailedEnums",             this,&Private::detailedEnums);
-      addProperty("detailedServices",          this,&Private::detailedServices);
-      addProperty("detailedInterfaces",        this,&Private::detailedInterfaces);
-      addProperty("detailedConstructors",      this,&Private::detailedConstructors);
-      addProperty("detailedMethods",           this,&Private::detailedMethods);
-      addProperty("detailedRelated",           this,&Private::detailedRelated);
-      addProperty("detailedVariables",         this,&Private::detailedVariables);
-      addProperty("detailedProperties",        this,&Private::detailedProperties);
-      addProperty("detailedEvents",            this,&Private::detailedEvents);
-      addProperty("nestedClasses",             this,&Private::nestedClasses);
-      addProperty("compoundType",              this,&Private::compoundType);
-      addProperty("templateDecls",             this,&Private::templateDecls);
-      addProperty("typeConstraints",           this,&Private::typeConstraints);
-      addProperty("examples",                  this,&Private::examples);
-      addProperty("members",                   this,&Private::members);
-      addProperty("allMembersList",            this,&Private::allMembersList);
-      addProperty("allMembersFileName",        this,&Private::allMembersFileName);
-      addProperty("memberGroups",              this,&Private::memberGroups);
-      addProperty("additionalInheritedMembers",this,&Private::additionalInheritedMembers);
+       m_classDef(cd)
+    {
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("title",                     &Private::title);
+        addProperty("highlight",                 &Private::highlight);
+        addProperty("subhighlight",              &Private::subHighlight);
+        addProperty("hasDetails",                &Private::hasDetails);
+        addProperty("generatedFromFiles",        &Private::generatedFromFiles);
+        addProperty("usedFiles",                 &Private::usedFiles);
+        addProperty("hasInheritanceDiagram",     &Private::hasInheritanceDiagram);
+        addProperty("inheritanceDiagram",        &Private::inheritanceDiagram);
+        addProperty("hasCollaborationDiagram",   &Private::hasCollaborationDiagram);
+        addProperty("collaborationDiagram",      &Private::collaborationDiagram);
+        addProperty("includeInfo",               &Private::includeInfo);
+        addProperty("includeStatement",          &Private::includeStatement);
+        addProperty("inherits",                  &Private::inherits);
+        addProperty("inheritedBy",               &Private::inheritedBy);
+        addProperty("unoIDLServices",            &Private::unoIDLServices);
+        addProperty("unoIDLInterfaces",          &Private::unoIDLInterfaces);
+        addProperty("signals",                   &Private::signals);
+        addProperty("publicTypes",               &Private::publicTypes);
+        addProperty("publicMethods",             &Private::publicMethods);
+        addProperty("publicStaticMethods",       &Private::publicStaticMethods);
+        addProperty("publicAttributes",          &Private::publicAttributes);
+        addProperty("publicStaticAttributes",    &Private::publicStaticAttributes);
+        addProperty("publicSlots",               &Private::publicSlots);
+        addProperty("protectedTypes",            &Private::protectedTypes);
+        addProperty("protectedMethods",          &Private::protectedMethods);
+        addProperty("protectedStaticMethods",    &Private::protectedStaticMethods);
+        addProperty("protectedAttributes",       &Private::protectedAttributes);
+        addProperty("protectedStaticAttributes", &Private::protectedStaticAttributes);
+        addProperty("protectedSlots",            &Private::protectedSlots);
+        addProperty("privateTypes",              &Private::privateTypes);
+        addProperty("privateMethods",            &Private::privateMethods);
+        addProperty("privateStaticMethods",      &Private::privateStaticMethods);
+        addProperty("privateAttributes",         &Private::privateAttributes);
+        addProperty("privateStaticAttributes",   &Private::privateStaticAttributes);
+        addProperty("privateSlots",              &Private::privateSlots);
+        addProperty("packageTypes",              &Private::packageTypes);
+        addProperty("packageMethods",            &Private::packageMethods);
+        addProperty("packageStaticMethods",      &Private::packageStaticMethods);
+        addProperty("packageAttributes",         &Private::packageAttributes);
+        addProperty("packageStaticAttributes",   &Private::packageStaticAttributes);
+        addProperty("properties",                &Private::properties);
+        addProperty("events",                    &Private::events);
+        addProperty("friends",                   &Private::friends);
+        addProperty("related",                   &Private::related);
+        addProperty("detailedTypedefs",          &Private::detailedTypedefs);
+        addProperty("detailedEnums",             &Private::detailedEnums);
+        addProperty("detailedServices",          &Private::detailedServices);
+        addProperty("detailedInterfaces",        &Private::detailedInterfaces);
+        addProperty("detailedConstructors",      &Private::detailedConstructors);
+        addProperty("detailedMethods",           &Private::detailedMethods);
+        addProperty("detailedRelated",           &Private::detailedRelated);
+        addProperty("detailedVariables",         &Private::detailedVariables);
+        addProperty("detailedProperties",        &Private::detailedProperties);
+        addProperty("detailedEvents",            &Private::detailedEvents);
+        addProperty("nestedClasses",             &Private::nestedClasses);
+        addProperty("compoundType",              &Private::compoundType);
+        addProperty("templateDecls",             &Private::templateDecls);
+        addProperty("typeConstraints",           &Private::typeConstraints);
+        addProperty("examples",                  &Private::examples);
+        addProperty("members",                   &Private::members);
+        addProperty("allMembersList",            &Private::allMembersList);
+        addProperty("allMembersFileName",        &Private::allMembersFileName);
+        addProperty("memberGroups",              &Private::memberGroups);
+        addProperty("additionalInheritedMembers",&Private::additionalInheritedMembers);
+        init=TRUE;
+      }
     }
     TemplateVariant title() const
     {
@@ -1215,23 +1336,27 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     }
     TemplateVariant usedFiles() const
     {
-      return TemplateVariant(&m_usedFiles);
+      if (!m_cache->usedFiles)
+      {
+        m_cache->usedFiles.reset(new UsedFilesContext(m_classDef));
+      }
+      return m_cache->usedFiles.get();
     }
     DotClassGraph *getClassGraph() const
     {
-      if (!m_cache.classGraph)
+      if (!m_cache->classGraph)
       {
-        m_cache.classGraph.reset(new DotClassGraph(m_classDef,DotNode::Inheritance));
+        m_cache->classGraph.reset(new DotClassGraph(m_classDef,DotNode::Inheritance));
       }
-      return m_cache.classGraph.get();
+      return m_cache->classGraph.get();
     }
     int numInheritanceNodes() const
     {
-      if (m_cache.inheritanceNodes==-1)
+      if (m_cache->inheritanceNodes==-1)
       {
-        m_cache.inheritanceNodes=m_classDef->countInheritanceNodes();
+        m_cache->inheritanceNodes=m_classDef->countInheritanceNodes();
       }
-      return m_cache.inheritanceNodes>0;
+      return m_cache->inheritanceNodes>0;
     }
     TemplateVariant hasInheritanceDiagram() const
     {
@@ -1286,11 +1411,11 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     }
     DotClassGraph *getCollaborationGraph() const
     {
-      if (!m_cache.collaborationGraph)
+      if (!m_cache->collaborationGraph)
       {
-        m_cache.collaborationGraph.reset(new DotClassGraph(m_classDef,DotNode::Collaboration));
+        m_cache->collaborationGraph.reset(new DotClassGraph(m_classDef,DotNode::Collaboration));
       }
-      return m_cache.collaborationGraph.get();
+      return m_cache->collaborationGraph.get();
     }
     TemplateVariant hasCollaborationDiagram() const
     {
@@ -1319,7 +1444,11 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     {
       if (m_classDef->includeInfo())
       {
-        return TemplateVariant(&m_includeInfo);
+        if (!m_cache->includeInfo)
+        {
+          m_cache->includeInfo.reset(new IncludeInfoContext(m_classDef->includeInfo(),m_classDef->getLanguage()));
+        }
+        return m_cache->includeInfo.get();
       }
       else
       {
@@ -1332,19 +1461,19 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     }
     TemplateVariant inherits() const
     {
-      if (!m_cache.inheritsList)
+      if (!m_cache->inheritsList)
       {
-        m_cache.inheritsList.reset(new InheritanceListContext(m_classDef->baseClasses(),TRUE));
+        m_cache->inheritsList.reset(new InheritanceListContext(m_classDef->baseClasses(),TRUE));
       }
-      return m_cache.inheritsList.get();
+      return m_cache->inheritsList.get();
     }
     TemplateVariant inheritedBy() const
     {
-      if (!m_cache.inheritedByList)
+      if (!m_cache->inheritedByList)
       {
-        m_cache.inheritedByList.reset(new InheritanceListContext(m_classDef->subClasses(),FALSE));
+        m_cache->inheritedByList.reset(new InheritanceListContext(m_classDef->subClasses(),FALSE));
       }
-      return m_cache.inheritedByList.get();
+      return m_cache->inheritedByList.get();
     }
     TemplateVariant getMemberList(ScopedPtr<MemberListInfoContext> &list,
                                   MemberListType type,const char *title,bool detailed=FALSE) const
@@ -1368,174 +1497,174 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     }
     TemplateVariant unoIDLServices() const
     {
-      return getMemberList(m_cache.unoIDLServices,MemberListType_services,theTranslator->trServices());
+      return getMemberList(m_cache->unoIDLServices,MemberListType_services,theTranslator->trServices());
     }
     TemplateVariant unoIDLInterfaces() const
     {
-      return getMemberList(m_cache.unoIDLInterfaces,MemberListType_interfaces,theTranslator->trInterfaces());
+      return getMemberList(m_cache->unoIDLInterfaces,MemberListType_interfaces,theTranslator->trInterfaces());
     }
     TemplateVariant signals() const
     {
-      return getMemberList(m_cache.signals,MemberListType_signals,theTranslator->trSignals());
+      return getMemberList(m_cache->signals,MemberListType_signals,theTranslator->trSignals());
     }
     TemplateVariant publicTypes() const
     {
-      return getMemberList(m_cache.publicTypes,MemberListType_pubTypes,theTranslator->trPublicTypes());
+      return getMemberList(m_cache->publicTypes,MemberListType_pubTypes,theTranslator->trPublicTypes());
     }
     TemplateVariant publicMethods() const
     {
-      return getMemberList(m_cache.publicMethods,MemberListType_pubMethods,
+      return getMemberList(m_cache->publicMethods,MemberListType_pubMethods,
           m_classDef->getLanguage()==SrcLangExt_ObjC ? theTranslator->trInstanceMethods()
                                                      : theTranslator->trPublicMembers());
     }
     TemplateVariant publicStaticMethods() const
     {
-      return getMemberList(m_cache.publicStaticMethods,MemberListType_pubStaticMethods,
+      return getMemberList(m_cache->publicStaticMethods,MemberListType_pubStaticMethods,
           m_classDef->getLanguage()==SrcLangExt_ObjC ? theTranslator->trClassMethods()
                                                      : theTranslator->trStaticPublicMembers());
     }
     TemplateVariant publicAttributes() const
     {
-      return getMemberList(m_cache.publicAttributes,MemberListType_pubAttribs,theTranslator->trPublicAttribs());
+      return getMemberList(m_cache->publicAttributes,MemberListType_pubAttribs,theTranslator->trPublicAttribs());
     }
     TemplateVariant publicStaticAttributes() const
     {
-      return getMemberList(m_cache.publicStaticAttributes,MemberListType_pubStaticAttribs,theTranslator->trStaticPublicAttribs());
+      return getMemberList(m_cache->publicStaticAttributes,MemberListType_pubStaticAttribs,theTranslator->trStaticPublicAttribs());
     }
     TemplateVariant publicSlots() const
     {
-      return getMemberList(m_cache.publicSlots,MemberListType_pubSlots,theTranslator->trPublicSlots());
+      return getMemberList(m_cache->publicSlots,MemberListType_pubSlots,theTranslator->trPublicSlots());
     }
     TemplateVariant protectedTypes() const
     {
-      return getMemberList(m_cache.protectedTypes,MemberListType_proTypes,theTranslator->trProtectedTypes());
+      return getMemberList(m_cache->protectedTypes,MemberListType_proTypes,theTranslator->trProtectedTypes());
     }
     TemplateVariant protectedMethods() const
     {
-      return getMemberList(m_cache.protectedMethods,MemberListType_proMethods,theTranslator->trProtectedMembers());
+      return getMemberList(m_cache->protectedMethods,MemberListType_proMethods,theTranslator->trProtectedMembers());
     }
     TemplateVariant protectedStaticMethods() const
     {
-      return getMemberList(m_cache.protectedStaticMethods,MemberListType_proStaticMethods,theTranslator->trStaticProtectedMembers());
+      return getMemberList(m_cache->protectedStaticMethods,MemberListType_proStaticMethods,theTranslator->trStaticProtectedMembers());
     }
     TemplateVariant protectedAttributes() const
     {
-      return getMemberList(m_cache.protectedAttributes,MemberListType_proAttribs,theTranslator->trProtectedAttribs());
+      return getMemberList(m_cache->protectedAttributes,MemberListType_proAttribs,theTranslator->trProtectedAttribs());
     }
     TemplateVariant protectedStaticAttributes() const
     {
-      return getMemberList(m_cache.protectedStaticAttributes,MemberListType_proStaticAttribs,theTranslator->trStaticProtectedAttribs());
+      return getMemberList(m_cache->protectedStaticAttributes,MemberListType_proStaticAttribs,theTranslator->trStaticProtectedAttribs());
     }
     TemplateVariant protectedSlots() const
     {
-      return getMemberList(m_cache.protectedSlots,MemberListType_proSlots,theTranslator->trProtectedSlots());
+      return getMemberList(m_cache->protectedSlots,MemberListType_proSlots,theTranslator->trProtectedSlots());
     }
     TemplateVariant privateTypes() const
     {
-      return getMemberList(m_cache.privateTypes,MemberListType_priTypes,theTranslator->trPrivateTypes());
+      return getMemberList(m_cache->privateTypes,MemberListType_priTypes,theTranslator->trPrivateTypes());
     }
     TemplateVariant privateSlots() const
     {
-      return getMemberList(m_cache.privateSlots,MemberListType_priSlots,theTranslator->trPrivateSlots());
+      return getMemberList(m_cache->privateSlots,MemberListType_priSlots,theTranslator->trPrivateSlots());
     }
     TemplateVariant privateMethods() const
     {
-      return getMemberList(m_cache.privateMethods,MemberListType_priMethods,theTranslator->trPrivateMembers());
+      return getMemberList(m_cache->privateMethods,MemberListType_priMethods,theTranslator->trPrivateMembers());
     }
     TemplateVariant privateStaticMethods() const
     {
-      return getMemberList(m_cache.privateStaticMethods,MemberListType_priStaticMethods,theTranslator->trStaticPrivateMembers());
+      return getMemberList(m_cache->privateStaticMethods,MemberListType_priStaticMethods,theTranslator->trStaticPrivateMembers());
     }
     TemplateVariant privateAttributes() const
     {
-      return getMemberList(m_cache.privateAttributes,MemberListType_priAttribs,theTranslator->trPrivateAttribs());
+      return getMemberList(m_cache->privateAttributes,MemberListType_priAttribs,theTranslator->trPrivateAttribs());
     }
     TemplateVariant privateStaticAttributes() const
     {
-      return getMemberList(m_cache.privateStaticAttributes,MemberListType_priStaticAttribs,theTranslator->trStaticPrivateAttribs());
+      return getMemberList(m_cache->privateStaticAttributes,MemberListType_priStaticAttribs,theTranslator->trStaticPrivateAttribs());
     }
     TemplateVariant packageTypes() const
     {
-      return getMemberList(m_cache.packageTypes,MemberListType_pacTypes,theTranslator->trPackageTypes());
+      return getMemberList(m_cache->packageTypes,MemberListType_pacTypes,theTranslator->trPackageTypes());
     }
     TemplateVariant packageMethods() const
     {
-      return getMemberList(m_cache.packageMethods,MemberListType_pacMethods,theTranslator->trPackageMembers());
+      return getMemberList(m_cache->packageMethods,MemberListType_pacMethods,theTranslator->trPackageMembers());
     }
     TemplateVariant packageStaticMethods() const
     {
-      return getMemberList(m_cache.packageStaticMethods,MemberListType_pacStaticMethods,theTranslator->trStaticPackageMembers());
+      return getMemberList(m_cache->packageStaticMethods,MemberListType_pacStaticMethods,theTranslator->trStaticPackageMembers());
     }
     TemplateVariant packageAttributes() const
     {
-      return getMemberList(m_cache.packageAttributes,MemberListType_pacAttribs,theTranslator->trPackageAttribs());
+      return getMemberList(m_cache->packageAttributes,MemberListType_pacAttribs,theTranslator->trPackageAttribs());
     }
     TemplateVariant packageStaticAttributes() const
     {
-      return getMemberList(m_cache.packageStaticAttributes,MemberListType_pacStaticAttribs,theTranslator->trStaticPackageAttribs());
+      return getMemberList(m_cache->packageStaticAttributes,MemberListType_pacStaticAttribs,theTranslator->trStaticPackageAttribs());
     }
     TemplateVariant properties() const
     {
-      return getMemberList(m_cache.properties,MemberListType_properties,theTranslator->trProperties());
+      return getMemberList(m_cache->properties,MemberListType_properties,theTranslator->trProperties());
     }
     TemplateVariant events() const
     {
-      return getMemberList(m_cache.events,MemberListType_events,theTranslator->trEvents());
+      return getMemberList(m_cache->events,MemberListType_events,theTranslator->trEvents());
     }
     TemplateVariant friends() const
     {
-      return getMemberList(m_cache.friends,MemberListType_friends,theTranslator->trFriends());
+      return getMemberList(m_cache->friends,MemberListType_friends,theTranslator->trFriends());
     }
     TemplateVariant related() const
     {
-      return getMemberList(m_cache.related,MemberListType_related,theTranslator->trRelatedFunctions());
+      return getMemberList(m_cache->related,MemberListType_related,theTranslator->trRelatedFunctions());
     }
     TemplateVariant detailedTypedefs() const
     {
-      return getMemberList(m_cache.detailedTypedefs,MemberListType_typedefMembers,theTranslator->trMemberTypedefDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedTypedefs,MemberListType_typedefMembers,theTranslator->trMemberTypedefDocumentation(),TRUE);
     }
     TemplateVariant detailedEnums() const
     {
-      return getMemberList(m_cache.detailedEnums,MemberListType_enumMembers,theTranslator->trMemberEnumerationDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedEnums,MemberListType_enumMembers,theTranslator->trMemberEnumerationDocumentation(),TRUE);
     }
     TemplateVariant detailedServices() const
     {
-      return getMemberList(m_cache.detailedServices,MemberListType_serviceMembers,theTranslator->trServices(),TRUE);
+      return getMemberList(m_cache->detailedServices,MemberListType_serviceMembers,theTranslator->trServices(),TRUE);
     }
     TemplateVariant detailedInterfaces() const
     {
-      return getMemberList(m_cache.detailedInterfaces,MemberListType_interfaceMembers,theTranslator->trInterfaces(),TRUE);
+      return getMemberList(m_cache->detailedInterfaces,MemberListType_interfaceMembers,theTranslator->trInterfaces(),TRUE);
     }
     TemplateVariant detailedConstructors() const
     {
-      return getMemberList(m_cache.detailedConstructors,MemberListType_constructors,theTranslator->trConstructorDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedConstructors,MemberListType_constructors,theTranslator->trConstructorDocumentation(),TRUE);
     }
     TemplateVariant detailedMethods() const
     {
-      return getMemberList(m_cache.detailedMethods,MemberListType_functionMembers,theTranslator->trMemberFunctionDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedMethods,MemberListType_functionMembers,theTranslator->trMemberFunctionDocumentation(),TRUE);
     }
     TemplateVariant detailedRelated() const
     {
-      return getMemberList(m_cache.detailedRelated,MemberListType_relatedMembers,theTranslator->trRelatedFunctionDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedRelated,MemberListType_relatedMembers,theTranslator->trRelatedFunctionDocumentation(),TRUE);
     }
     TemplateVariant detailedVariables() const
     {
-      return getMemberList(m_cache.detailedVariables,MemberListType_variableMembers,theTranslator->trMemberDataDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedVariables,MemberListType_variableMembers,theTranslator->trMemberDataDocumentation(),TRUE);
     }
     TemplateVariant detailedProperties() const
     {
-      return getMemberList(m_cache.detailedProperties,MemberListType_propertyMembers,theTranslator->trPropertyDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedProperties,MemberListType_propertyMembers,theTranslator->trPropertyDocumentation(),TRUE);
     }
     TemplateVariant detailedEvents() const
     {
-      return getMemberList(m_cache.detailedEvents,MemberListType_eventMembers,theTranslator->trEventDocumentation(),TRUE);
+      return getMemberList(m_cache->detailedEvents,MemberListType_eventMembers,theTranslator->trEventDocumentation(),TRUE);
     }
     TemplateVariant nestedClasses() const
     {
       static bool extractPrivate      = Config_getBool("EXTRACT_PRIVATE");
       static bool hideUndocClasses    = Config_getBool("HIDE_UNDOC_CLASSES");
       static bool extractLocalClasses = Config_getBool("EXTRACT_LOCAL_CLASSES");
-      if (!m_cache.nestedClasses)
+      if (!m_cache->nestedClasses)
       {
         NestedClassListContext *classList = new NestedClassListContext;
         if (m_classDef->getClassSDict())
@@ -1555,9 +1684,9 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
             }
           }
         }
-        m_cache.nestedClasses.reset(classList);
+        m_cache->nestedClasses.reset(classList);
       }
-      return m_cache.nestedClasses.get();
+      return m_cache->nestedClasses.get();
     }
     TemplateVariant compoundType() const
     {
@@ -1578,7 +1707,7 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
           ArgumentListContext *al = new ArgumentListContext(cd->templateArguments(),cd,relPathAsString());
           // since a TemplateVariant does take ownership of the object, we add it
           // a separate list just to be able to delete it and avoid a memory leak
-          m_cache.templateArgList.append(al);
+          m_cache->templateArgList.append(al);
           tl->append(al);
         }
       }
@@ -1592,7 +1721,7 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
         for (it.toFirst();(ex=it.current());++it)
         {
           TemplateStruct *s = new TemplateStruct;
-          m_cache.exampleList.append(s);
+          m_cache->exampleList.append(s);
           s->set("text",ex->name);
           s->set("isLinkable",TRUE);
           s->set("anchor",ex->anchor);
@@ -1603,35 +1732,35 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     }
     TemplateVariant templateDecls() const
     {
-      if (!m_cache.templateDecls)
+      if (!m_cache->templateDecls)
       {
         TemplateList *tl = new TemplateList;
         addTemplateDecls(m_classDef,tl);
-        m_cache.templateDecls.reset(tl);
+        m_cache->templateDecls.reset(tl);
       }
-      return m_cache.templateDecls.get();
+      return m_cache->templateDecls.get();
     }
     TemplateVariant typeConstraints() const
     {
-      if (!m_cache.typeConstraints && m_classDef->typeConstraints())
+      if (!m_cache->typeConstraints && m_classDef->typeConstraints())
       {
-        m_cache.typeConstraints.reset(new ArgumentListContext(m_classDef->typeConstraints(),m_classDef,relPathAsString()));
+        m_cache->typeConstraints.reset(new ArgumentListContext(m_classDef->typeConstraints(),m_classDef,relPathAsString()));
       }
       else
       {
-        m_cache.typeConstraints.reset(new ArgumentListContext);
+        m_cache->typeConstraints.reset(new ArgumentListContext);
       }
-      return m_cache.typeConstraints.get();
+      return m_cache->typeConstraints.get();
     }
     TemplateVariant examples() const
     {
-      if (!m_cache.examples)
+      if (!m_cache->examples)
       {
         TemplateList *exampleList = new TemplateList;
         addExamples(exampleList);
-        m_cache.examples.reset(exampleList);
+        m_cache->examples.reset(exampleList);
       }
-      return m_cache.examples.get();
+      return m_cache->examples.get();
     }
     void addMembers(ClassDef *cd,MemberListType lt) const
     {
@@ -1644,14 +1773,14 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
         {
           if (md->isBriefSectionVisible())
           {
-            m_cache.allMembers.append(md);
+            m_cache->allMembers.append(md);
           }
         }
       }
     }
     TemplateVariant members() const
     {
-      if (!m_cache.members)
+      if (!m_cache->members)
       {
         addMembers(m_classDef,MemberListType_pubTypes);
         addMembers(m_classDef,MemberListType_services);
@@ -1682,22 +1811,22 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
         addMembers(m_classDef,MemberListType_priAttribs);
         addMembers(m_classDef,MemberListType_priStaticAttribs);
         addMembers(m_classDef,MemberListType_related);
-        m_cache.members.reset(new MemberListContext(&m_cache.allMembers));
+        m_cache->members.reset(new MemberListContext(&m_cache->allMembers));
       }
-      return m_cache.members.get();
+      return m_cache->members.get();
     }
     TemplateVariant allMembersList() const
     {
-      if (!m_cache.allMembersList && m_classDef->memberNameInfoSDict())
+      if (!m_cache->allMembersList && m_classDef->memberNameInfoSDict())
       {
         AllMembersListContext *ml = new AllMembersListContext(m_classDef->memberNameInfoSDict());
-        m_cache.allMembersList.reset(ml);
+        m_cache->allMembersList.reset(ml);
       }
       else
       {
-        m_cache.allMembersList.reset(new AllMembersListContext);
+        m_cache->allMembersList.reset(new AllMembersListContext);
       }
-      return m_cache.allMembersList.get();
+      return m_cache->allMembersList.get();
     }
     TemplateVariant allMembersFileName() const
     {
@@ -1705,22 +1834,22 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
     }
     TemplateVariant memberGroups() const
     {
-      if (!m_cache.memberGroups)
+      if (!m_cache->memberGroups)
       {
         if (m_classDef->getMemberGroupSDict())
         {
-          m_cache.memberGroups.reset(new MemberGroupListContext(m_classDef,relPathAsString(),m_classDef->getMemberGroupSDict(),m_classDef->subGrouping()));
+          m_cache->memberGroups.reset(new MemberGroupListContext(m_classDef,relPathAsString(),m_classDef->getMemberGroupSDict(),m_classDef->subGrouping()));
         }
         else
         {
-          m_cache.memberGroups.reset(new MemberGroupListContext);
+          m_cache->memberGroups.reset(new MemberGroupListContext);
         }
       }
-      return m_cache.memberGroups.get();
+      return m_cache->memberGroups.get();
     }
     TemplateVariant additionalInheritedMembers() const
     {
-      if (!m_cache.additionalInheritedMembers)
+      if (!m_cache->additionalInheritedMembers)
       {
         InheritedMemberInfoListContext *ctx = new InheritedMemberInfoListContext;
         ctx->addMemberList(m_classDef,MemberListType_pubTypes,theTranslator->trPublicTypes());
@@ -1756,15 +1885,13 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
         ctx->addMemberList(m_classDef,MemberListType_priAttribs,theTranslator->trPrivateAttribs());
         ctx->addMemberList(m_classDef,MemberListType_priStaticAttribs,theTranslator->trStaticPrivateAttribs());
         ctx->addMemberList(m_classDef,MemberListType_related,theTranslator->trRelatedFunctions());
-        m_cache.additionalInheritedMembers.reset(ctx);
+        m_cache->additionalInheritedMembers.reset(ctx);
       }
-      return m_cache.additionalInheritedMembers.get();
+      return m_cache->additionalInheritedMembers.get();
     }
 
   private:
     ClassDef *m_classDef;
-    UsedFilesContext m_usedFiles;
-    IncludeInfoContext m_includeInfo;
     struct Cachable
     {
       Cachable() : inheritanceNodes(-1)
@@ -1773,6 +1900,8 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
         exampleList.setAutoDelete(TRUE);
         allMembers.setAutoDelete(TRUE);
       }
+      ScopedPtr<UsedFilesContext>       usedFiles;
+      ScopedPtr<IncludeInfoContext>     includeInfo;
       ScopedPtr<InheritanceListContext> inheritsList;
       ScopedPtr<InheritanceListContext> inheritedByList;
       ScopedPtr<DotClassGraph>          classGraph;
@@ -1830,7 +1959,7 @@ class ClassContext::Private : public DefinitionContext<ClassContext::Private>
       QList<TemplateStruct>            exampleList;
       MemberList                       allMembers;
     };
-    mutable Cachable m_cache;
+    mutable ContextCache<Cachable> m_cache;
 };
 //%% }
 
@@ -1859,9 +1988,14 @@ class NamespaceContext::Private : public DefinitionContext<NamespaceContext::Pri
   public:
     Private(NamespaceDef *nd) : DefinitionContext<NamespaceContext::Private>(nd) , m_namespaceDef(nd)
     {
-      addProperty("title",this,&Private::title);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subHighlight);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("title",&Private::title);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subHighlight);
+        init=TRUE;
+      }
     }
     TemplateVariant title() const
     {
@@ -1904,10 +2038,15 @@ class FileContext::Private : public DefinitionContext<FileContext::Private>
   public:
     Private(FileDef *fd) : DefinitionContext<FileContext::Private>(fd) , m_fileDef(fd)
     {
-      addProperty("title",this,&Private::title);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subHighlight);
-      addProperty("versionInfo",this,&Private::versionInfo);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("title",&Private::title);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subHighlight);
+        addProperty("versionInfo",&Private::versionInfo);
+        init=TRUE;
+      }
     }
     TemplateVariant title() const
     {
@@ -1954,10 +2093,15 @@ class DirContext::Private : public DefinitionContext<DirContext::Private>
   public:
     Private(DirDef *dd) : DefinitionContext<DirContext::Private>(dd) , m_dirDef(dd)
     {
-      addProperty("title",this,&Private::title);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subHighlight);
-      addProperty("dirName",this,&Private::dirName);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("title",&Private::title);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subHighlight);
+        addProperty("dirName",&Private::dirName);
+        init=TRUE;
+      }
     }
     TemplateVariant title() const
     {
@@ -2005,9 +2149,14 @@ class PageContext::Private : public DefinitionContext<PageContext::Private>
   public:
     Private(PageDef *pd) : DefinitionContext<PageContext::Private>(pd) , m_pageDef(pd)
     {
-      addProperty("title",this,&Private::title);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subHighlight);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("title",&Private::title);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subHighlight);
+        init=TRUE;
+      }
     }
     TemplateVariant title() const
     {
@@ -2160,60 +2309,65 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
   public:
     Private(MemberDef *md) : DefinitionContext<MemberContext::Private>(md) , m_memberDef(md)
     {
-      addProperty("declType",            this,&Private::declType);
-      addProperty("declArgs",            this,&Private::declArgs);
-      addProperty("isStatic",            this,&Private::isStatic);
-      addProperty("isObjCMethod",        this,&Private::isObjCMethod);
-      addProperty("isObjCProperty",      this,&Private::isObjCProperty);
-      addProperty("isDefine",            this,&Private::isDefine);
-      addProperty("isImplementation",    this,&Private::isImplementation);
-      addProperty("isEvent",             this,&Private::isEvent);
-      addProperty("isProperty",          this,&Private::isProperty);
-      addProperty("isEnumeration",       this,&Private::isEnumeration);
-      addProperty("isEnumValue",         this,&Private::isEnumValue);
-      addProperty("isAnonymous",         this,&Private::isAnonymous);
-      addProperty("anonymousType",       this,&Private::anonymousType);
-      addProperty("anonymousMember",     this,&Private::anonymousMember);
-      addProperty("isRelated",           this,&Private::isRelated);
-      addProperty("hasDetails",          this,&Private::hasDetails);
-      addProperty("exception",           this,&Private::exception);
-      addProperty("bitfields",           this,&Private::bitfields);
-      addProperty("initializer",         this,&Private::initializer);
-      addProperty("initializerAsCode",   this,&Private::initializerAsCode);
-      addProperty("hasOneLineInitializer",   this,&Private::hasOneLineInitializer);
-      addProperty("hasMultiLineInitializer", this,&Private::hasMultiLineInitializer);
-      addProperty("templateArgs",        this,&Private::templateArgs);
-      addProperty("templateAlias",       this,&Private::templateAlias);
-      addProperty("propertyAttrs",       this,&Private::propertyAttrs);
-      addProperty("eventAttrs",          this,&Private::eventAttrs);
-      addProperty("class",               this,&Private::getClass);
-      addProperty("definition",          this,&Private::definition);
-      addProperty("parameters",          this,&Private::parameters);
-      addProperty("hasParameterList",    this,&Private::hasParameterList);
-      addProperty("hasConstQualifier",   this,&Private::hasConstQualifier);
-      addProperty("hasVolatileQualifier",this,&Private::hasVolatileQualifier);
-      addProperty("trailingReturnType",  this,&Private::trailingReturnType);
-      addProperty("extraTypeChars",      this,&Private::extraTypeChars);
-      addProperty("templateDecls",       this,&Private::templateDecls);
-      addProperty("labels",              this,&Private::labels);
-      addProperty("enumBaseType",        this,&Private::enumBaseType);
-      addProperty("enumValues",          this,&Private::enumValues);
-      addProperty("paramDocs",           this,&Private::paramDocs);
-      addProperty("reimplements",        this,&Private::reimplements);
-      addProperty("implements",          this,&Private::implements);
-      addProperty("reimplementedBy",     this,&Private::reimplementedBy);
-      addProperty("implementedBy",       this,&Private::implementedBy);
-      addProperty("examples",            this,&Private::examples);
-      addProperty("typeConstraints",     this,&Private::typeConstraints);
-      addProperty("functionQualifier",   this,&Private::functionQualifier);
-      addProperty("sourceRefs",          this,&Private::sourceRefs);
-      addProperty("sourceRefBys",        this,&Private::sourceRefBys);
-      addProperty("hasSources",          this,&Private::hasSources);
-      addProperty("sourceCode",          this,&Private::sourceCode);
-      addProperty("hasCallGraph",        this,&Private::hasCallGraph);
-      addProperty("callGraph",           this,&Private::callGraph);
-      addProperty("hasCallerGraph",      this,&Private::hasCallerGraph);
-      addProperty("callerGraph",         this,&Private::callerGraph);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("declType",            &Private::declType);
+        addProperty("declArgs",            &Private::declArgs);
+        addProperty("isStatic",            &Private::isStatic);
+        addProperty("isObjCMethod",        &Private::isObjCMethod);
+        addProperty("isObjCProperty",      &Private::isObjCProperty);
+        addProperty("isDefine",            &Private::isDefine);
+        addProperty("isImplementation",    &Private::isImplementation);
+        addProperty("isEvent",             &Private::isEvent);
+        addProperty("isProperty",          &Private::isProperty);
+        addProperty("isEnumeration",       &Private::isEnumeration);
+        addProperty("isEnumValue",         &Private::isEnumValue);
+        addProperty("isAnonymous",         &Private::isAnonymous);
+        addProperty("anonymousType",       &Private::anonymousType);
+        addProperty("anonymousMember",     &Private::anonymousMember);
+        addProperty("isRelated",           &Private::isRelated);
+        addProperty("hasDetails",          &Private::hasDetails);
+        addProperty("exception",           &Private::exception);
+        addProperty("bitfields",           &Private::bitfields);
+        addProperty("initializer",         &Private::initializer);
+        addProperty("initializerAsCode",   &Private::initializerAsCode);
+        addProperty("hasOneLineInitializer",   &Private::hasOneLineInitializer);
+        addProperty("hasMultiLineInitializer", &Private::hasMultiLineInitializer);
+        addProperty("templateArgs",        &Private::templateArgs);
+        addProperty("templateAlias",       &Private::templateAlias);
+        addProperty("propertyAttrs",       &Private::propertyAttrs);
+        addProperty("eventAttrs",          &Private::eventAttrs);
+        addProperty("class",               &Private::getClass);
+        addProperty("definition",          &Private::definition);
+        addProperty("parameters",          &Private::parameters);
+        addProperty("hasParameterList",    &Private::hasParameterList);
+        addProperty("hasConstQualifier",   &Private::hasConstQualifier);
+        addProperty("hasVolatileQualifier",&Private::hasVolatileQualifier);
+        addProperty("trailingReturnType",  &Private::trailingReturnType);
+        addProperty("extraTypeChars",      &Private::extraTypeChars);
+        addProperty("templateDecls",       &Private::templateDecls);
+        addProperty("labels",              &Private::labels);
+        addProperty("enumBaseType",        &Private::enumBaseType);
+        addProperty("enumValues",          &Private::enumValues);
+        addProperty("paramDocs",           &Private::paramDocs);
+        addProperty("reimplements",        &Private::reimplements);
+        addProperty("implements",          &Private::implements);
+        addProperty("reimplementedBy",     &Private::reimplementedBy);
+        addProperty("implementedBy",       &Private::implementedBy);
+        addProperty("examples",            &Private::examples);
+        addProperty("typeConstraints",     &Private::typeConstraints);
+        addProperty("functionQualifier",   &Private::functionQualifier);
+        addProperty("sourceRefs",          &Private::sourceRefs);
+        addProperty("sourceRefBys",        &Private::sourceRefBys);
+        addProperty("hasSources",          &Private::hasSources);
+        addProperty("sourceCode",          &Private::sourceCode);
+        addProperty("hasCallGraph",        &Private::hasCallGraph);
+        addProperty("callGraph",           &Private::callGraph);
+        addProperty("hasCallerGraph",      &Private::hasCallerGraph);
+        addProperty("callerGraph",         &Private::callerGraph);
+        init=TRUE;
+      }
 
       if (md && md->isProperty())
       {
@@ -2285,7 +2439,7 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant initializerAsCode() const
     {
-      if (!m_cache.initializerParsed)
+      if (!m_cache->initializerParsed)
       {
         QCString scopeName;
         if (m_memberDef->getClassDef())
@@ -2296,11 +2450,11 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
         {
           scopeName = m_memberDef->getNamespaceDef()->name();
         }
-        m_cache.initializer = parseCode(m_memberDef,scopeName,relPathAsString(),
+        m_cache->initializer = parseCode(m_memberDef,scopeName,relPathAsString(),
                                         m_memberDef->initializer());
-        m_cache.initializerParsed = TRUE;
+        m_cache->initializerParsed = TRUE;
       }
-      return m_cache.initializer;
+      return m_cache->initializer;
     }
     TemplateVariant isDefine() const
     {
@@ -2313,17 +2467,17 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant anonymousType() const
     {
-      if (!m_cache.anonymousType)
+      if (!m_cache->anonymousType)
       {
         ClassDef *cd = m_memberDef->getClassDefOfAnonymousType();
         if (cd)
         {
-          m_cache.anonymousType.reset(new ClassContext(cd));
+          m_cache->anonymousType.reset(new ClassContext(cd));
         }
       }
-      if (m_cache.anonymousType)
+      if (m_cache->anonymousType)
       {
-        return m_cache.anonymousType.get();
+        return m_cache->anonymousType.get();
       }
       else
       {
@@ -2332,17 +2486,17 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant anonymousMember() const
     {
-      if (!m_cache.anonymousMember)
+      if (!m_cache->anonymousMember)
       {
         MemberDef *md = m_memberDef->fromAnonymousMember();
         if (md)
         {
-          m_cache.anonymousMember.reset(new MemberContext(md));
+          m_cache->anonymousMember.reset(new MemberContext(md));
         }
       }
-      if (m_cache.anonymousMember)
+      if (m_cache->anonymousMember)
       {
-        return m_cache.anonymousMember.get();
+        return m_cache->anonymousMember.get();
       }
       else
       {
@@ -2367,29 +2521,29 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant enumValues() const
     {
-      if (!m_cache.enumValues)
+      if (!m_cache->enumValues)
       {
         MemberList *ml = m_memberDef->enumFieldList();
         if (ml)
         {
-          m_cache.enumValues.reset(new MemberListContext(ml));
+          m_cache->enumValues.reset(new MemberListContext(ml));
         }
         else
         {
-          m_cache.enumValues.reset(new MemberListContext);
+          m_cache->enumValues.reset(new MemberListContext);
         }
       }
-      return m_cache.enumValues.get();
+      return m_cache->enumValues.get();
     }
     TemplateVariant templateArgs() const
     {
-      if (!m_cache.templateArgs && m_memberDef->templateArguments())
+      if (!m_cache->templateArgs && m_memberDef->templateArguments())
       {
-        m_cache.templateArgs.reset(new ArgumentListContext(m_memberDef->templateArguments(),m_memberDef,relPathAsString()));
+        m_cache->templateArgs.reset(new ArgumentListContext(m_memberDef->templateArguments(),m_memberDef,relPathAsString()));
       }
-      if (m_cache.templateArgs)
+      if (m_cache->templateArgs)
       {
-        return m_cache.templateArgs.get();
+        return m_cache->templateArgs.get();
       }
       else
       {
@@ -2415,13 +2569,13 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant getClass() const
     {
-      if (!m_cache.classDef && m_memberDef->getClassDef())
+      if (!m_cache->classDef && m_memberDef->getClassDef())
       {
-        m_cache.classDef.reset(new ClassContext(m_memberDef->getClassDef()));
+        m_cache->classDef.reset(new ClassContext(m_memberDef->getClassDef()));
       }
-      if (m_cache.classDef)
+      if (m_cache->classDef)
       {
-        return m_cache.classDef.get();
+        return m_cache->classDef.get();
       }
       else
       {
@@ -2440,19 +2594,19 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant parameters() const
     {
-      if (!m_cache.arguments)
+      if (!m_cache->arguments)
       {
         ArgumentList *defArgList = getDefArgList();
         if (defArgList && !m_memberDef->isProperty())
         {
-          m_cache.arguments.reset(new ArgumentListContext(defArgList,m_memberDef,relPathAsString()));
+          m_cache->arguments.reset(new ArgumentListContext(defArgList,m_memberDef,relPathAsString()));
         }
         else
         {
-          m_cache.arguments.reset(new ArgumentListContext);
+          m_cache->arguments.reset(new ArgumentListContext);
         }
       }
-      return m_cache.arguments.get();
+      return m_cache->arguments.get();
     }
     TemplateVariant hasParameterList() const
     {
@@ -2497,7 +2651,7 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
           if (tal->count()>0)
           {
             ArgumentListContext *al = new ArgumentListContext(tal,m_memberDef,relPathAsString());
-            m_cache.templateArgList.append(al);
+            m_cache->templateArgList.append(al);
             tl->append(al);
           }
         }
@@ -2516,7 +2670,7 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
             if (tal->count()>0)
             {
               ArgumentListContext *al = new ArgumentListContext(tal,m_memberDef,relPathAsString());
-              m_cache.templateArgList.append(al);
+              m_cache->templateArgList.append(al);
               tl->append(al);
             }
           }
@@ -2525,24 +2679,24 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
         {
           ArgumentListContext *al = new ArgumentListContext(
               m_memberDef->templateArguments(),m_memberDef,relPathAsString());
-          m_cache.templateArgList.append(al);
+          m_cache->templateArgList.append(al);
           tl->append(al);
         }
       }
     }
     TemplateVariant templateDecls() const
     {
-      if (!m_cache.templateDecls)
+      if (!m_cache->templateDecls)
       {
         TemplateList *tl = new TemplateList;
         addTemplateDecls(tl);
-        m_cache.templateDecls.reset(tl);
+        m_cache->templateDecls.reset(tl);
       }
-      return m_cache.templateDecls.get();
+      return m_cache->templateDecls.get();
     }
     TemplateVariant labels() const
     {
-      if (!m_cache.labels)
+      if (!m_cache->labels)
       {
         QStrList sl;
         m_memberDef->getLabels(sl,m_memberDef->getOuterScope());
@@ -2555,13 +2709,13 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
             tl->append(*it);
           }
         }
-        m_cache.labels.reset(tl);
+        m_cache->labels.reset(tl);
       }
-      return m_cache.labels.get();
+      return m_cache->labels.get();
     }
     TemplateVariant paramDocs() const
     {
-      if (!m_cache.paramDocs)
+      if (!m_cache->paramDocs)
       {
         if (m_memberDef->argumentList() && m_memberDef->argumentList()->hasDocumentation())
         {
@@ -2577,61 +2731,61 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
               paramDocs+="@param"+direction+" "+a->name+" "+a->docs;
             }
           }
-          m_cache.paramDocs.reset(new TemplateVariant(parseDoc(m_memberDef,
+          m_cache->paramDocs.reset(new TemplateVariant(parseDoc(m_memberDef,
                                            m_memberDef->docFile(),m_memberDef->docLine(),
                                            relPathAsString(),paramDocs,FALSE)));
         }
         else
         {
-          m_cache.paramDocs.reset(new TemplateVariant(""));
+          m_cache->paramDocs.reset(new TemplateVariant(""));
         }
       }
-      return *m_cache.paramDocs;
+      return *m_cache->paramDocs;
     }
     TemplateVariant implements() const
     {
-      if (!m_cache.implements)
+      if (!m_cache->implements)
       {
         MemberDef *md = m_memberDef->reimplements();
-        m_cache.implements.reset(new TemplateList);
+        m_cache->implements.reset(new TemplateList);
         if (md)
         {
           ClassDef *cd = md->getClassDef();
           if (cd && (md->virtualness()==Pure || cd->compoundType()==ClassDef::Interface))
           {
             MemberContext *mc = new MemberContext(md);
-            m_cache.implementsMember.reset(mc);
-            m_cache.implements->append(mc);
+            m_cache->implementsMember.reset(mc);
+            m_cache->implements->append(mc);
           }
         }
       }
-      return m_cache.implements.get();
+      return m_cache->implements.get();
     }
     TemplateVariant reimplements() const
     {
-      if (!m_cache.reimplements)
+      if (!m_cache->reimplements)
       {
         MemberDef *md = m_memberDef->reimplements();
-        m_cache.reimplements.reset(new TemplateList);
+        m_cache->reimplements.reset(new TemplateList);
         if (md)
         {
           ClassDef *cd = md->getClassDef();
           if (cd && md->virtualness()!=Pure && cd->compoundType()!=ClassDef::Interface)
           {
             MemberContext *mc = new MemberContext(md);
-            m_cache.reimplementsMember.reset(mc);
-            m_cache.reimplements->append(mc);
+            m_cache->reimplementsMember.reset(mc);
+            m_cache->reimplements->append(mc);
           }
         }
       }
-      return m_cache.reimplements.get();
+      return m_cache->reimplements.get();
     }
     TemplateVariant implementedBy() const
     {
-      if (!m_cache.implementedBy)
+      if (!m_cache->implementedBy)
       {
         MemberList *ml = m_memberDef->reimplementedBy();
-        m_cache.implementedBy.reset(new TemplateList);
+        m_cache->implementedBy.reset(new TemplateList);
         if (ml)
         {
           MemberListIterator mli(*ml);
@@ -2642,19 +2796,19 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
             if (cd && (md->virtualness()==Pure || cd->compoundType()==ClassDef::Interface))
             {
               MemberContext *mc = new MemberContext(md);
-              m_cache.implementedByMembers.append(mc);
-              m_cache.implementedBy->append(mc);
+              m_cache->implementedByMembers.append(mc);
+              m_cache->implementedBy->append(mc);
             }
           }
         }
       }
-      return m_cache.implementedBy.get();
+      return m_cache->implementedBy.get();
     }
     TemplateVariant reimplementedBy() const
     {
-      if (!m_cache.reimplementedBy)
+      if (!m_cache->reimplementedBy)
       {
-        m_cache.reimplementedBy.reset(new TemplateList);
+        m_cache->reimplementedBy.reset(new TemplateList);
         MemberList *ml = m_memberDef->reimplementedBy();
         if (ml)
         {
@@ -2666,13 +2820,13 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
             if (cd && md->virtualness()!=Pure && cd->compoundType()!=ClassDef::Interface)
             {
               MemberContext *mc = new MemberContext(md);
-              m_cache.reimplementedByMembers.append(mc);
-              m_cache.reimplementedBy->append(mc);
+              m_cache->reimplementedByMembers.append(mc);
+              m_cache->reimplementedBy->append(mc);
             }
           }
         }
       }
-      return m_cache.reimplementedBy.get();
+      return m_cache->reimplementedBy.get();
     }
     void addExamples(TemplateList *list) const
     {
@@ -2683,7 +2837,7 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
         for (it.toFirst();(ex=it.current());++it)
         {
           TemplateStruct *s = new TemplateStruct;
-          m_cache.exampleList.append(s);
+          m_cache->exampleList.append(s);
           s->set("text",ex->name);
           s->set("isLinkable",TRUE);
           s->set("anchor",ex->anchor);
@@ -2694,25 +2848,25 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant examples() const
     {
-      if (!m_cache.examples)
+      if (!m_cache->examples)
       {
         TemplateList *exampleList = new TemplateList;
         addExamples(exampleList);
-        m_cache.examples.reset(exampleList);
+        m_cache->examples.reset(exampleList);
       }
-      return m_cache.examples.get();
+      return m_cache->examples.get();
     }
     TemplateVariant typeConstraints() const
     {
-      if (!m_cache.typeConstraints && m_memberDef->typeConstraints())
+      if (!m_cache->typeConstraints && m_memberDef->typeConstraints())
       {
-        m_cache.typeConstraints.reset(new ArgumentListContext(m_memberDef->typeConstraints(),m_memberDef,relPathAsString()));
+        m_cache->typeConstraints.reset(new ArgumentListContext(m_memberDef->typeConstraints(),m_memberDef,relPathAsString()));
       }
       else
       {
-        m_cache.typeConstraints.reset(new ArgumentListContext);
+        m_cache->typeConstraints.reset(new ArgumentListContext);
       }
-      return m_cache.typeConstraints.get();
+      return m_cache->typeConstraints.get();
     }
     TemplateVariant functionQualifier() const
     {
@@ -2731,19 +2885,19 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant sourceRefs() const
     {
-      if (!m_cache.sourceRefs)
+      if (!m_cache->sourceRefs)
       {
-        m_cache.sourceRefs.reset(new MemberListContext(m_memberDef->getReferencesMembers(),TRUE));
+        m_cache->sourceRefs.reset(new MemberListContext(m_memberDef->getReferencesMembers(),TRUE));
       }
-      return m_cache.sourceRefs.get();
+      return m_cache->sourceRefs.get();
     }
     TemplateVariant sourceRefBys() const
     {
-      if (!m_cache.sourceRefBys)
+      if (!m_cache->sourceRefBys)
       {
-        m_cache.sourceRefBys.reset(new MemberListContext(m_memberDef->getReferencedByMembers(),TRUE));
+        m_cache->sourceRefBys.reset(new MemberListContext(m_memberDef->getReferencedByMembers(),TRUE));
       }
-      return m_cache.sourceRefBys.get();
+      return m_cache->sourceRefBys.get();
     }
     TemplateVariant hasSources() const
     {
@@ -2751,7 +2905,7 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     TemplateVariant sourceCode() const
     {
-      if (!m_cache.sourceCodeParsed)
+      if (!m_cache->sourceCodeParsed)
       {
         QCString codeFragment;
         FileDef *fd   = m_memberDef->getBodyDef();
@@ -2770,19 +2924,19 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
           {
             scopeName = m_memberDef->getNamespaceDef()->name();
           }
-          m_cache.sourceCode = parseCode(m_memberDef,scopeName,relPathAsString(),codeFragment,startLine,endLine,TRUE);
-          m_cache.sourceCodeParsed = TRUE;
+          m_cache->sourceCode = parseCode(m_memberDef,scopeName,relPathAsString(),codeFragment,startLine,endLine,TRUE);
+          m_cache->sourceCodeParsed = TRUE;
         }
       }
-      return m_cache.sourceCode;
+      return m_cache->sourceCode;
     }
     DotCallGraph *getCallGraph() const
     {
-      if (!m_cache.callGraph)
+      if (!m_cache->callGraph)
       {
-        m_cache.callGraph.reset(new DotCallGraph(m_memberDef,FALSE));
+        m_cache->callGraph.reset(new DotCallGraph(m_memberDef,FALSE));
       }
-      return m_cache.callGraph.get();
+      return m_cache->callGraph.get();
     }
     TemplateVariant hasCallGraph() const
     {
@@ -2818,11 +2972,11 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
     }
     DotCallGraph *getCallerGraph() const
     {
-      if (!m_cache.callerGraph)
+      if (!m_cache->callerGraph)
       {
-        m_cache.callerGraph.reset(new DotCallGraph(m_memberDef,TRUE));
+        m_cache->callerGraph.reset(new DotCallGraph(m_memberDef,TRUE));
       }
-      return m_cache.callerGraph.get();
+      return m_cache->callerGraph.get();
     }
     TemplateVariant hasCallerGraph() const
     {
@@ -2897,7 +3051,7 @@ class MemberContext::Private : public DefinitionContext<MemberContext::Private>
       QList<TemplateStruct>          exampleList;
       ScopedPtr<ArgumentListContext> typeConstraints;
     };
-    mutable Cachable m_cache;
+    mutable ContextCache<Cachable> m_cache;
     TemplateList m_propertyAttrs;
     TemplateList m_eventAttrs;
 };
@@ -2928,9 +3082,14 @@ class ModuleContext::Private : public DefinitionContext<ModuleContext::Private>
   public:
     Private(GroupDef *gd) : DefinitionContext<ModuleContext::Private>(gd) , m_groupDef(gd)
     {
-      addProperty("title",this,&Private::title);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subHighlight);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("title",&Private::title);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subHighlight);
+        init=TRUE;
+      }
     }
     TemplateVariant title() const
     {
@@ -3064,17 +3223,22 @@ TemplateListIntf::ConstIterator *ClassListContext::createIterator() const
 
 //%% struct ClassInheritanceNode: node in inheritance tree
 //%% {
-class ClassInheritanceNodeContext::Private : public PropertyMapper
+class ClassInheritanceNodeContext::Private : public PropertyMapper<ClassInheritanceNodeContext::Private>
 {
   public:
-    Private(ClassDef *cd) : m_classContext(cd)
+    Private(ClassDef *cd) : m_classDef(cd)
     {
-      //%% bool is_leaf_node: true if this node does not have any children
-      addProperty("is_leaf_node",this,&Private::isLeafNode);
-      //%% ClassInheritance children: list of nested classes/namespaces
-      addProperty("children",this,&Private::children);
-      //%% Class class: class info
-      addProperty("class",this,&Private::getClass);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% bool is_leaf_node: true if this node does not have any children
+        addProperty("is_leaf_node",&Private::isLeafNode);
+        //%% ClassInheritance children: list of nested classes/namespaces
+        addProperty("children",&Private::children);
+        //%% Class class: class info
+        addProperty("class",&Private::getClass);
+        init=TRUE;
+      }
     }
     void addChildren(const BaseClassList *bcl,bool hideSuper)
     {
@@ -3131,11 +3295,20 @@ class ClassInheritanceNodeContext::Private : public PropertyMapper
     }
     TemplateVariant getClass() const
     {
-      return TemplateVariant(&m_classContext);
+      if (!m_cache.classContext)
+      {
+        m_cache.classContext.reset(new ClassContext(m_classDef));
+      }
+      return m_cache.classContext.get();
     }
   private:
     GenericNodeListContext<ClassInheritanceNodeContext> m_children;
-    ClassContext m_classContext;
+    ClassDef *m_classDef;
+    struct Cachable
+    {
+      ScopedPtr<ClassContext> classContext;
+    };
+    mutable Cachable m_cache;
 };
 //%% }
 
@@ -3248,7 +3421,7 @@ TemplateListIntf::ConstIterator *ClassInheritanceContext::createIterator() const
 
 //%% struct ClassHierarchy: inheritance tree
 //%% {
-class ClassHierarchyContext::Private : public PropertyMapper
+class ClassHierarchyContext::Private : public PropertyMapper<ClassHierarchyContext::Private>
 {
   public:
     TemplateVariant tree() const
@@ -3285,13 +3458,18 @@ class ClassHierarchyContext::Private : public PropertyMapper
     }
     Private()
     {
-      //%% ClassInheritance tree
-      addProperty("tree",this,&Private::tree);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% ClassInheritance tree
+        addProperty("tree",&Private::tree);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     ClassInheritanceContext m_classTree;
@@ -3317,37 +3495,42 @@ TemplateVariant ClassHierarchyContext::get(const char *name) const
 
 //%% struct NestingNode: node is a nesting relation tree
 //%% {
-class NestingNodeContext::Private : public PropertyMapper
+class NestingNodeContext::Private : public PropertyMapper<NestingNodeContext::Private>
 {
   public:
-    Private(Definition *d,bool addCls) : m_def(d),
-       m_classContext(m_def->definitionType()==Definition::TypeClass?(ClassDef*)d:0),
-       m_namespaceContext(m_def->definitionType()==Definition::TypeNamespace?(NamespaceDef*)d:0)
-    {
-      //%% bool is_leaf_node: true if this node does not have any children
-      addProperty("is_leaf_node",this,&Private::isLeafNode);
-      //%% Nesting children: list of nested classes/namespaces
-      addProperty("children",this,&Private::children);
-      //%% [optional] Class class: class info (if this node represents a class)
-      addProperty("class",this,&Private::getClass);
-      //%% [optional] Namespace namespace: namespace info (if this node represents a namespace)
-      addProperty("namespace",this,&Private::getNamespace);
-      addNamespaces(addCls);
-      addClasses();
+    Private(Definition *d,bool addCls) : m_def(d), m_addClasses(addCls)
+    {
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% bool is_leaf_node: true if this node does not have any children
+        addProperty("is_leaf_node",&Private::isLeafNode);
+        //%% Nesting children: list of nested classes/namespaces
+        addProperty("children",&Private::children);
+        //%% [optional] Class class: class info (if this node represents a class)
+        addProperty("class",&Private::getClass);
+        //%% [optional] Namespace namespace: namespace info (if this node represents a namespace)
+        addProperty("namespace",&Private::getNamespace);
+        init=TRUE;
+      }
     }
     TemplateVariant isLeafNode() const
     {
-      return m_children.count()==0;
+      return getChildren()->count()==0;
     }
     TemplateVariant children() const
     {
-      return TemplateVariant(&m_children);
+      return TemplateVariant(getChildren());
     }
     TemplateVariant getClass() const
     {
       if (m_def->definitionType()==Definition::TypeClass)
       {
-        return TemplateVariant(&m_classContext);
+        if (!m_cache.classContext)
+        {
+          m_cache.classContext.reset(new ClassContext((ClassDef*)m_def));
+        }
+        return m_cache.classContext.get();
       }
       else
       {
@@ -3358,38 +3541,59 @@ class NestingNodeContext::Private : public PropertyMapper
     {
       if (m_def->definitionType()==Definition::TypeNamespace)
       {
-        return TemplateVariant(&m_namespaceContext);
+        if (!m_cache.namespaceContext)
+        {
+          m_cache.namespaceContext.reset(new NamespaceContext((NamespaceDef*)m_def));
+        }
+        return m_cache.namespaceContext.get();
       }
       else
       {
         return TemplateVariant(FALSE);
       }
     }
-    void addClasses()
+    NestingContext *getChildren() const
+    {
+      // the tree is only expanded for the nodes that are visited
+      if (!m_cache.children)
+      {
+        NestingContext *children = new NestingContext;
+        addNamespaces(children,m_addClasses);
+        addClasses(children);
+        m_cache.children.reset(children);
+      }
+      return m_cache.children.get();
+    }
+    void addClasses(NestingContext *children) const
     {
       ClassDef *cd = m_def->definitionType()==Definition::TypeClass ? (ClassDef*)m_def : 0;
       if (cd && cd->getClassSDict())
       {
-        m_children.addClasses(*cd->getClassSDict(),FALSE);
+        children->addClasses(*cd->getClassSDict(),FALSE);
       }
     }
-    void addNamespaces(bool addClasses)
+    void addNamespaces(NestingContext *children,bool addClasses) const
     {
       NamespaceDef *nd = m_def->definitionType()==Definition::TypeNamespace ? (NamespaceDef*)m_def : 0;
       if (nd && nd->getNamespaceSDict())
       {
-        m_children.addNamespaces(*nd->getNamespaceSDict(),FALSE,addClasses);
+        children->addNamespaces(*nd->getNamespaceSDict(),FALSE,addClasses);
       }
       if (addClasses && nd && nd->getClassSDict())
       {
-        m_children.addClasses(*nd->getClassSDict(),FALSE);
+        children->addClasses(*nd->getClassSDict(),FALSE);
       }
     }
     Definition *m_def;
   private:
-    NestingContext m_children;
-    ClassContext m_classContext;
-    NamespaceContext m_namespaceContext;
+    bool m_addClasses;
+    struct Cachable
+    {
+      ScopedPtr<NestingContext>   children;
+      ScopedPtr<ClassContext>     classContext;
+      ScopedPtr<NamespaceContext> namespaceContext;
+    };
+    mutable Cachable m_cache;
 };
 //%% }
 
@@ -3503,7 +3707,7 @@ void NestingContext::addNamespaces(const NamespaceSDict &nsDict,bool rootOnly,bo
 
 //%% struct ClassTree: Class nesting relations
 //%% {
-class ClassTreeContext::Private : public PropertyMapper
+class ClassTreeContext::Private : public PropertyMapper<ClassTreeContext::Private>
 {
   public:
     TemplateVariant tree() const
@@ -3553,13 +3757,18 @@ class ClassTreeContext::Private : public PropertyMapper
       {
         m_classTree.addClasses(*Doxygen::classSDict,TRUE);
       }
-      //%% Nesting tree
-      addProperty("tree",this,&Private::tree);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% Nesting tree
+        addProperty("tree",&Private::tree);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     NestingContext m_classTree;
@@ -3632,7 +3841,7 @@ TemplateListIntf::ConstIterator *NamespaceListContext::createIterator() const
 
 //%% struct NamespaceTree: tree of nested namespace
 //%% {
-class NamespaceTreeContext::Private : public PropertyMapper
+class NamespaceTreeContext::Private : public PropertyMapper<NamespaceTreeContext::Private>
 {
   public:
     TemplateVariant tree() const
@@ -3679,13 +3888,18 @@ class NamespaceTreeContext::Private : public PropertyMapper
       {
         m_namespaceTree.addNamespaces(*Doxygen::namespaceSDict,TRUE,FALSE);
       }
-      //%% Nesting tree
-      addProperty("tree",this,&Private::tree);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% Nesting tree
+        addProperty("tree",&Private::tree);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     NestingContext m_namespaceTree;
@@ -3820,36 +4034,42 @@ void UsedFilesContext::addFile(FileDef *fd)
 
 //%% struct DirFileNode: node is a directory hierarchy
 //%% {
-class DirFileNodeContext::Private : public PropertyMapper
+class DirFileNodeContext::Private : public PropertyMapper<DirFileNodeContext::Private>
 {
   public:
-    Private(Definition *d) : m_def(d),
-       m_dirContext (m_def->definitionType()==Definition::TypeDir  ? (DirDef*)d  : 0),
-       m_fileContext(m_def->definitionType()==Definition::TypeFile ? (FileDef*)d : 0)
-    {
-      //%% bool is_leaf_node: true if this node does not have any children
-      addProperty("is_leaf_node",this,&Private::isLeafNode);
-      //%% DirFile children: list of nested classes/namespaces
-      addProperty("children",this,&Private::children);
-      //%% [optional] Dir dir: directory info (if this node represents a directory)
-      addProperty("dir",this,&Private::getDir);
-      //%% [optional] File file: file info (if this node represents a file)
-      addProperty("file",this,&Private::getFile);
-      addDirFiles();
+    Private(Definition *d) : m_def(d)
+    {
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% bool is_leaf_node: true if this node does not have any children
+        addProperty("is_leaf_node",&Private::isLeafNode);
+        //%% DirFile children: list of nested classes/namespaces
+        addProperty("children",&Private::children);
+        //%% [optional] Dir dir: directory info (if this node represents a directory)
+        addProperty("dir",&Private::getDir);
+        //%% [optional] File file: file info (if this node represents a file)
+        addProperty("file",&Private::getFile);
+        init=TRUE;
+      }
     }
     TemplateVariant isLeafNode() const
     {
-      return m_children.count()==0;
+      return getChildren()->count()==0;
     }
     TemplateVariant children() const
     {
-      return TemplateVariant(&m_children);
+      return TemplateVariant(getChildren());
     }
     TemplateVariant getDir() const
     {
       if (m_def->definitionType()==Definition::TypeDir)
       {
-        return TemplateVariant(&m_dirContext);
+        if (!m_cache.dirContext)
+        {
+          m_cache.dirContext.reset(new DirContext((DirDef*)m_def));
+        }
+        return m_cache.dirContext.get();
       }
       else
       {
@@ -3860,30 +4080,44 @@ class DirFileNodeContext::Private : public PropertyMapper
     {
       if (m_def->definitionType()==Definition::TypeFile)
       {
-        return TemplateVariant(&m_fileContext);
+        if (!m_cache.fileContext)
+        {
+          m_cache.fileContext.reset(new FileContext((FileDef*)m_def));
+        }
+        return m_cache.fileContext.get();
       }
       else
       {
         return TemplateVariant(FALSE);
       }
     }
-    void addDirFiles()
+    DirFileContext *getChildren() const
     {
-      DirDef *dd = m_def->definitionType()==Definition::TypeDir ? (DirDef*)m_def : 0;
-      if (dd)
+      if (!m_cache.children)
       {
-        m_children.addDirs(dd->subDirs());
-        if (dd && dd->getFiles())
+        DirFileContext *children = new DirFileContext;
+        DirDef *dd = m_def->definitionType()==Definition::TypeDir ? (DirDef*)m_def : 0;
+        if (dd)
         {
-          m_children.addFiles(*dd->getFiles());
+          children->addDirs(dd->subDirs());
+          if (dd->getFiles())
+          {
+            children->addFiles(*dd->getFiles());
+          }
         }
+        m_cache.children.reset(children);
       }
+      return m_cache.children.get();
     }
   private:
     Definition *m_def;
-    DirFileContext m_children;
-    DirContext m_dirContext;
-    FileContext m_fileContext;
+    struct Cachable
+    {
+      ScopedPtr<DirFileContext> children;
+      ScopedPtr<DirContext>     dirContext;
+      ScopedPtr<FileContext>    fileContext;
+    };
+    mutable Cachable m_cache;
 };
 //%% }
 
@@ -4009,7 +4243,7 @@ void DirFileContext::addFiles(const FileList &files)
 
 //%% struct FileTree: tree of directories and files
 //%% {
-class FileTreeContext::Private : public PropertyMapper
+class FileTreeContext::Private : public PropertyMapper<FileTreeContext::Private>
 {
   public:
     TemplateVariant tree() const
@@ -4047,13 +4281,18 @@ class FileTreeContext::Private : public PropertyMapper
       {
         m_dirFileTree.addFiles(*Doxygen::inputNameList);
       }
-      //%% DirFile tree:
-      addProperty("tree",this,&Private::tree);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% DirFile tree:
+        addProperty("tree",&Private::tree);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     DirFileContext m_dirFileTree;
@@ -4079,42 +4318,60 @@ TemplateVariant FileTreeContext::get(const char *name) const
 
 //%% struct PageNode: node is a directory hierarchy
 //%% {
-class PageNodeContext::Private : public PropertyMapper
+class PageNodeContext::Private : public PropertyMapper<PageNodeContext::Private>
 {
   public:
-    Private(PageDef *pd) : m_pageDef(pd), m_pageContext(pd)
+    Private(PageDef *pd) : m_pageDef(pd)
     {
-      //%% bool is_leaf_node: true if this node does not have any children
-      addProperty("is_leaf_node",this,&Private::isLeafNode);
-      //%% PageList children: list of nested classes/namespaces
-      addProperty("children",this,&Private::children);
-      //%% Page page: page info
-      addProperty("page",this,&Private::getPage);
-      addPages();
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% bool is_leaf_node: true if this node does not have any children
+        addProperty("is_leaf_node",&Private::isLeafNode);
+        //%% PageList children: list of nested classes/namespaces
+        addProperty("children",&Private::children);
+        //%% Page page: page info
+        addProperty("page",&Private::getPage);
+        init=TRUE;
+      }
     }
     TemplateVariant isLeafNode() const
     {
-      return m_children.count()==0;
+      return getChildren()->count()==0;
     }
     TemplateVariant children() const
     {
-      return TemplateVariant(&m_children);
+      return TemplateVariant(getChildren());
     }
     TemplateVariant getPage() const
     {
-      return TemplateVariant(&m_pageContext);
+      if (!m_cache.pageContext)
+      {
+        m_cache.pageContext.reset(new PageContext(m_pageDef));
+      }
+      return m_cache.pageContext.get();
     }
-    void addPages()
+    PageNodeListContext *getChildren() const
     {
-      if (m_pageDef->getSubPages())
+      if (!m_cache.children)
       {
-        m_children.addPages(*m_pageDef->getSubPages(),FALSE);
+        PageNodeListContext *children = new PageNodeListContext;
+        if (m_pageDef->getSubPages())
+        {
+          children->addPages(*m_pageDef->getSubPages(),FALSE);
+        }
+        m_cache.children.reset(children);
       }
+      return m_cache.children.get();
     }
   private:
     PageDef *m_pageDef;
-    PageNodeListContext m_children;
-    PageContext m_pageContext;
+    struct Cachable
+    {
+      ScopedPtr<PageNodeListContext> children;
+      ScopedPtr<PageContext>         pageContext;
+    };
+    mutable Cachable m_cache;
 };
 //%% }
 
@@ -4190,7 +4447,7 @@ void PageNodeListContext::addPages(const PageSDict &pages,bool rootOnly)
 
 //%% struct PageTree: tree of related pages
 //%% {
-class PageTreeContext::Private : public PropertyMapper
+class PageTreeContext::Private : public PropertyMapper<PageTreeContext::Private>
 {
   public:
     TemplateVariant tree() const
@@ -4225,13 +4482,18 @@ class PageTreeContext::Private : public PropertyMapper
         m_pageList.addPages(*Doxygen::pageSDict,TRUE);
       }
 
-      //%% PageNodeList tree:
-      addProperty("tree",this,&Private::tree);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% PageNodeList tree:
+        addProperty("tree",&Private::tree);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     PageNodeListContext m_pageList;
@@ -4257,7 +4519,7 @@ TemplateVariant PageTreeContext::get(const char *name) const
 
 //%% struct PageList: list of related pages
 //%% {
-class PageListContext::Private : public PropertyMapper
+class PageListContext::Private : public PropertyMapper<PageListContext::Private>
 {
   public:
     TemplateVariant items() const
@@ -4297,13 +4559,18 @@ class PageListContext::Private : public PropertyMapper
         }
       }
 
-      //%% list[Page] items:
-      addProperty("items",this,&Private::items);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% list[Page] items:
+        addProperty("items",&Private::items);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     GenericNodeListContext<PageContext> m_pageList;
@@ -4330,42 +4597,60 @@ TemplateVariant PageListContext::get(const char *name) const
 
 //%% struct ModuleNode: node is a directory hierarchy
 //%% {
-class ModuleNodeContext::Private : public PropertyMapper
+class ModuleNodeContext::Private : public PropertyMapper<ModuleNodeContext::Private>
 {
   public:
-    Private(GroupDef *gd) : m_groupDef(gd), m_moduleContext(gd)
+    Private(GroupDef *gd) : m_groupDef(gd)
     {
-      //%% bool is_leaf_node: true if this node does not have any children
-      addProperty("is_leaf_node",this,&Private::isLeafNode);
-      //%% ModuleList children: list of submodules
-      addProperty("children",this,&Private::children);
-      //%% Module module: module info
-      addProperty("module",this,&Private::getModule);
-      addModules();
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% bool is_leaf_node: true if this node does not have any children
+        addProperty("is_leaf_node",&Private::isLeafNode);
+        //%% ModuleList children: list of submodules
+        addProperty("children",&Private::children);
+        //%% Module module: module info
+        addProperty("module",&Private::getModule);
+        init=TRUE;
+      }
     }
     TemplateVariant isLeafNode() const
     {
-      return m_children.count()==0;
+      return getChildren()->count()==0;
     }
     TemplateVariant children() const
     {
-      return TemplateVariant(&m_children);
+      return TemplateVariant(getChildren());
     }
     TemplateVariant getModule() const
     {
-      return TemplateVariant(&m_moduleContext);
+      if (!m_cache.moduleContext)
+      {
+        m_cache.moduleContext.reset(new ModuleContext(m_groupDef));
+      }
+      return m_cache.moduleContext.get();
     }
-    void addModules()
+    ModuleListContext *getChildren() const
     {
-      if (m_groupDef->getSubGroups())
+      if (!m_cache.children)
       {
-        m_children.addModules(*m_groupDef->getSubGroups());
+        ModuleListContext *children = new ModuleListContext;
+        if (m_groupDef->getSubGroups())
+        {
+          children->addModules(*m_groupDef->getSubGroups());
+        }
+        m_cache.children.reset(children);
       }
+      return m_cache.children.get();
     }
   private:
     GroupDef *m_groupDef;
-    ModuleListContext m_children;
-    ModuleContext m_moduleContext;
+    struct Cachable
+    {
+      ScopedPtr<ModuleListContext> children;
+      ScopedPtr<ModuleContext>     moduleContext;
+    };
+    mutable Cachable m_cache;
 };
 //%% }
 
@@ -4455,7 +4740,7 @@ void ModuleListContext::addModules(const GroupList &modules)
 
 //%% struct ModuleTree: tree of modules
 //%% {
-class ModuleTreeContext::Private : public PropertyMapper
+class ModuleTreeContext::Private : public PropertyMapper<ModuleTreeContext::Private>
 {
   public:
     TemplateVariant tree() const
@@ -4490,13 +4775,18 @@ class ModuleTreeContext::Private : public PropertyMapper
         m_moduleList.addModules(*Doxygen::groupSDict);
       }
 
-      //%% ModuleList tree:
-      addProperty("tree",this,&Private::tree);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% ModuleList tree:
+        addProperty("tree",&Private::tree);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     ModuleListContext m_moduleList;
@@ -4522,15 +4812,20 @@ TemplateVariant ModuleTreeContext::get(const char *name) const
 
 //%% struct NavPathElem: list of examples page
 //%% {
-class NavPathElemContext::Private : public PropertyMapper
+class NavPathElemContext::Private : public PropertyMapper<NavPathElemContext::Private>
 {
   public:
     Private(Definition *def) : m_def(def)
     {
-      addProperty("isLinkable",this,&Private::isLinkable);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("anchor",this,&Private::anchor);
-      addProperty("text",this,&Private::text);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("isLinkable",&Private::isLinkable);
+        addProperty("fileName",&Private::fileName);
+        addProperty("anchor",&Private::anchor);
+        addProperty("text",&Private::text);
+        init=TRUE;
+      }
     }
     TemplateVariant isLinkable() const
     {
@@ -4590,7 +4885,7 @@ TemplateVariant NavPathElemContext::get(const char *name) const
 
 //%% struct ExampleList: list of examples page
 //%% {
-class ExampleListContext::Private : public PropertyMapper
+class ExampleListContext::Private : public PropertyMapper<ExampleListContext::Private>
 {
   public:
     TemplateVariant items() const
@@ -4625,13 +4920,18 @@ class ExampleListContext::Private : public PropertyMapper
         m_pageList.addPages(*Doxygen::exampleSDict,FALSE);
       }
 
-      //%% PageNodeList items:
-      addProperty("items",this,&Private::items);
-      addProperty("fileName",this,&Private::fileName);
-      addProperty("relPath",this,&Private::relPath);
-      addProperty("highlight",this,&Private::highlight);
-      addProperty("subhighlight",this,&Private::subhighlight);
-      addProperty("title",this,&Private::title);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% PageNodeList items:
+        addProperty("items",&Private::items);
+        addProperty("fileName",&Private::fileName);
+        addProperty("relPath",&Private::relPath);
+        addProperty("highlight",&Private::highlight);
+        addProperty("subhighlight",&Private::subhighlight);
+        addProperty("title",&Private::title);
+        init=TRUE;
+      }
     }
   private:
     PageNodeListContext m_pageList;
@@ -4658,25 +4958,39 @@ TemplateVariant ExampleListContext::get(const char *name) const
 
 //%% struct InheritanceNode: a class in the inheritance list
 //%% {
-class InheritanceNodeContext::Private : public PropertyMapper
+class InheritanceNodeContext::Private : public PropertyMapper<InheritanceNodeContext::Private>
 {
   public:
-    Private(ClassDef *cd,const QCString &name) : m_classContext(cd), m_name(name)
+    Private(ClassDef *cd,const QCString &name) : m_classDef(cd), m_name(name)
     {
-      addProperty("class",this,&Private::getClass);
-      addProperty("name",this,&Private::name);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("class",&Private::getClass);
+        addProperty("name",&Private::name);
+        init=TRUE;
+      }
     }
     TemplateVariant getClass() const
     {
-      return &m_classContext;
+      if (!m_cache.classContext)
+      {
+        m_cache.classContext.reset(new ClassContext(m_classDef));
+      }
+      return m_cache.classContext.get();
     }
     TemplateVariant name() const
     {
       return m_name;
     }
   private:
-    ClassContext m_classContext;
+    ClassDef *m_classDef;
     QCString m_name;
+    struct Cachable
+    {
+      ScopedPtr<ClassContext> classContext;
+    };
+    mutable Cachable m_cache;
 };
 //%% }
 
@@ -4834,19 +5148,24 @@ TemplateListIntf::ConstIterator *MemberListContext::createIterator() const
 
 //%% struct MemberInfo: member information
 //%% {
-class MemberInfoContext::Private : public PropertyMapper
+class MemberInfoContext::Private : public PropertyMapper<MemberInfoContext::Private>
 {
   public:
     Private(const MemberInfo *mi) : m_memberInfo(mi)
     {
-      //%% string protection
-      addProperty("protection",this,&Private::protection);
-      //%% string virtualness
-      addProperty("virtualness",this,&Private::virtualness);
-      //%% string ambiguityScope
-      addProperty("ambiguityScope",this,&Private::ambiguityScope);
-      //%% Member member
-      addProperty("member",this,&Private::member);
+      static bool init=FALSE;
+      if (!init)
+      {
+        //%% string protection
+        addProperty("protection",&Private::protection);
+        //%% string virtualness
+        addProperty("virtualness",&Private::virtualness);
+        //%% string ambiguityScope
+        addProperty("ambiguityScope",&Private::ambiguityScope);
+        //%% Member member
+        addProperty("member",&Private::member);
+        init=TRUE;
+      }
     }
     TemplateVariant protection() const
     {
@@ -4983,7 +5302,7 @@ TemplateListIntf::ConstIterator *AllMembersListContext::createIterator() const
 
 //%% struct MemberGroupInfo: member group information
 //%% {
-class MemberGroupInfoContext::Private : public PropertyMapper
+class MemberGroupInfoContext::Private : public PropertyMapper<MemberGroupInfoContext::Private>
 {
   public:
     Private(Definition *def,const QCString &relPath,const MemberGroup *mg) :
@@ -4992,13 +5311,18 @@ class MemberGroupInfoContext::Private : public PropertyMapper
       m_memberListContext(mg->members()),
       m_memberGroups(def,relPath,0), m_memberGroup(mg)
     {
-      addProperty("members",      this,&Private::members);
-      addProperty("title",        this,&Private::groupTitle);
-      addProperty("subtitle",     this,&Private::groupSubtitle);
-      addProperty("anchor",       this,&Private::groupAnchor);
-      addProperty("memberGroups", this,&Private::memberGroups);
-      addProperty("docs",         this,&Private::docs);
-      addProperty("inherited",    this,&Private::inherited);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("members",      &Private::members);
+        addProperty("title",        &Private::groupTitle);
+        addProperty("subtitle",     &Private::groupSubtitle);
+        addProperty("anchor",       &Private::groupAnchor);
+        addProperty("memberGroups", &Private::memberGroups);
+        addProperty("docs",         &Private::docs);
+        addProperty("inherited",    &Private::inherited);
+        init=TRUE;
+      }
     }
     TemplateVariant members() const
     {
@@ -5143,7 +5467,7 @@ TemplateListIntf::ConstIterator *MemberGroupListContext::createIterator() const
 
 //%% struct MemberListInfo: member list information
 //%% {
-class MemberListInfoContext::Private : public PropertyMapper
+class MemberListInfoContext::Private : public PropertyMapper<MemberListInfoContext::Private>
 {
   public:
     Private(Definition *def,const QCString &relPath,const MemberList *ml,const QCString &title,const QCString &subtitle) :
@@ -5154,12 +5478,17 @@ class MemberListInfoContext::Private : public PropertyMapper
       m_title(title),
       m_subtitle(subtitle)
     {
-      addProperty("members",      this,&Private::members);
-      addProperty("title",        this,&Private::title);
-      addProperty("subtitle",     this,&Private::subtitle);
-      addProperty("anchor",       this,&Private::anchor);
-      addProperty("memberGroups", this,&Private::memberGroups);
-      addProperty("inherited",    this,&Private::inherited);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("members",      &Private::members);
+        addProperty("title",        &Private::title);
+        addProperty("subtitle",     &Private::subtitle);
+        addProperty("anchor",       &Private::anchor);
+        addProperty("memberGroups", &Private::memberGroups);
+        addProperty("inherited",    &Private::inherited);
+        init=TRUE;
+      }
     }
     TemplateVariant members() const
     {
@@ -5231,17 +5560,22 @@ TemplateVariant MemberListInfoContext::get(const char *name) const
 
 //%% struct InheritedMemberInfo: inherited member information
 //%% {
-class InheritedMemberInfoContext::Private : public PropertyMapper
+class InheritedMemberInfoContext::Private : public PropertyMapper<InheritedMemberInfoContext::Private>
 {
   public:
     Private(ClassDef *cd,MemberList *ml,const QCString &title)
       : m_class(cd), m_memberList(ml), m_title(title)
     {
-      addProperty("class",         this,&Private::getClass);
-      addProperty("title",         this,&Private::title);
-      addProperty("members",       this,&Private::members);
-      addProperty("id",            this,&Private::id);
-      addProperty("inheritedFrom", this,&Private::inheritedFrom);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("class",         &Private::getClass);
+        addProperty("title",         &Private::title);
+        addProperty("members",       &Private::members);
+        addProperty("id",            &Private::id);
+        addProperty("inheritedFrom", &Private::inheritedFrom);
+        init=TRUE;
+      }
     }
     ~Private()
     {
@@ -5468,19 +5802,24 @@ TemplateListIntf::ConstIterator *InheritedMemberInfoListContext::createIterator(
 
 //%% struct Argument: parameter information
 //%% {
-class ArgumentContext::Private : public PropertyMapper
+class ArgumentContext::Private : public PropertyMapper<ArgumentContext::Private>
 {
   public:
     Private(const Argument *arg,Definition *def,const QCString &relPath) :
       m_argument(arg), m_def(def), m_relPath(relPath)
     {
-      addProperty("type",     this,&Private::type);
-      addProperty("name",     this,&Private::name);
-      addProperty("defVal",   this,&Private::defVal);
-      addProperty("docs",     this,&Private::docs);
-      addProperty("attrib",   this,&Private::attrib);
-      addProperty("array",    this,&Private::array);
-      addProperty("namePart", this,&Private::namePart);
+      static bool init=FALSE;
+      if (!init)
+      {
+        addProperty("type",     &Private::type);
+        addProperty("name",     &Private::name);
+        addProperty("defVal",   &Private::defVal);
+        addProperty("docs",     &Private::docs);
+        addProperty("attrib",   &Private::attrib);
+        addProperty("array",    &Private::array);
+        addProperty("namePart", &Private::namePart);
+        init=TRUE;
+      }
     }
     TemplateVariant type() const
     {
@@ -5754,6 +6093,8 @@ void generateOutputViaTemplate()
       ctx->setEscapeIntf(&esc);
       HtmlSpaceless spl;
       ctx->setSpacelessIntf(&spl);
+      ContextCacheReleaser ccr;
+      ctx->setCreateIntf(&ccr);
       ctx->setOutputDirectory(g_globals.outputDir);
       FTextStream ts;
       tpl->render(ts,ctx);
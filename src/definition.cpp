@@ -17,6 +17,9 @@
 
 #include <ctype.h>
 #include <qregexp.h>
+#include <qcache.h>
+#include <qmutex.h>
+#include <qfileinfo.h>
 #include "md5.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -41,6 +44,7 @@
 #include "namespacedef.h"
 #include "filedef.h"
 #include "dirdef.h"
+#include "bufstr.h"
 
 #define START_MARKER 0x4445465B // DEF[
 #define END_MARKER   0x4445465D // DEF]
@@ -112,11 +116,12 @@ DefinitionImpl::~DefinitionImpl()
 
 void DefinitionImpl::init(const char *df, const char *n)
 {
-  defFileName = df;
+  // many definitions share the same file name, so store it only once
+  defFileName = QCString(df).intern();
   int lastDot = defFileName.findRev('.');
   if (lastDot!=-1)
   {
-    defFileExt = defFileName.mid(lastDot);
+    defFileExt = defFileName.mid(lastDot).intern();
   }
   QCString name = n;
   if (name!="<globalScope>") 
@@ -710,6 +715,123 @@ void Definition::setInbodyDocumentation(const char *d,const char *inbodyFile,int
   _setInbodyDocumentation(d,inbodyFile,inbodyLine);
 }
 
+//-----------------------------------------------------------------------------------------
+
+// maximum number of bytes of source files kept in memory by readCodeFragment()
+#define CODE_FRAGMENT_CACHE_SIZE (16*1024*1024)
+
+/** Contents of a source file as read by readCodeFragment(), with the
+ *  offsets at which the lines start. */
+struct CodeFragmentFile
+{
+  CodeFragmentFile(int size) : contents(size), lineStarts(0), numLines(0) {}
+ ~CodeFragmentFile() { delete[] lineStarts; }
+  BufStr contents;
+  int   *lineStarts;  // lineStarts[i] is the offset of line i+1
+  int    numLines;
+};
+
+/** Reads characters from a CodeFragmentFile, with the same end of file
+ *  behavior as fgetc() and fgets(). */
+class CodeFragmentReader
+{
+  public:
+    CodeFragmentReader(const CodeFragmentFile *f,int pos)
+      : m_data(f->contents.data()), m_size(f->contents.curPos()),
+        m_pos(pos), m_eof(FALSE) {}
+    int getc()
+    {
+      if (m_pos<m_size) return (uchar)m_data[m_pos++];
+      m_eof=TRUE;
+      return EOF;
+    }
+    // appends the rest of the current line, including the newline, to result
+    void readLine(QCString &result)
+    {
+      int start=m_pos;
+      while (m_pos<m_size && m_data[m_pos++]!='\n') /* skip */;
+      if (m_pos==m_size && (m_pos==start || m_data[m_pos-1]!='\n')) m_eof=TRUE;
+      if (m_pos>start) result+=QCString(m_data+start,m_pos-start);
+    }
+    bool eof() const { return m_eof; }
+  private:
+    const char *m_data;
+    int m_size;
+    int m_pos;
+    bool m_eof;
+};
+
+static QCache<CodeFragmentFile> g_codeFragmentCache(CODE_FRAGMENT_CACHE_SIZE);
+static QMutex g_codeFragmentMutex;
+
+/** Reads the contents of \a fileName, through the filter for source files
+ *  if there is one. The result is cached, so a file is read and filtered
+ *  only once. g_codeFragmentMutex must be locked. Returns 0 if the file
+ *  could not be read.
+ */
+static const CodeFragmentFile *readCodeFragmentFile(const char *fileName)
+{
+  static bool filterSourceFiles = Config_getBool("FILTER_SOURCE_FILES");
+  g_codeFragmentCache.setAutoDelete(TRUE);
+  CodeFragmentFile *cf = g_codeFragmentCache.find(fileName);
+  if (cf) return cf;
+
+  QCString filter = getFileFilter(fileName,TRUE);
+  bool usePipe = !filter.isEmpty() && filterSourceFiles;
+  FILE *f=0;
+  if (!usePipe) // no filter given or wanted
+  {
+    f = portable_fopen(fileName,"r");
+  }
+  else // use filter
+  {
+    QCString cmd=filter+" \""+fileName+"\"";
+    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",cmd.data());
+    f = portable_popen(cmd,"r");
+  }
+  if (f==0) return 0;
+
+  cf = new CodeFragmentFile(QFileInfo(fileName).size()+1);
+  const int bufSize=4096;
+  char buf[bufSize];
+  int numRead;
+  while ((numRead=(int)fread(buf,1,bufSize,f))>0)
+  {
+    cf->contents.addArray(buf,numRead);
+  }
+  if (usePipe)
+  {
+    portable_pclose(f);
+    cf->contents.at(cf->contents.curPos())='\0';
+    Debug::print(Debug::FilterOutput, 0, "Filter output\n");
+    Debug::print(Debug::FilterOutput,0,"-------------\n%s\n-------------\n",
+                 cf->contents.data());
+  }
+  else
+  {
+    fclose(f);
+  }
+
+  // index the start of each line
+  const char *p = cf->contents.data();
+  int size = cf->contents.curPos();
+  int i,n=1;
+  for (i=0;i<size;i++) if (p[i]=='\n') n++;
+  cf->lineStarts = new int[n];
+  cf->lineStarts[0] = 0;
+  for (i=0,n=1;i<size;i++) if (p[i]=='\n') cf->lineStarts[n++]=i+1;
+  cf->numLines = n;
+
+  // a file larger than the cache replaces all others
+  int cost = QMAX(1,QMIN(size,CODE_FRAGMENT_CACHE_SIZE));
+  if (!g_codeFragmentCache.insert(fileName,cf,cost))
+  {
+    delete cf;
+    return 0;
+  }
+  return cf;
+}
+
 /*! Reads a fragment of code from file \a fileName starting at 
  * line \a startLine and ending at line \a endLine (inclusive). The fragment is
  * stored in \a result. If FALSE is returned the code fragment could not be
@@ -724,48 +846,34 @@ void Definition::setInbodyDocumentation(const char *d,const char *inbodyFile,int
 bool readCodeFragment(const char *fileName,
                       int &startLine,int &endLine,QCString &result)
 {
-  static bool filterSourceFiles = Config_getBool("FILTER_SOURCE_FILES");
   static int tabSize = Config_getInt("TAB_SIZE");
   //printf("readCodeFragment(%s,%d,%d)\n",fileName,startLine,endLine);
   if (fileName==0 || fileName[0]==0) return FALSE; // not a valid file name
-  QCString filter = getFileFilter(fileName,TRUE);
-  FILE *f=0;
-  bool usePipe = !filter.isEmpty() && filterSourceFiles;
   SrcLangExt lang = getLanguageFromFileName(fileName);
-  if (!usePipe) // no filter given or wanted
-  {
-    f = portable_fopen(fileName,"r");
-  }
-  else // use filter
-  {
-    QCString cmd=filter+" \""+fileName+"\"";
-    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",cmd.data());
-    f = portable_popen(cmd,"r");
-  }
   bool found = lang==SrcLangExt_VHDL   || 
                lang==SrcLangExt_Tcl    || 
                lang==SrcLangExt_Python || 
                lang==SrcLangExt_Fortran;  
                // for VHDL, TCL, Python, and Fortran no bracket search is possible
-  if (f)
+  QMutexLocker locker(&g_codeFragmentMutex);
+  const CodeFragmentFile *cf = readCodeFragmentFile(fileName);
+  if (cf)
   {
-    int c=0;
     int col=0;
-    int lineNr=1;
+    int lineNr=QMAX(1,startLine);
+    int c=lineNr>1 ? '\n' : 0; // last character before startLine
     // skip until the startLine has reached
-    while (lineNr<startLine && !feof(f))
-    {
-      while ((c=fgetc(f))!='\n' && c!=EOF) /* skip */;
-      lineNr++; 
-    }
-    if (!feof(f))
+    CodeFragmentReader f(cf,lineNr<=cf->numLines ? cf->lineStarts[lineNr-1] :
+                                                   cf->contents.curPos());
+    if (lineNr>cf->numLines) f.getc(); // past the end of the file
+    if (!f.eof())
     {
       // skip until the opening bracket or lonely : is found
       char cn=0;
-      while (lineNr<=endLine && !feof(f) && !found)
+      while (lineNr<=endLine && !f.eof() && !found)
       {
         int pc=0;
-        while ((c=fgetc(f))!='{' && c!=':' && c!=EOF) 
+        while ((c=f.getc())!='{' && c!=':' && c!=EOF) 
         {
           //printf("parsing char `%c'\n",c);
           if (c=='\n') 
@@ -778,12 +886,12 @@ bool readCodeFragment(const char *fileName,
           }
           else if (pc=='/' && c=='/') // skip single line comment
           {
-            while ((c=fgetc(f))!='\n' && c!=EOF) pc=c;
+            while ((c=f.getc())!='\n' && c!=EOF) pc=c;
             if (c=='\n') lineNr++,col=0;
           }
           else if (pc=='/' && c=='*') // skip C style comment
           {
-            while (((c=fgetc(f))!='/' || pc!='*') && c!=EOF) 
+            while (((c=f.getc())!='/' || pc!='*') && c!=EOF) 
             {
               if (c=='\n') lineNr++,col=0;
               pc=c;
@@ -797,7 +905,7 @@ bool readCodeFragment(const char *fileName,
         }
         if (c==':')
         {
-          cn=fgetc(f);
+          cn=f.getc();
           if (cn!=':') found=TRUE;
         }
         else if (c=='{')   // } so vi matching brackets has no problem
@@ -825,31 +933,12 @@ bool readCodeFragment(const char *fileName,
           result+=cn;
           if (cn=='\n') lineNr++;
         }
-        const int maxLineLength=4096;
-        char lineStr[maxLineLength];
         do 
         {
           //printf("reading line %d in range %d-%d\n",lineNr,startLine,endLine);
-          int size_read;
-          do 
-          {
-            // read up to maxLineLength-1 bytes, the last byte being zero
-            char *p = fgets(lineStr, maxLineLength,f);
-            //printf("  read %s",p);
-            if (p) 
-            {
-              size_read=qstrlen(p); 
-            }
-            else  // nothing read
-            {
-              size_read=-1;
-              lineStr[0]='\0';
-            }
-            result+=lineStr;
-          } while (size_read == (maxLineLength-1));
-
+          f.readLine(result);
           lineNr++; 
-        } while (lineNr<=endLine && !feof(f));
+        } while (lineNr<=endLine && !f.eof());
 
         // strip stuff after closing bracket
         int newLineIndex = result.findRev('\n');
@@ -861,16 +950,6 @@ bool readCodeFragment(const char *fileName,
         endLine=lineNr-1;
       }
     }
-    if (usePipe) 
-    {
-      portable_pclose(f); 
-      Debug::print(Debug::FilterOutput, 0, "Filter output\n");
-      Debug::print(Debug::FilterOutput,0,"-------------\n%s\n-------------\n",result.data());
-    }
-    else 
-    {
-      fclose(f);
-    }
   }
   result = transcodeCharacterStringToUTF8(result);
   //fprintf(stderr,"readCodeFragement(%d-%d)=%s\n",startLine,endLine,result.data());
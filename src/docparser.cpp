@@ -69,6 +69,106 @@
 
 //---------------------------------------------------------------------------
 
+// granularity of the node sizes in the pool, also the alignment of the nodes
+#define NODE_POOL_GRANULE   16
+// nodes larger than this are left to the general purpose allocator
+#define NODE_POOL_MAX_SIZE  1024
+// size of the blocks from which the nodes are carved
+#define NODE_POOL_BLOCK     65536
+#define NODE_POOL_CLASSES   (NODE_POOL_MAX_SIZE/NODE_POOL_GRANULE+1)
+
+/** @brief Memory pool for the nodes of the document trees.
+ *
+ *  A tree is built for each documentation block and each output format
+ *  and is deleted as soon as it has been visited, so nodes come and go
+ *  at a high rate. The pool carves the nodes out of large blocks and puts
+ *  deleted nodes on a free list per size, from which the next tree takes
+ *  them. The blocks themselves are kept until the program exits, so the
+ *  memory used is bounded by the largest tree.
+ */
+class DocNodePool
+{
+  public:
+    static void *alloc(size_t size)
+    {
+      size_t cls = sizeClass(size);
+      if (cls>=NODE_POOL_CLASSES) return ::operator new(size);
+      FreeNode *n = s_freeList[cls];
+      if (n) // reuse a deleted node
+      {
+        s_freeList[cls] = n->next;
+        return n;
+      }
+      size_t bytes = cls*NODE_POOL_GRANULE;
+      if (s_blockLeft<bytes) // start a new block
+      {
+        // the rest of the old block goes to the free lists
+        while (s_blockLeft>=NODE_POOL_GRANULE)
+        {
+          size_t c = sizeClass(s_blockLeft);
+          if (c>=NODE_POOL_CLASSES) c=NODE_POOL_CLASSES-1;
+          release(s_blockPtr,c);
+          s_blockPtr  += c*NODE_POOL_GRANULE;
+          s_blockLeft -= c*NODE_POOL_GRANULE;
+        }
+        s_blockPtr  = (char *)::operator new(NODE_POOL_BLOCK);
+        s_blockLeft = NODE_POOL_BLOCK;
+      }
+      void *p = s_blockPtr;
+      s_blockPtr  += bytes;
+      s_blockLeft -= bytes;
+      return p;
+    }
+    static void free(void *p,size_t size)
+    {
+      if (p==0) return;
+      size_t cls = sizeClass(size);
+      if (cls>=NODE_POOL_CLASSES)
+      {
+        ::operator delete(p);
+      }
+      else
+      {
+        release(p,cls);
+      }
+    }
+
+  private:
+    struct FreeNode
+    {
+      FreeNode *next;
+    };
+    static size_t sizeClass(size_t size)
+    {
+      return (size+NODE_POOL_GRANULE-1)/NODE_POOL_GRANULE;
+    }
+    static void release(void *p,size_t cls)
+    {
+      FreeNode *n = (FreeNode *)p;
+      n->next = s_freeList[cls];
+      s_freeList[cls] = n;
+    }
+    static FreeNode *s_freeList[NODE_POOL_CLASSES];
+    static char     *s_blockPtr;
+    static size_t    s_blockLeft;
+};
+
+DocNodePool::FreeNode *DocNodePool::s_freeList[NODE_POOL_CLASSES];
+char                  *DocNodePool::s_blockPtr  = 0;
+size_t                 DocNodePool::s_blockLeft = 0;
+
+void *DocNode::operator new(size_t size)
+{
+  return DocNodePool::alloc(size);
+}
+
+void DocNode::operator delete(void *p,size_t size)
+{
+  DocNodePool::free(p,size);
+}
+
+//---------------------------------------------------------------------------
+
 static const char *sectionLevelToName[] = 
 {
   "page",
@@ -157,6 +157,16 @@ class DocNode
     /*! Returns TRUE iff this node is inside a preformatted section */
     bool isPreformatted() const { return m_insidePre; }
 
+    /*! Allocates the memory for a node from a pool shared by all trees,
+     *  which is much cheaper than the general purpose allocator for the
+     *  many small nodes of a tree. Like the parser itself, the pool may
+     *  only be used from the main thread.
+     */
+    static void *operator new(size_t size);
+
+    /*! Returns the memory of a node of \a size bytes to the pool. */
+    static void operator delete(void *p,size_t size);
+
   protected:
     /*! Sets whether or not this item is inside a preformatted section */
     void setInsidePreformatted(bool p) { m_insidePre = p; }
@@ -22,6 +22,7 @@
 #endif
 
 #include <stdlib.h>
+#include <ctype.h>
 
 #include <qdir.h>
 #include <qfile.h>
@@ -29,6 +30,7 @@
 #include <qthread.h>
 #include <qmutex.h>
 #include <qwaitcondition.h>
+#include <qstrlist.h>
 
 #include "dot.h"
 #include "doxygen.h"
@@ -52,6 +54,7 @@
 #include "namespacedef.h"
 #include "memberdef.h"
 #include "membergroup.h"
+#include "profiler.h"
 
 #define MAP_CMD "cmapx"
 
@@ -730,9 +733,15 @@ static void removeDotGraph(const QCString &dotName)
  *  file does not exist or its contents are not equal to \a md5, 
  *  a new .md5 is generated with the \a md5 string as contents.
  */
+/*! Checks if the graph \a baseName with checksum \a md5 has changed and
+ *  stores the new checksum. Waits for a dot run that is still producing
+ *  the output of \a baseName first, so the caller can check and rewrite
+ *  the .dot file and the images made from it.
+ */
 static bool checkAndUpdateMd5Signature(const QCString &baseName,
             const QCString &md5)
 {
+  DotManager::instance()->waitForDotFile(baseName+".dot");
   QFile f(baseName+".md5");
   if (f.open(IO_ReadOnly))
   {
@@ -777,6 +786,174 @@ static bool checkDeliverables(const QCString &file1,
 
 //--------------------------------------------------------------------
 
+/*! Computes a signature for the dot file \a dotFile, based on its contents
+ *  and the settings that influence the output of dot apart from the
+ *  output format. Returns an empty string if the file cannot be read.
+ */
+static QCString dotCacheSignature(const QCString &dotFile)
+{
+  QFile f(dotFile);
+  if (!f.open(IO_ReadOnly)) return QCString();
+  MD5Context ctx;
+  MD5Init(&ctx);
+  char buf[8192];
+  int n;
+  while ((n=f.readBlock(buf,sizeof(buf)))>0)
+  {
+    MD5Update(&ctx,(const unsigned char *)buf,n);
+  }
+  f.close();
+  QCString settings;
+  settings.sprintf("\n%s\n%s\n%d\n%s\n",
+      Config_getString("DOT_PATH").data(),
+      Config_getString("DOT_FONTNAME").data(),
+      Config_getInt("DOT_FONTSIZE"),
+      Config_getString("DOT_FONTPATH").data());
+  MD5Update(&ctx,(const unsigned char *)settings.data(),settings.length());
+  uchar md5_sig[16];
+  QCString sigStr(33);
+  MD5Final(md5_sig,&ctx);
+  MD5SigToString(md5_sig,sigStr.data(),33);
+  return sigStr;
+}
+
+/*! Returns the name of the file in the dot cache directory \a cacheDir
+ *  that holds the output in \a format for the graph with signature \a sig.
+ *  Files are spread over subdirectories named after the first two
+ *  characters of the signature to keep the directories small.
+ */
+static QCString dotCacheFileName(const QCString &cacheDir,
+                                 const QCString &sig,const QCString &format)
+{
+  QCString ext = format.copy();
+  uint i;
+  for (i=0;i<ext.length();i++)
+  {
+    char c=ext.at(i);
+    if (!isalnum((uchar)c)) ext.at(i)='_'; // e.g. png:cairo:gd
+  }
+  return cacheDir+"/"+sig.left(2)+"/"+sig+"."+ext;
+}
+
+/*! Makes \a dest a copy of \a src, preferably as a hard link. */
+static bool linkOrCopyFile(const QCString &src,const QCString &dest)
+{
+  QDir::current().remove(dest);
+  return portable_link(src,dest) || copyFile(src,dest);
+}
+
+/*! Looks up \a cacheName in the dot cache and if found makes \a output
+ *  a copy of it. Returns TRUE if successful.
+ */
+static bool retrieveFromDotCache(const QCString &cacheName,const QCString &output)
+{
+  QFileInfo fi(cacheName);
+  if (!fi.exists() || fi.size()==0) return FALSE;
+  if (!linkOrCopyFile(cacheName,output)) return FALSE;
+  portable_touch(cacheName); // mark as recently used
+  return TRUE;
+}
+
+/*! Stores the dot \a output file in the dot cache as \a cacheName. */
+static void storeInDotCache(const QCString &output,const QCString &cacheName)
+{
+  QFileInfo fi(output);
+  if (!fi.exists() || fi.size()==0) return;
+  QCString subDir = cacheName.left(cacheName.findRev('/'));
+  if (!QDir(subDir).exists())
+  {
+    QDir::current().mkdir(subDir); // may fail if another thread was first
+  }
+  // use a unique temporary name and rename, so other threads or processes
+  // sharing the cache never see a partially written file
+  QCString tmpName;
+  tmpName.sprintf("%s.%d.%p",cacheName.data(),portable_pid(),(void*)&fi);
+  if (linkOrCopyFile(output,tmpName) &&
+      !QDir::current().rename(tmpName,cacheName))
+  {
+    QDir::current().remove(tmpName);
+  }
+}
+
+/** Information about a file in the dot cache */
+struct DotCacheFile
+{
+  QCString name;
+  int      time;
+  uint     size;
+};
+
+/** List of files in the dot cache, sorted from least to most recently used */
+class DotCacheFileList : public QList<DotCacheFile>
+{
+  public:
+    DotCacheFileList() : QList<DotCacheFile>() {}
+   ~DotCacheFileList() {}
+   int compareItems(QCollection::Item item1,QCollection::Item item2)
+   {
+     return ((DotCacheFile *)item1)->time - ((DotCacheFile *)item2)->time;
+   }
+};
+
+/*! Removes the least recently used files from the dot cache in
+ *  directory \a cacheDir until its size is at most \a maxSize bytes.
+ */
+static void pruneDotCache(const QCString &cacheDir,uint64 maxSize)
+{
+  QDateTime epoch(QDate(1970,1,1));
+  DotCacheFileList files;
+  files.setAutoDelete(TRUE);
+  uint64 totalSize=0;
+  QDir dir(cacheDir);
+  dir.setFilter(QDir::Dirs);
+  const QFileInfoList *subDirs = dir.entryInfoList();
+  if (subDirs==0) return;
+  QFileInfoListIterator sdi(*subDirs);
+  QFileInfo *sdfi;
+  for (;(sdfi=sdi.current());++sdi)
+  {
+    // only consider the subdirectories created by storeInDotCache()
+    QCString subDirName = sdfi->fileName().utf8();
+    if (subDirName.length()!=2 ||
+        !isxdigit((uchar)subDirName.at(0)) ||
+        !isxdigit((uchar)subDirName.at(1))) continue;
+    QDir subDir(sdfi->absFilePath());
+    subDir.setFilter(QDir::Files);
+    const QFileInfoList *list = subDir.entryInfoList();
+    if (list==0) continue;
+    QFileInfoListIterator fli(*list);
+    QFileInfo *fi;
+    for (;(fi=fli.current());++fli)
+    {
+      if (fi->fileName().utf8().left(2)!=subDirName) continue;
+      DotCacheFile *cf = new DotCacheFile;
+      cf->name = fi->absFilePath().utf8();
+      cf->time = epoch.secsTo(fi->lastModified());
+      cf->size = fi->size();
+      totalSize+=cf->size;
+      files.append(cf);
+    }
+  }
+  if (totalSize<=maxSize) return;
+
+  files.sort();
+  int removed=0;
+  QListIterator<DotCacheFile> cfi(files);
+  DotCacheFile *cf;
+  for (;(cf=cfi.current()) && totalSize>maxSize;++cfi)
+  {
+    if (QDir::current().remove(cf->name))
+    {
+      totalSize-=cf->size;
+      removed++;
+    }
+  }
+  msg("Removed %d files from the dot cache to keep it below %d MB\n",
+      removed,(int)(maxSize>>20));
+}
+
+//--------------------------------------------------------------------
+
 /** Class representing a list of DotNode objects. */
 class DotNodeList : public QList<DotNode>
 {
@@ -794,7 +971,8 @@ class DotNodeList : public QList<DotNode>
 DotRunner::DotRunner(const QCString &file,const QCString &path,
                      bool checkResult,const QCString &imageName) 
   : m_file(file), m_path(path), 
-    m_checkResult(checkResult), m_imageName(imageName)
+    m_checkResult(checkResult), m_imageName(imageName),
+    m_cacheHits(0), m_cacheMisses(0)
 {
   static bool dotCleanUp = Config_getBool("DOT_CLEANUP"); 
   m_cleanUp = dotCleanUp;
@@ -803,8 +981,10 @@ DotRunner::DotRunner(const QCString &file,const QCString &path,
 
 void DotRunner::addJob(const char *format,const char *output)
 {
-  QCString args = QCString("-T")+format+" -o \""+output+"\"";
-  m_jobs.append(new QCString(args));
+  Job *job = new Job;
+  job->format = format;
+  job->output = output;
+  m_jobs.append(job);
 }
 
 void DotRunner::addPostProcessing(const char *cmd,const char *args)
@@ -813,28 +993,55 @@ void DotRunner::addPostProcessing(const char *cmd,const char *args)
   m_postArgs = args;
 }
 
-bool DotRunner::run()
+void DotRunner::useCachedOutput()
+{
+  // take the outputs that are available from the cache, and collect
+  // the jobs for which dot still needs to run
+  QCString cacheDir = Config_getString("DOT_CACHE_DIR");
+  if (!cacheDir.isEmpty()) m_sig = dotCacheSignature(m_file);
+  QListIterator<Job> li(m_jobs);
+  Job *job;
+  m_todo.clear();
+  for (li.toFirst();(job=li.current());++li)
+  {
+    if (!m_sig.isEmpty() &&
+        retrieveFromDotCache(dotCacheFileName(cacheDir,m_sig,job->format),job->output))
+    {
+      m_cacheHits++;
+    }
+    else
+    {
+      m_todo.append(job);
+    }
+  }
+  m_cacheMisses = m_todo.count();
+}
+
+bool DotRunner::runDot()
 {
   int exitCode=0;
   QCString dotExe   = Config_getString("DOT_PATH")+"dot";
   bool multiTargets = Config_getBool("DOT_MULTI_TARGETS");
   QCString dotArgs;
-  QListIterator<QCString> li(m_jobs);
-  QCString *s;
-  QCString file      = m_file;
-  QCString path      = m_path;
-  QCString imageName = m_imageName;
-  QCString postCmd   = m_postCmd;
-  QCString postArgs  = m_postArgs;
-  bool checkResult   = m_checkResult;
-  bool cleanUp       = m_cleanUp;
-  if (multiTargets)
+  QListIterator<Job> li(m_todo);
+  Job *job;
+  QCString file     = m_file;
+  // dot rewrites an existing output file in place, which would also
+  // change a dot cache entry that is a hard link to the same file
+  for (li.toFirst();(job=li.current());++li)
+  {
+    QDir::current().remove(job->output);
+  }
+  if (m_todo.count()==0)
+  {
+    // nothing left to do for dot
+  }
+  else if (multiTargets)
   {
     dotArgs="\""+file+"\"";
-    for (li.toFirst();(s=li.current());++li)
+    for (li.toFirst();(job=li.current());++li)
     {
-      dotArgs+=' ';
-      dotArgs+=*s;
+      dotArgs+=" -T"+job->format+" -o \""+job->output+"\"";
     }
     if ((exitCode=portable_system(dotExe,dotArgs,FALSE))!=0)
     {
@@ -843,33 +1050,171 @@ bool DotRunner::run()
   }
   else
   {
-    for (li.toFirst();(s=li.current());++li)
+    for (li.toFirst();(job=li.current());++li)
     {
-      dotArgs="\""+file+"\" "+*s;
+      dotArgs="\""+file+"\" -T"+job->format+" -o \""+job->output+"\"";
       if ((exitCode=portable_system(dotExe,dotArgs,FALSE))!=0)
       {
         goto error;
       }
     }
   }
-  if (!postCmd.isEmpty() && portable_system(postCmd,postArgs)!=0)
+  return TRUE;
+error:
+  err("Problems running dot: exit code=%d, command='%s', arguments='%s'\n",
+      exitCode,dotExe.data(),dotArgs.data());
+  return FALSE;
+}
+
+bool DotRunner::finish()
+{
+  if (!m_sig.isEmpty())
+  {
+    QCString cacheDir = Config_getString("DOT_CACHE_DIR");
+    QListIterator<Job> li(m_todo);
+    Job *job;
+    for (li.toFirst();(job=li.current());++li)
+    {
+      storeInDotCache(job->output,dotCacheFileName(cacheDir,m_sig,job->format));
+    }
+  }
+  if (!m_postCmd.isEmpty() && portable_system(m_postCmd,m_postArgs)!=0)
   {
     err("Problems running '%s' as a post-processing step for dot output\n",m_postCmd.data());
     return FALSE;
   }
-  if (checkResult) checkDotResult(imageName);
-  if (cleanUp) 
+  if (m_checkResult) checkDotResult(m_imageName);
+  if (m_cleanUp) 
   {
     //printf("removing dot file %s\n",m_file.data());
     //QDir(path).remove(file);
-    m_cleanupItem.file = file;
-    m_cleanupItem.path = path;
+    m_cleanupItem.file = m_file;
+    m_cleanupItem.path = m_path;
   }
   return TRUE;
-error:
-  err("Problems running dot: exit code=%d, command='%s', arguments='%s'\n",
-      exitCode,dotExe.data(),dotArgs.data());
-  return FALSE;
+}
+
+bool DotRunner::run()
+{
+  ProfileScope profileDot("Running dot",m_file);
+  useCachedOutput();
+  return runDot() && finish();
+}
+
+/*! Returns the name of the file that dot writes when it is invoked with
+ *  the -O option for input \a file and output \a format. The renderer and
+ *  device parts of the format are included in reverse order, so for
+ *  instance format png:cairo:gd gives file.gd.cairo.png.
+ */
+static QCString dotAutoOutputName(const QCString &file,const QCString &format)
+{
+  QCString result = file;
+  QCString fmt = format;
+  int i;
+  while ((i=fmt.findRev(':'))!=-1)
+  {
+    result+="."+fmt.mid(i+1);
+    fmt=fmt.left(i);
+  }
+  return result+"."+fmt;
+}
+
+// limit for the length of the arguments passed to a batched dot invocation
+#define MAX_DOT_BATCH_ARGS 8000
+
+void DotRunner::runBatch(const QList<DotRunner> &batch)
+{
+  if (batch.count()==1)
+  {
+    batch.getFirst()->run();
+    return;
+  }
+  ProfileScope profileBatch("Running dot batch");
+  QCString dotExe = Config_getString("DOT_PATH")+"dot";
+  QListIterator<DotRunner> li(batch);
+  DotRunner *dr;
+  Job *job;
+
+  // collect the output formats needed by the batch
+  QStrList formats;
+  for (li.toFirst();(dr=li.current());++li)
+  {
+    dr->useCachedOutput();
+    QListIterator<Job> ji(dr->m_todo);
+    for (ji.toFirst();(job=ji.current());++ji)
+    {
+      if (formats.find(job->format)==-1) formats.append(job->format);
+    }
+  }
+
+  // run dot once for all graphs that need a format, and move the
+  // output that dot writes next to each input file to its destination.
+  // If dot fails, the graphs are run again one by one, so the error
+  // is reported for the right graph.
+  QList<DotRunner> failed;
+  const char *format;
+  for (format=formats.first();format;format=formats.next())
+  {
+    li.toFirst();
+    while (li.current())
+    {
+      QList<DotRunner> part;
+      QCString dotArgs = QCString("-T")+format+" -O";
+      for (;(dr=li.current()) && dotArgs.length()<MAX_DOT_BATCH_ARGS;++li)
+      {
+        if (dr->findTodoJob(format) && failed.findRef(dr)==-1)
+        {
+          dotArgs+=" \""+dr->m_file+"\"";
+          part.append(dr);
+        }
+      }
+      if (part.count()==0) continue;
+      QListIterator<DotRunner> pi(part);
+      if (portable_system(dotExe,dotArgs,FALSE)!=0)
+      {
+        // remove what dot did write before it failed
+        for (pi.toFirst();(dr=pi.current());++pi)
+        {
+          QDir::current().remove(dotAutoOutputName(dr->m_file,format));
+          failed.append(dr);
+        }
+        continue;
+      }
+      for (pi.toFirst();(dr=pi.current());++pi)
+      {
+        QCString output = dr->findTodoJob(format)->output;
+        QCString autoName = dotAutoOutputName(dr->m_file,format);
+        QDir::current().remove(output);
+        if (!QDir::current().rename(autoName,output))
+        {
+          if (copyFile(autoName,output)) QDir::current().remove(autoName);
+        }
+      }
+    }
+  }
+
+  for (li.toFirst();(dr=li.current());++li)
+  {
+    if (failed.findRef(dr)==-1)
+    {
+      dr->finish();
+    }
+    else if (dr->runDot())
+    {
+      dr->finish();
+    }
+  }
+}
+
+DotRunner::Job *DotRunner::findTodoJob(const char *format) const
+{
+  QListIterator<Job> li(m_todo);
+  Job *job;
+  for (li.toFirst();(job=li.current());++li)
+  {
+    if (job->format==format) return job;
+  }
+  return 0;
 }
 
 //--------------------------------------------------------------------
@@ -1153,13 +1498,45 @@ bool DotFilePatcher::run()
 
 //--------------------------------------------------------------------
 
+DotRunnerQueue::DotRunnerQueue() : m_busyFiles(257)
+{
+  m_busyFiles.setAutoDelete(TRUE);
+}
+
 void DotRunnerQueue::enqueue(DotRunner *runner)
 {
   QMutexLocker locker(&m_mutex);
   m_queue.enqueue(runner);
+  if (runner)
+  {
+    int *busy = m_busyFiles.find(runner->file());
+    if (busy) (*busy)++; else m_busyFiles.insert(runner->file(),new int(1));
+  }
   m_bufferNotEmpty.wakeAll();
 }
 
+/*! Marks \a runner as finished. Called from a worker thread. */
+void DotRunnerQueue::done(DotRunner *runner)
+{
+  QMutexLocker locker(&m_mutex);
+  int *busy = m_busyFiles.find(runner->file());
+  if (busy && --(*busy)==0)
+  {
+    m_busyFiles.remove(runner->file());
+    m_runnerDone.wakeAll();
+  }
+}
+
+/*! Waits until all queued runners for \a dotFile have finished. */
+void DotRunnerQueue::waitUntilDone(const QCString &dotFile)
+{
+  QMutexLocker locker(&m_mutex);
+  while (m_busyFiles.find(dotFile))
+  {
+    m_runnerDone.wait(&m_mutex);
+  }
+}
+
 DotRunner *DotRunnerQueue::dequeue()
 {
   QMutexLocker locker(&m_mutex);
@@ -1172,6 +1549,16 @@ DotRunner *DotRunnerQueue::dequeue()
   return result;
 }
 
+/*! Returns the next runner in the queue without waiting. Returns 0
+ *  if the queue is empty or the next item is a terminator.
+ */
+DotRunner *DotRunnerQueue::tryDequeue()
+{
+  QMutexLocker locker(&m_mutex);
+  if (m_queue.isEmpty() || m_queue.head()==0) return 0;
+  return m_queue.dequeue();
+}
+
 uint DotRunnerQueue::count() const
 {
   QMutexLocker locker(&m_mutex);
@@ -1184,18 +1571,32 @@ DotWorkerThread::DotWorkerThread(DotRunnerQueue *queue)
       : m_queue(queue)
 {
   m_cleanupItems.setAutoDelete(TRUE);
+  m_batchSize = Config_getInt("DOT_BATCH_SIZE");
 }
 
 void DotWorkerThread::run()
 {
+  Profiler::setThreadName("DotWorkerThread");
   DotRunner *runner;
+  QList<DotRunner> batch;
   while ((runner=m_queue->dequeue()))
   {
-    runner->run();
-    DotRunner::CleanupItem cleanup = runner->cleanup();
-    if (!cleanup.file.isEmpty())
+    batch.clear();
+    batch.append(runner);
+    while (batch.count()<m_batchSize && (runner=m_queue->tryDequeue()))
     {
-      m_cleanupItems.append(new DotRunner::CleanupItem(cleanup));
+      batch.append(runner);
+    }
+    DotRunner::runBatch(batch);
+    QListIterator<DotRunner> li(batch);
+    for (li.toFirst();(runner=li.current());++li)
+    {
+      DotRunner::CleanupItem cleanup = runner->cleanup();
+      if (!cleanup.file.isEmpty())
+      {
+        m_cleanupItems.append(new DotRunner::CleanupItem(cleanup));
+      }
+      m_queue->done(runner);
     }
   }
 }
@@ -1223,7 +1624,7 @@ DotManager *DotManager::instance()
   return m_theInstance;
 }
 
-DotManager::DotManager() : m_dotMaps(1007)
+DotManager::DotManager() : m_dotMaps(1007), m_fontPathSet(FALSE)
 {
   m_dotRuns.setAutoDelete(TRUE);
   m_dotMaps.setAutoDelete(TRUE);
@@ -1248,6 +1649,8 @@ DotManager::DotManager() : m_dotMaps(1007)
     }
     ASSERT(m_workers.count()>0);
   }
+  // with worker threads, dot already runs while the pages are generated
+  m_running = m_workers.count()>0;
 }
 
 DotManager::~DotManager()
@@ -1258,6 +1661,39 @@ DotManager::~DotManager()
 void DotManager::addRun(DotRunner *run)
 {
   m_dotRuns.append(run);
+  if (m_running)
+  {
+    setFontPath();
+    m_queue->enqueue(run);
+  }
+}
+
+/*! Waits until all dot runs for \a dotFile have finished, so the file
+ *  can be written again and the images and maps made from it are complete.
+ */
+void DotManager::waitForDotFile(const QCString &dotFile)
+{
+  if (m_running) m_queue->waitUntilDone(dotFile);
+}
+
+void DotManager::setFontPath()
+{
+  if (m_fontPathSet) return;
+  if (Config_getBool("GENERATE_HTML"))
+  {
+    setDotFontPath(Config_getString("HTML_OUTPUT"));
+    m_fontPathSet=TRUE;
+  }
+  else if (Config_getBool("GENERATE_LATEX"))
+  {
+    setDotFontPath(Config_getString("LATEX_OUTPUT"));
+    m_fontPathSet=TRUE;
+  }
+  else if (Config_getBool("GENERATE_RTF"))
+  {
+    setDotFontPath(Config_getString("RTF_OUTPUT"));
+    m_fontPathSet=TRUE;
+  }
 }
 
 int DotManager::addMap(const QCString &file,const QCString &mapFile,
@@ -1328,41 +1764,31 @@ bool DotManager::run()
   int i=1;
   QListIterator<DotRunner> li(m_dotRuns);
 
-  bool setPath=FALSE;
-  if (Config_getBool("GENERATE_HTML"))
-  {
-    setDotFontPath(Config_getString("HTML_OUTPUT"));
-    setPath=TRUE;
-  }
-  else if (Config_getBool("GENERATE_LATEX"))
-  {
-    setDotFontPath(Config_getString("LATEX_OUTPUT"));
-    setPath=TRUE;
-  }
-  else if (Config_getBool("GENERATE_RTF"))
-  {
-    setDotFontPath(Config_getString("RTF_OUTPUT"));
-    setPath=TRUE;
-  }
+  setFontPath();
   portable_sysTimerStart();
   // fill work queue with dot operations
   DotRunner *dr;
   int prev=1;
   if (m_workers.count()==0) // no threads to work with
   {
+    uint batchSize = Config_getInt("DOT_BATCH_SIZE");
+    QList<DotRunner> batch;
     for (li.toFirst();(dr=li.current());++li)
     {
       msg("Running dot for graph %d/%d\n",prev,numDotRuns);
-      dr->run();
+      batch.append(dr);
+      if (batch.count()>=batchSize)
+      {
+        DotRunner::runBatch(batch);
+        batch.clear();
+      }
       prev++;
     }
+    if (batch.count()>0) DotRunner::runBatch(batch);
   }
   else // use multiple threads to run instances of dot in parallel
   {
-    for (li.toFirst();(dr=li.current());++li)
-    {
-      m_queue->enqueue(dr);
-    }
+    // the runs were handed to the workers by addRun(), 
     // wait for the queue to become empty
     while ((i=m_queue->count())>0)
     {
@@ -1380,6 +1806,7 @@ bool DotManager::run()
       prev++;
     }
     // signal the workers we are done
+    m_running=FALSE;
     for (i=0;i<(int)m_workers.count();i++)
     {
       m_queue->enqueue(0); // add terminator for each worker
@@ -1396,9 +1823,26 @@ bool DotManager::run()
     }
   }
   portable_sysTimerStop();
-  if (setPath)
+  if (m_fontPathSet)
   {
     unsetDotFontPath();
+    m_fontPathSet=FALSE;
+  }
+
+  QCString cacheDir = Config_getString("DOT_CACHE_DIR");
+  if (!cacheDir.isEmpty())
+  {
+    int hits=0,misses=0;
+    for (li.toFirst();(dr=li.current());++li)
+    {
+      hits+=dr->cacheHits();
+      misses+=dr->cacheMisses();
+    }
+    if (hits+misses>0)
+    {
+      msg("Dot cache: %d of %d outputs reused\n",hits,hits+misses);
+    }
+    pruneDotCache(cacheDir,((uint64)Config_getInt("DOT_CACHE_SIZE"))<<20);
   }
 
   // patch the output file and insert the maps and figures
@@ -2322,12 +2766,12 @@ void DotGfxHierarchyTable::writeGraph(FTextStream &out,
     MD5Buffer((const unsigned char *)theGraph.data(),theGraph.length(),md5_sig);
     MD5SigToString(md5_sig,sigStr.data(),33);
     bool regenerate=FALSE;
+    QCString dotName=absBaseName+".dot";
     if (checkAndUpdateMd5Signature(absBaseName,sigStr) || 
         !checkDeliverables(absImgName,absMapName))
     {
       regenerate=TRUE;
       // image was new or has changed
-      QCString dotName=absBaseName+".dot";
       QFile f(dotName);
       if (!f.open(IO_WriteOnly)) return;
       FTextStream t(&f);
@@ -3044,13 +3488,15 @@ static bool updateDotGraph(DotNode *root,
   QCString md5 = computeMd5Signature(
                    root,gt,format,lrRank,renderParents,
                    backArrows,title,theGraph);
+  // check first, so the .dot file is not rewritten while dot still reads it
+  bool regenerate = checkAndUpdateMd5Signature(baseName,md5);
   QFile f(baseName+".dot");
   if (f.open(IO_WriteOnly))
   {
     FTextStream t(&f);
     t << theGraph;
   }
-  return checkAndUpdateMd5Signature(baseName,md5); // graph needs to be regenerated
+  return regenerate; // graph needs to be regenerated
 }
 
 QCString DotClassGraph::diskName() const
@@ -344,9 +344,32 @@ class DotRunner
     /** Runs dot for all jobs added. */
     bool run();
     CleanupItem cleanup() const { return m_cleanupItem; }
+    QCString file() const { return m_file; }
+
+    /** Runs the jobs of all runners in \a batch using a single dot
+     *  invocation per output format.
+     */
+    static void runBatch(const QList<DotRunner> &batch);
+
+    /** Returns the number of outputs taken from the dot cache. */
+    int cacheHits() const { return m_cacheHits; }
+    /** Returns the number of outputs that had to be generated by dot. */
+    int cacheMisses() const { return m_cacheMisses; }
 
   private:
-    QList<QCString> m_jobs;
+    struct Job
+    {
+      QCString format;
+      QCString output;
+    };
+    void useCachedOutput();
+    bool runDot();
+    bool finish();
+    Job *findTodoJob(const char *format) const;
+
+    QList<Job> m_jobs;
+    QList<Job> m_todo;  // jobs not satisfied from the dot cache
+    QCString m_sig;     // signature used for the dot cache
     QCString m_postArgs;
     QCString m_postCmd;
     QCString m_file;
@@ -355,6 +378,8 @@ class DotRunner
     QCString m_imageName;
     bool m_cleanUp;
     CleanupItem m_cleanupItem;
+    int m_cacheHits;
+    int m_cacheMisses;
 };
 
 /** Helper class to insert a set of map file into an output file */
@@ -392,12 +417,18 @@ class DotFilePatcher
 class DotRunnerQueue
 {
   public:
+    DotRunnerQueue();
     void enqueue(DotRunner *runner);
     DotRunner *dequeue();
+    DotRunner *tryDequeue();
+    void done(DotRunner *runner);
+    void waitUntilDone(const QCString &dotFile);
     uint count() const;
   private:
     QWaitCondition  m_bufferNotEmpty;
+    QWaitCondition  m_runnerDone;
     QQueue<DotRunner> m_queue;
+    QDict<int>      m_busyFiles; // number of unfinished runners per dot file
     mutable QMutex  m_mutex;
 };
 
@@ -410,6 +441,7 @@ class DotWorkerThread : public QThread
     void cleanup();
   private:
     DotRunnerQueue *m_queue;
+    uint m_batchSize;
     QList<DotRunner::CleanupItem> m_cleanupItems;
 };
 
@@ -428,16 +460,20 @@ class DotManager
                bool urlOnly,const QCString &context,bool zoomable,int graphId);
     int addSVGObject(const QCString &file,const QCString &baseName,
                      const QCString &figureNAme,const QCString &relPath);
+    void waitForDotFile(const QCString &dotFile);
     bool run();
 
   private:
     DotManager();
     virtual ~DotManager();
+    void setFontPath();
     QList<DotRunner>       m_dotRuns;
     SDict<DotFilePatcher> m_dotMaps;
     static DotManager     *m_theInstance;
     DotRunnerQueue        *m_queue;
     QList<DotWorkerThread> m_workers;
+    bool                   m_fontPathSet;
+    bool                   m_running; // TRUE while runs go to the workers
 };
 
 
@@ -29,6 +29,9 @@
 #include <errno.h>
 #include <qptrdict.h>
 #include <qtextstream.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
 
 #include "version.h"
 #include "doxygen.h"
@@ -84,6 +87,7 @@
 #include "eclipsehelp.h"
 #include "cite.h"
 #include "filestorage.h"
+#include "lookupcache.h"
 #include "markdown.h"
 #include "arguments.h"
 #include "memberlist.h"
@@ -98,6 +102,7 @@
 #include "formula.h"
 #include "settings.h"
 #include "context.h"
+#include "profiler.h"
 
 #define RECURSE_ENTRYTREE(func,var) \
   do { if (var->children()) { \
@@ -108,6 +113,7 @@
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <signal.h>
+#include <dirent.h>
 #define HAS_SIGNALS
 #endif
 
@@ -151,7 +157,7 @@ QDict<DefinitionIntf> *Doxygen::symbolMap = 0;
 QDict<Definition> *Doxygen::clangUsrMap = 0;
 bool             Doxygen::outputToWizard=FALSE;
 QDict<int> *     Doxygen::htmlDirMap = 0;
-QCache<LookupInfo> *Doxygen::lookupCache;
+LookupCache     *Doxygen::lookupCache;
 DirSDict        *Doxygen::directories;
 SDict<DirRelation> Doxygen::dirRelations(257);
 ParserManager   *Doxygen::parserManager = 0;
@@ -179,6 +185,7 @@ static FileStorage     *g_storage = 0;
 static bool             g_successfulRun = FALSE;
 static bool             g_dumpSymbolMap = FALSE;
 static bool             g_useOutputTemplate = FALSE; 
+static QCString         g_traceFile;               // file to write a trace of the run to
 
 void clearAll()
 {
@@ -210,17 +217,29 @@ void clearAll()
 class Statistics 
 {
   public:
-    Statistics() { stats.setAutoDelete(TRUE); }
+    Statistics() : inStep(FALSE) { stats.setAutoDelete(TRUE); }
     void begin(const char *name)
     {
       msg(name);
       stat *entry= new stat(name,0);
       stats.append(entry);
       time.restart();
+      Profiler::begin(phaseName(name));
+    }
+    /*! Starts a sub-step of the current phase, ending the previous one */
+    void step(const char *name)
+    {
+      if (inStep) Profiler::end();
+      Profiler::begin(name);
+      inStep=TRUE;
     }
     void end()
     {
       stats.last()->elapsed=((double)time.elapsed())/1000.0;
+      if (inStep) Profiler::end();
+      inStep=FALSE;
+      Profiler::end();
+      sampleCounters();
     }
     void print()
     {
@@ -237,9 +256,32 @@ class Statistics
       {
         msg("Spent %.3f seconds in %s",s->elapsed,s->name);
       }
+      Profiler::printSummary();
       if (restore) Debug::setFlag("time");
     }
   private:
+    // strips the trailing dots and newline of a progress message
+    static QCString phaseName(const char *name)
+    {
+      QCString result=QCString(name).stripWhiteSpace();
+      while (result.right(1)==".") result=result.left(result.length()-1);
+      return result;
+    }
+    static void sampleCounters()
+    {
+      if (!Profiler::isEnabled()) return;
+      if (Doxygen::symbolStorage)
+      {
+        Profiler::counter("store reads", Doxygen::symbolStorage->reads());
+        Profiler::counter("store writes",Doxygen::symbolStorage->writes());
+      }
+      if (Doxygen::lookupCache)
+      {
+        Profiler::counter("lookup cache hits",  Doxygen::lookupCache->hits());
+        Profiler::counter("lookup cache misses",Doxygen::lookupCache->misses());
+      }
+      Profiler::counter("peak RSS (kB)",portable_peakMemoryUsage());
+    }
     struct stat 
     {
       const char *name;
@@ -249,6 +291,7 @@ class Statistics
     };
     QList<stat> stats;
     QTime       time;
+    bool        inStep;
 } g_s;
 
 
@@ -7687,6 +7730,7 @@ static void buildCompleteMemberLists()
   ClassDef *cd;
   ClassSDict::Iterator cli(*Doxygen::classSDict);
   // merge the member list of base classes into the inherited classes.
+  Profiler::begin("Merging members");
   for (cli.toFirst();(cd=cli.current());++cli)
   {
     if (// !cd->isReference() && // not an external class
@@ -7697,11 +7741,14 @@ static void buildCompleteMemberLists()
       cd->mergeMembers();
     }
   }
+  Profiler::end();
   // now sort the member list of all classes.
+  Profiler::begin("Sorting members");
   for (cli.toFirst();(cd=cli.current());++cli)
   {
     if (cd->memberNameInfoSDict()) cd->memberNameInfoSDict()->sort();
   }
+  Profiler::end();
 }
 
 //----------------------------------------------------------------------------
@@ -7738,6 +7785,7 @@ static void generateFileSources()
         {
           if (fd->isSource() && !fd->isReference())
           {
+            ProfileScope profileFile("Generating file sources",fd->docName());
             QStrList filesInSameTu;
             fd->getAllIncludeFilesRecursively(filesInSameTu);
             fd->startParsing();
@@ -7795,6 +7843,7 @@ static void generateFileSources()
         {
           if (!g_processedFiles.find(fd->absFilePath())) // not yet processed
           {
+            ProfileScope profileFile("Generating file sources",fd->docName());
             QStrList filesInSameTu;
             fd->startParsing();
             if (fd->generateSourceFile()) // sources need to be shown in the output
@@ -7825,6 +7874,7 @@ static void generateFileSources()
         FileDef *fd;
         for (;(fd=fni.current());++fni)
         {
+          ProfileScope profileFile("Generating file sources",fd->docName());
           QStrList filesInSameTu;
           fd->startParsing();
           if (fd->generateSourceFile()) // sources need to be shown in the output
@@ -7866,6 +7916,7 @@ static void generateFileDocs()
         if (doc)
         {
           msg("Generating docs for file %s...\n",fd->docName().data());
+          ProfileScope profileFile("Generating file docs",fd->docName());
           fd->writeDocumentation(*g_outputList);
         }
       }
@@ -8016,6 +8067,7 @@ static void generateClassList(ClassSDict &classSDict)
       if ( cd->isLinkableInProject() && cd->templateMaster()==0)
       {
         msg("Generating docs for compound %s...\n",cd->name().data());
+        ProfileScope profileClass("Generating class docs",cd->name());
 
         cd->writeDocumentation(*g_outputList);
         cd->writeMemberList(*g_outputList);
@@ -8234,21 +8286,23 @@ static void findSectionsInDocumentation()
   if (Doxygen::mainPage) Doxygen::mainPage->findSectionsInDocumentation();
 }
 
+static bool isResolvedLookup(const LookupInfo &li)
+{
+  return li.classDef!=0;
+}
+
+static bool isUnresolvedLookup(const LookupInfo &li)
+{
+  return li.classDef==0 && li.typeDef==0;
+}
+
 static void flushCachedTemplateRelations()
 {
   // remove all references to classes from the cache
   // as there can be new template instances in the inheritance path
   // to this class. Optimization: only remove those classes that
   // have inheritance instances as direct or indirect sub classes.
-  QCacheIterator<LookupInfo> ci(*Doxygen::lookupCache);
-  LookupInfo *li=0;
-  for (ci.toFirst();(li=ci.current());++ci)
-  {
-    if (li->classDef)
-    {
-      Doxygen::lookupCache->remove(ci.currentKey());
-    }
-  }
+  Doxygen::lookupCache->removeIf(isResolvedLookup);
   // remove all cached typedef resolutions whose target is a
   // template class as this may now be a template instance
   MemberNameSDict::Iterator fnli(*Doxygen::functionNameSDict);
@@ -8296,15 +8350,7 @@ static void flushUnresolvedRelations()
   // class B : public A {};
   // class C : public B::I {};
   //
-  QCacheIterator<LookupInfo> ci(*Doxygen::lookupCache);
-  LookupInfo *li=0;
-  for (ci.toFirst();(li=ci.current());++ci)
-  {
-    if (li->classDef==0 && li->typeDef==0)
-    {
-      Doxygen::lookupCache->remove(ci.currentKey());
-    }
-  }
+  Doxygen::lookupCache->removeIf(isUnresolvedLookup);
 
   MemberNameSDict::Iterator fnli(*Doxygen::functionNameSDict);
   MemberName *fn;
@@ -8768,6 +8814,7 @@ static void generatePageDocs()
     if (!pd->getGroupDef() && !pd->isReference())
     {
       msg("Generating docs for page %s...\n",pd->name().data());
+      ProfileScope profilePage("Generating page docs",pd->name());
       Doxygen::insideMainPage=TRUE;
       pd->writeDocumentation(*g_outputList);
       Doxygen::insideMainPage=FALSE;
@@ -8843,6 +8890,7 @@ static void generateExampleDocs()
   for (pdi.toFirst();(pd=pdi.current());++pdi)
   {
     msg("Generating docs for example %s...\n",pd->name().data());
+    ProfileScope profileExample("Generating example docs",pd->name());
     resetCCodeParserState();
     QCString n=pd->getOutputFileBase();
     startFile(*g_outputList,n,n,pd->name());
@@ -8875,6 +8923,7 @@ static void generateGroupDocs()
   {
     if (!gd->isReference())
     {
+      ProfileScope profileGroup("Generating group docs",gd->name());
       gd->writeDocumentation(*g_outputList);
     }
   }
@@ -8913,6 +8962,7 @@ static void generateNamespaceDocs()
     if (nd->isLinkableInProject())
     {
       msg("Generating docs for namespace %s\n",nd->name().data());
+      ProfileScope profileNamespace("Generating namespace docs",nd->name());
       nd->writeDocumentation(*g_outputList);
     }
 
@@ -8929,6 +8979,7 @@ static void generateNamespaceDocs()
          )
       {
         msg("Generating docs for compound %s...\n",cd->name().data());
+        ProfileScope profileClass("Generating class docs",cd->name());
 
         cd->writeDocumentation(*g_outputList);
         cd->writeMemberList(*g_outputList);
@@ -9174,15 +9225,145 @@ static ParserInterface *getParserForFile(const char *fn)
   return Doxygen::parserManager->getParser(extension);
 }
 
+//----------------------------------------------------------------------------
+
+/** An input file that is read ahead of the parser by a ReadAheadThread */
+struct ReadAheadFile
+{
+  ReadAheadFile(const QCString &n,const QCString &f)
+    : name(n), filter(f), buf(0), done(FALSE) {}
+ ~ReadAheadFile() { delete buf; }
+  QCString name;   //!< absolute file name
+  QCString filter; //!< filter command or empty if the file is not filtered
+  BufStr  *buf;    //!< file contents, valid when done is TRUE
+  bool     done;   //!< TRUE when the file has been read
+};
+
+/** Queue of input files to be read ahead of the parser.
+ *
+ *  Worker threads take files in input order and read at most
+ *  a fixed number of files ahead of the file that is currently parsed,
+ *  so the memory used for the buffers stays bounded.
+ */
+class ReadAheadQueue
+{
+  public:
+    ReadAheadQueue(int window) : m_window(window), m_next(0), m_consumed(0)
+    {
+      m_files.setAutoDelete(TRUE);
+    }
+    void append(ReadAheadFile *f)
+    {
+      m_files.append(f);
+    }
+    uint count() const
+    {
+      return m_files.count();
+    }
+    /** Returns the next file to read or 0 if there is no more work.
+     *  Called from a worker thread.
+     */
+    ReadAheadFile *nextJob()
+    {
+      QMutexLocker locker(&m_mutex);
+      while (m_next<(int)m_files.count() && m_next>=m_consumed+m_window)
+      {
+        m_notFull.wait(&m_mutex);
+      }
+      if (m_next>=(int)m_files.count()) return 0;
+      return m_files.at(m_next++);
+    }
+    /** Marks file \a f as read. Called from a worker thread. */
+    void jobDone(ReadAheadFile *f)
+    {
+      QMutexLocker locker(&m_mutex);
+      f->done=TRUE;
+      m_ready.wakeAll();
+    }
+    /** Waits until the file at position \a index is read and returns it. */
+    ReadAheadFile *take(int index)
+    {
+      QMutexLocker locker(&m_mutex);
+      ReadAheadFile *f = m_files.at(index);
+      while (!f->done)
+      {
+        m_ready.wait(&m_mutex);
+      }
+      // release the buffer of the previous file and allow the workers to
+      // move on to the next one.
+      if (index>0)
+      {
+        ReadAheadFile *prev = m_files.at(index-1);
+        delete prev->buf;
+        prev->buf=0;
+      }
+      m_consumed=index+1;
+      m_notFull.wakeAll();
+      return f;
+    }
+    /** Stops the workers, even if not all files have been read. */
+    void stop()
+    {
+      QMutexLocker locker(&m_mutex);
+      m_next=m_files.count();
+      m_notFull.wakeAll();
+    }
+  private:
+    QList<ReadAheadFile> m_files;
+    int m_window;
+    int m_next;
+    int m_consumed;
+    QMutex m_mutex;
+    QWaitCondition m_notFull;
+    QWaitCondition m_ready;
+};
+
+/** Worker thread that reads input files for a ReadAheadQueue */
+class ReadAheadThread : public QThread
+{
+  public:
+    ReadAheadThread(ReadAheadQueue *queue,const QCString &inputEncoding,
+                    const QCString &filterCacheDir)
+      : m_queue(queue), m_inputEncoding(inputEncoding),
+        m_filterCacheDir(filterCacheDir) {}
+    void run()
+    {
+      Profiler::setThreadName("ReadAheadThread");
+      ReadAheadFile *f;
+      while ((f=m_queue->nextJob()))
+      {
+        QFileInfo fi(f->name);
+        f->buf = new BufStr(fi.size()+4096);
+        if (!readInputFileWithFilter(f->name,*f->buf,f->filter,
+                                     m_inputEncoding,m_filterCacheDir))
+        {
+          // let the parser read the file itself and report the problem
+          delete f->buf;
+          f->buf=0;
+        }
+        m_queue->jobDone(f);
+      }
+    }
+  private:
+    ReadAheadQueue *m_queue;
+    QCString m_inputEncoding;
+    QCString m_filterCacheDir;
+};
+
+/*! Parses input file \a fn with \a parser. If \a inBuf is not 0 it holds
+ *  the already read (and filtered) contents of the file. It is released
+ *  once it has been consumed.
+ */
 static void parseFile(ParserInterface *parser,
                       Entry *root,EntryNav *rootNav,FileDef *fd,const char *fn,
-                      bool sameTu,QStrList &filesInSameTu)
+                      bool sameTu,QStrList &filesInSameTu,BufStr *inBuf=0)
 {
 #if USE_LIBCLANG
   static bool clangAssistedParsing = Config_getBool("CLANG_ASSISTED_PARSING");
 #else
   static bool clangAssistedParsing = FALSE;
 #endif
+  ProfileScope profileFile("Parsing file",fn);
   QCString fileName=fn;
   QCString extension;
   int ei = fileName.findRev('.');
@@ -9195,27 +9376,44 @@ static void parseFile(ParserInterface *parser,
     extension = ".no_extension";
   }
 
+  // Each of the stages below reads one buffer and writes the next one.
+  // A buffer is released as soon as its stage is done, so at most two 
+  // copies of the file are kept in memory.
   QFileInfo fi(fileName);
-  BufStr preBuf(fi.size()+4096);
+  BufStr fileBuf(inBuf ? 0 : fi.size()+4096);
+  BufStr preBuf(0);
+  BufStr *srcBuf = inBuf ? inBuf : &fileBuf;
 
   if (Config_getBool("ENABLE_PREPROCESSING") && 
       parser->needsPreprocessing(extension))
   {
-    BufStr inBuf(fi.size()+4096);
     msg("Preprocessing %s...\n",fn);
-    readInputFile(fileName,inBuf);
-    preprocessFile(fileName,inBuf,preBuf);
+    ProfileScope profilePre("Preprocessing");
+    if (inBuf==0) // file was not read ahead
+    {
+      readInputFile(fileName,fileBuf);
+    }
+    preBuf.resize(srcBuf->curPos()+4096);
+    preprocessFile(fileName,*srcBuf,preBuf);
+    srcBuf->release();
+    srcBuf = &preBuf;
   }
   else // no preprocessing
   {
     msg("Reading %s...\n",fn);
-    readInputFile(fileName,preBuf);
+    if (inBuf==0) // file was not read ahead
+    {
+      readInputFile(fileName,fileBuf);
+    }
   }
 
-  BufStr convBuf(preBuf.curPos()+1024);
+  BufStr convBuf(srcBuf->curPos()+1024);
 
   // convert multi-line C++ comments to C style comments
-  convertCppComments(&preBuf,&convBuf,fileName);
+  Profiler::begin("Converting comments");
+  convertCppComments(srcBuf,&convBuf,fileName);
+  Profiler::end();
+  srcBuf->release();
 
   convBuf.addChar('\0');
 
@@ -9225,12 +9423,84 @@ static void parseFile(ParserInterface *parser,
   }
 
   // use language parse to parse the file
+  Profiler::begin("Scanning");
   parser->parseInput(fileName,convBuf.data(),root,sameTu,filesInSameTu);
+  Profiler::end();
 
   // store the Entry tree in a file and create an index to
   // navigate/load entries
   //printf("root->createNavigationIndex for %s\n",fd->name().data());
+  Profiler::begin("Storing entries");
   root->createNavigationIndex(rootNav,g_storage,fd);
+  Profiler::end();
+}
+
+/*! Parses the list of input files, while \a numThreads worker threads
+ *  read, filter and transcode the files ahead of the parser.
+ *
+ *  Only reading the files runs in parallel. The preprocessor, the
+ *  comment converter and the language scanners are not reentrant, so
+ *  preprocessing and parsing still run on the main thread, one file after
+ *  the other in input order.
+ */
+static void parseFilesReadAhead(Entry *root,EntryNav *rootNav,int numThreads)
+{
+  // the filter lookup uses QRegExp, which is not thread-safe,
+  // so determine the filters up front.
+  ReadAheadQueue queue(numThreads*4);
+  QCString *s;
+  for (s=g_inputFiles.first();s;s=g_inputFiles.next())
+  {
+    queue.append(new ReadAheadFile(*s,getFileFilter(*s,FALSE)));
+  }
+  QList<ReadAheadThread> workers;
+  workers.setAutoDelete(TRUE);
+  QCString inputEncoding = Config_getString("INPUT_ENCODING");
+  QCString filterCacheDir = Config_getString("FILTER_CACHE_DIR");
+  int i;
+  for (i=0;i<numThreads;i++)
+  {
+    ReadAheadThread *thread = new ReadAheadThread(&queue,inputEncoding,filterCacheDir);
+    thread->start();
+    if (thread->isRunning())
+    {
+      workers.append(thread);
+    }
+    else // no more threads available!
+    {
+      delete thread;
+      break;
+    }
+  }
+  if (workers.count()==0) // no threads to work with, read the files ourselves
+  {
+    queue.stop();
+  }
+  else
+  {
+    msg("Reading input files using %d parallel threads...\n",workers.count());
+  }
+
+  i=0;
+  for (s=g_inputFiles.first();s;s=g_inputFiles.next(),i++)
+  {
+    ReadAheadFile *f = workers.count()>0 ? queue.take(i) : 0;
+    bool ambig;
+    QStrList filesInSameTu;
+    FileDef *fd=findFileDef(Doxygen::inputNameDict,s->data(),ambig);
+    ASSERT(fd!=0);
+    ParserInterface * parser = getParserForFile(s->data());
+    parser->startTranslationUnit(s->data());
+    parseFile(parser,root,rootNav,fd,s->data(),FALSE,filesInSameTu,f ? f->buf : 0);
+  }
+
+  // wait for the workers to finish
+  QListIterator<ReadAheadThread> it(workers);
+  ReadAheadThread *thread;
+  for (;(thread=it.current());++it)
+  {
+    thread->wait();
+  }
 }
 
 //! parse the list of input files
@@ -9311,6 +9581,12 @@ static void parseFiles(Entry *root,EntryNav *rootNav)
   else // normal pocessing
 #endif
   {
+    int numThreads = numProcThreads();
+    if (numThreads>1 && g_inputFiles.count()>1)
+    {
+      parseFilesReadAhead(root,rootNav,numThreads);
+      return;
+    }
     QCString *s=g_inputFiles.first();
     while (s)
     {
@@ -9397,111 +9673,507 @@ static QCString resolveSymlink(QCString path)
 static QDict<void> g_pathsVisited(1009);
 
 //----------------------------------------------------------------------------
-// Read all files matching at least one pattern in `patList' in the 
-// directory represented by `fi'.
-// The directory is read iff the recusiveFlag is set.
-// The contents of all files is append to the input string
+// Scanning of input directories. Worker threads list the directories of
+// the tree ahead of the main thread. The main thread adds the files to
+// the dictionaries in the same order as a sequential walk would.
+
+struct DirScan;
+
+/** An entry of a directory listed by a DirScanner */
+struct DirScanEntry
+{
+  DirScanEntry(const char *n,int i)
+    : name(n), index(i), exists(FALSE), readable(FALSE), isFile(FALSE),
+      isDir(FALSE), isSymLink(FALSE), matches(FALSE), size(0), subDir(0) {}
+  QCString name;
+  int      index;     // position in the directory, to keep the sort stable
+  bool     exists;
+  bool     readable;
+  bool     isFile;
+  bool     isDir;
+  bool     isSymLink;
+  bool     matches;   // files: matches the patterns, dirs: is not excluded
+  uint     size;
+  DirScan *subDir;    // contents of the sub directory if listed ahead
+};
 
-int readDir(QFileInfo *fi,
-            FileNameList *fnList,
-            FileNameDict *fnDict,
-            StringDict  *exclDict,
-            QStrList *patList,
-            QStrList *exclPatList,
-            StringList *resultList,
-            StringDict *resultDict,
-            bool errorIfNotExist,
-            bool recursive,
-            QDict<void> *killDict,
-            QDict<void> *paths
-           )
+/** The entries of a directory, sorted by name like QDir does */
+struct DirScan
 {
-  QCString dirName = fi->absFilePath().utf8();
-  if (paths && paths->find(dirName)==0)
+  enum State { Queued, Listing, Done };
+  DirScan(const QCString &n) : dirName(n), state(Queued)
   {
-    paths->insert(dirName,(void*)0x8);
+    entries.setAutoDelete(TRUE);
   }
-  if (fi->isSymLink())
+  QCString dirName;
+  QList<DirScanEntry> entries;
+  State state;
+};
+
+/** Parameters of a walk over a directory tree by readDir() */
+struct DirWalk
+{
+  FileNameList *fnList;
+  FileNameDict *fnDict;
+  StringDict   *exclDict;
+  StringList   *resultList;
+  StringDict   *resultDict;
+  bool          errorIfNotExist;
+  bool          recursive;
+  bool          excludeSymlinks;
+  QDict<void>  *killDict;
+  QDict<void>  *paths;
+};
+
+static int compareDirScanEntries(const void *p1,const void *p2)
+{
+  const DirScanEntry *e1 = *(const DirScanEntry **)p1;
+  const DirScanEntry *e2 = *(const DirScanEntry **)p2;
+  int r = qstricmp(e1->name,e2->name);
+  return r!=0 ? r : e1->index-e2->index;
+}
+
+/** @brief Lists the directories of a tree, using worker threads to list
+ *  the sub directories of a directory before they are needed.
+ *
+ *  The workers take the directories from a stack, so they work close to
+ *  the position of the main thread in the tree. If the main thread needs a
+ *  directory that no worker has started on yet, it lists it itself.
+ */
+class DirScanner
+{
+  public:
+    DirScanner(const FilePatternMatcher *patterns,
+               const FilePatternMatcher *exclPatterns,
+               const DirWalk &walk,int numThreads);
+   ~DirScanner();
+    /** Returns the listing of directory \a dirName, made by the calling
+     *  thread. The sub directories are queued for the workers.
+     */
+    DirScan *scan(const QCString &dirName);
+    /** Waits until \a s has been listed. */
+    void wait(DirScan *s);
+    /** Deletes \a s and the listings of its sub directories. */
+    void release(DirScan *s);
+    /** Returns the next directory to list or 0 if the scanner is stopped.
+     *  Called from a worker thread.
+     */
+    DirScan *nextJob();
+    /** Lists the entries of the directory \a s. */
+    void list(DirScan *s);
+
+  private:
+    void readEntries(DirScan *s);
+    const FilePatternMatcher *m_patterns;
+    const FilePatternMatcher *m_exclPatterns;
+    bool m_recursive;
+    bool m_excludeSymlinks;
+    QList<DirScan> m_stack;
+    bool m_stopped;
+    QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_listed;
+    QList<QThread> m_workers;
+};
+
+/** Worker thread of a DirScanner */
+class DirScanThread : public QThread
+{
+  public:
+    DirScanThread(DirScanner *scanner) : m_scanner(scanner) {}
+    void run()
+    {
+      Profiler::setThreadName("DirScanThread");
+      DirScan *s;
+      while ((s=m_scanner->nextJob()))
+      {
+        m_scanner->list(s);
+      }
+    }
+  private:
+    DirScanner *m_scanner;
+};
+
+DirScanner::DirScanner(const FilePatternMatcher *patterns,
+                       const FilePatternMatcher *exclPatterns,
+                       const DirWalk &walk,int numThreads)
+  : m_patterns(patterns), m_exclPatterns(exclPatterns),
+    m_recursive(walk.recursive), m_excludeSymlinks(walk.excludeSymlinks),
+    m_stopped(FALSE)
+{
+  m_workers.setAutoDelete(TRUE);
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  // only a recursive walk has directories to list ahead
+  int i;
+  for (i=0;i<numThreads && m_recursive;i++)
   {
-    dirName = resolveSymlink(dirName.data());
-    if (dirName.isEmpty()) return 0;            // recusive symlink
-    if (g_pathsVisited.find(dirName)) return 0; // already visited path
-    g_pathsVisited.insert(dirName,(void*)0x8);
+    DirScanThread *thread = new DirScanThread(this);
+    thread->start();
+    if (thread->isRunning())
+    {
+      m_workers.append(thread);
+    }
+    else // no more threads available!
+    {
+      delete thread;
+      break;
+    }
+  }
+#else
+  // QDir is used to list directories on Windows, which is not thread-safe
+  (void)numThreads;
+#endif
+}
+
+DirScanner::~DirScanner()
+{
+  {
+    QMutexLocker locker(&m_mutex);
+    m_stopped=TRUE;
+    m_notEmpty.wakeAll();
   }
-  QDir dir(dirName);
+  QListIterator<QThread> it(m_workers);
+  QThread *thread;
+  for (;(thread=it.current());++it)
+  {
+    thread->wait();
+  }
+}
+
+DirScan *DirScanner::nextJob()
+{
+  QMutexLocker locker(&m_mutex);
+  while (m_stack.isEmpty() && !m_stopped)
+  {
+    m_notEmpty.wait(&m_mutex);
+  }
+  if (m_stopped) return 0;
+  DirScan *s = m_stack.take(m_stack.count()-1);
+  s->state = DirScan::Listing;
+  return s;
+}
+
+DirScan *DirScanner::scan(const QCString &dirName)
+{
+  DirScan *s = new DirScan(dirName);
+  s->state = DirScan::Listing;
+  list(s);
+  return s;
+}
+
+void DirScanner::wait(DirScan *s)
+{
+  m_mutex.lock();
+  if (s->state==DirScan::Queued) // not started yet, list it ourselves
+  {
+    m_stack.removeRef(s);
+    s->state = DirScan::Listing;
+    m_mutex.unlock();
+    list(s);
+    return;
+  }
+  while (s->state!=DirScan::Done)
+  {
+    m_listed.wait(&m_mutex);
+  }
+  m_mutex.unlock();
+}
+
+void DirScanner::release(DirScan *s)
+{
+  {
+    QMutexLocker locker(&m_mutex);
+    if (s->state==DirScan::Queued) // not needed after all
+    {
+      m_stack.removeRef(s);
+      delete s;
+      return;
+    }
+    while (s->state!=DirScan::Done)
+    {
+      m_listed.wait(&m_mutex);
+    }
+  }
+  QListIterator<DirScanEntry> it(s->entries);
+  DirScanEntry *e;
+  for (;(e=it.current());++it)
+  {
+    if (e->subDir) release(e->subDir);
+  }
+  delete s;
+}
+
+void DirScanner::list(DirScan *s)
+{
+  readEntries(s);
+  QMutexLocker locker(&m_mutex);
+  if (m_workers.count()>0)
+  {
+    // queue the sub directories that readDir() will visit, the last one
+    // first, so the workers pick them up in the order of the walk
+    QListIterator<DirScanEntry> it(s->entries);
+    DirScanEntry *e;
+    for (it.toLast();(e=it.current());--it)
+    {
+      if (m_recursive && e->exists && e->readable && e->isDir &&
+          !e->isSymLink && e->matches && e->name.at(0)!='.')
+      {
+        QCString path = s->dirName=="/" ? "/"+e->name : s->dirName+"/"+e->name;
+        e->subDir = new DirScan(path);
+        m_stack.append(e->subDir);
+        m_notEmpty.wakeOne();
+      }
+    }
+  }
+  s->state = DirScan::Done;
+  m_listed.wakeAll();
+}
+
+void DirScanner::readEntries(DirScan *s)
+{
+  QList<DirScanEntry> entries;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  DIR *dir = opendir(s->dirName);
+  if (dir==0) return;
+  struct dirent *de;
+  int index=0;
+  while ((de=readdir(dir)))
+  {
+    const char *name = de->d_name;
+    if (name[0]=='.' && (name[1]==0 || (name[1]=='.' && name[2]==0))) continue;
+    DirScanEntry *e = new DirScanEntry(name,index++);
+    QCString path = s->dirName=="/" ? "/"+e->name : s->dirName+"/"+e->name;
+    struct stat st;
+#ifdef _DIRENT_HAVE_D_TYPE
+    // the type stored in the directory saves a call to lstat()
+    if (de->d_type==DT_DIR)
+    {
+      e->exists = e->isDir = TRUE;
+    }
+    else if (de->d_type==DT_REG)
+    {
+      e->exists = e->isFile = TRUE;
+    }
+    else
+#endif
+    if (lstat(path,&st)==0)
+    {
+      e->isSymLink = S_ISLNK(st.st_mode);
+      if (!e->isSymLink || stat(path,&st)==0)
+      {
+        e->exists = TRUE;
+        e->isFile = S_ISREG(st.st_mode);
+        e->isDir  = S_ISDIR(st.st_mode);
+        e->size   = (uint)st.st_size;
+      }
+    }
+    if (!e->isFile && !e->isDir) // not listed by QDir either
+    {
+      delete e;
+      continue;
+    }
+    e->readable = access(path,R_OK)==0;
+    if (e->isFile)
+    {
+      e->matches = (m_patterns==0 || m_patterns->match(e->name,path,path)) &&
+                   !m_exclPatterns->match(e->name,path,path);
+      if (e->matches && !e->isSymLink && stat(path,&st)==0) // size is needed
+      {
+        e->size = (uint)st.st_size;
+      }
+    }
+    else
+    {
+      e->matches = !m_exclPatterns->match(e->name,path,path);
+    }
+    entries.append(e);
+  }
+  closedir(dir);
+#else
+  QDir dir(s->dirName);
   dir.setFilter( QDir::Files | QDir::Dirs | QDir::Hidden );
-  int totalSize=0;
-  msg("Searching for files in directory %s\n", fi->absFilePath().data());
-  //printf("killDict=%p count=%d\n",killDict,killDict->count());
-  
   const QFileInfoList *list = dir.entryInfoList();
-  if (list)
+  if (list==0) return;
+  QFileInfoListIterator it( *list );
+  QFileInfo *cfi;
+  int index=0;
+  for (;(cfi=it.current());++it)
+  {
+    DirScanEntry *e = new DirScanEntry(cfi->fileName().utf8(),index++);
+    if (e->name=="." || e->name=="..")
+    {
+      delete e;
+      continue;
+    }
+    QCString path = cfi->absFilePath().utf8();
+    e->exists    = cfi->exists();
+    e->readable  = cfi->isReadable();
+    e->isFile    = cfi->isFile();
+    e->isDir     = cfi->isDir();
+    e->isSymLink = cfi->isSymLink();
+    e->size      = cfi->size();
+    if (e->isFile)
+    {
+      e->matches = (m_patterns==0 || m_patterns->match(e->name,path,path)) &&
+                   !m_exclPatterns->match(e->name,path,path);
+    }
+    else
+    {
+      e->matches = !m_exclPatterns->match(e->name,path,path);
+    }
+    entries.append(e);
+  }
+#endif
+  // sort like QDir::entryInfoList() does: by name, ignoring case
+  uint n = entries.count();
+  if (n>0)
   {
-    QFileInfoListIterator it( *list );
-    QFileInfo *cfi;
+    DirScanEntry **sorted = new DirScanEntry*[n];
+    uint i;
+    for (i=0;i<n;i++) sorted[i]=entries.at(i);
+    qsort(sorted,n,sizeof(DirScanEntry*),compareDirScanEntries);
+    for (i=0;i<n;i++) s->entries.append(sorted[i]);
+    delete[] sorted;
+  }
+}
 
-    while ((cfi=it.current()))
+//----------------------------------------------------------------------------
+
+// Adds the files of the directory at \a path to the dictionaries of \a walk.
+// \a s is the listing of the directory if it was made ahead, or 0.
+static int readDirWithScanner(DirScanner &scanner,const DirWalk &walk,
+                              const QCString &path,bool isSymLink,DirScan *s)
+{
+  QCString dirName = path;
+  if (walk.paths && walk.paths->find(dirName)==0)
+  {
+    walk.paths->insert(dirName,(void*)0x8);
+  }
+  if (isSymLink)
+  {
+    dirName = resolveSymlink(dirName.data());
+    if (dirName.isEmpty() ||                 // recusive symlink
+        g_pathsVisited.find(dirName))        // already visited path
     {
-      if (exclDict==0 || exclDict->find(cfi->absFilePath().utf8())==0) 
-      { // file should not be excluded
-        //printf("killDict->find(%s)\n",cfi->absFilePath().data());
-        if (!cfi->exists() || !cfi->isReadable())
+      if (s) scanner.release(s);
+      return 0;
+    }
+    g_pathsVisited.insert(dirName,(void*)0x8);
+  }
+  int totalSize=0;
+  msg("Searching for files in directory %s\n", path.data());
+  if (s)
+  {
+    scanner.wait(s);
+  }
+  else
+  {
+    s = scanner.scan(dirName);
+  }
+
+  QListIterator<DirScanEntry> it(s->entries);
+  DirScanEntry *e;
+  for (;(e=it.current());++it)
+  {
+    QCString absFilePath = dirName=="/" ? "/"+e->name : dirName+"/"+e->name;
+    if (walk.exclDict==0 || walk.exclDict->find(absFilePath)==0)
+    { // file should not be excluded
+      if (!e->exists || !e->readable)
+      {
+        if (walk.errorIfNotExist)
         {
-          if (errorIfNotExist)
-          {
-            warn_uncond("source %s is not a readable file or directory... skipping.\n",cfi->absFilePath().data());
-          }
+          warn_uncond("source %s is not a readable file or directory... skipping.\n",absFilePath.data());
         }
-        else if (cfi->isFile() && 
-            (!Config_getBool("EXCLUDE_SYMLINKS") || !cfi->isSymLink()) &&
-            (patList==0 || patternMatch(*cfi,patList)) && 
-            !patternMatch(*cfi,exclPatList) &&
-            (killDict==0 || killDict->find(cfi->absFilePath().utf8())==0)
-            )
+      }
+      else if (e->isFile &&
+          (!walk.excludeSymlinks || !e->isSymLink) &&
+          e->matches &&
+          (walk.killDict==0 || walk.killDict->find(absFilePath)==0)
+          )
+      {
+        totalSize+=e->size+absFilePath.length()+4;
+        QCString name=e->name;
+        //printf("New file %s\n",name.data());
+        if (walk.fnDict)
         {
-          totalSize+=cfi->size()+cfi->absFilePath().length()+4;
-          QCString name=cfi->fileName().utf8();
-          //printf("New file %s\n",name.data());
-          if (fnDict)
+          FileDef  *fd=new FileDef(dirName+"/",name);
+          FileName *fn=0;
+          if (!name.isEmpty() && (fn=(*walk.fnDict)[name]))
           {
-            FileDef  *fd=new FileDef(cfi->dirPath().utf8()+"/",name);
-            FileName *fn=0;
-            if (!name.isEmpty() && (fn=(*fnDict)[name]))
-            {
-              fn->append(fd);
-            }
-            else
-            {
-              fn = new FileName(cfi->absFilePath().utf8(),name);
-              fn->append(fd);
-              if (fnList) fnList->inSort(fn);
-              fnDict->insert(name,fn);
-            }
+            fn->append(fd);
           }
-          QCString *rs=0;
-          if (resultList || resultDict)
+          else
           {
-            rs=new QCString(cfi->absFilePath().utf8());
+            fn = new FileName(absFilePath,name);
+            fn->append(fd);
+            if (walk.fnList) walk.fnList->append(fn); // sorted when all input is read
+            walk.fnDict->insert(name,fn);
           }
-          if (resultList) resultList->append(rs);
-          if (resultDict) resultDict->insert(cfi->absFilePath().utf8(),rs);
-          if (killDict) killDict->insert(cfi->absFilePath().utf8(),(void *)0x8);
-        }
-        else if (recursive &&
-            (!Config_getBool("EXCLUDE_SYMLINKS") || !cfi->isSymLink()) &&
-            cfi->isDir() && 
-            !patternMatch(*cfi,exclPatList) &&
-            cfi->fileName().at(0)!='.') // skip "." ".." and ".dir"
-        {
-          cfi->setFile(cfi->absFilePath());
-          totalSize+=readDir(cfi,fnList,fnDict,exclDict,
-              patList,exclPatList,resultList,resultDict,errorIfNotExist,
-              recursive,killDict,paths);
         }
+        QCString *rs=0;
+        if (walk.resultList || walk.resultDict)
+        {
+          rs=new QCString(absFilePath);
+        }
+        if (walk.resultList) walk.resultList->append(rs);
+        if (walk.resultDict) walk.resultDict->insert(absFilePath,rs);
+        if (walk.killDict) walk.killDict->insert(absFilePath,(void *)0x8);
+      }
+      else if (walk.recursive &&
+          (!walk.excludeSymlinks || !e->isSymLink) &&
+          e->isDir && 
+          e->matches &&
+          e->name.at(0)!='.') // skip "." ".." and ".dir"
+      {
+        totalSize+=readDirWithScanner(scanner,walk,absFilePath,e->isSymLink,e->subDir);
+        e->subDir=0;
       }
-      ++it;
     }
   }
+  scanner.release(s);
+  return totalSize;
+}
+
+//----------------------------------------------------------------------------
+// Read all files matching at least one pattern in `patList' in the 
+// directory represented by `fi'.
+// The directory is read iff the recusiveFlag is set.
+// The contents of all files is append to the input string
+
+int readDir(QFileInfo *fi,
+            FileNameList *fnList,
+            FileNameDict *fnDict,
+            StringDict  *exclDict,
+            QStrList *patList,
+            QStrList *exclPatList,
+            StringList *resultList,
+            StringDict *resultDict,
+            bool errorIfNotExist,
+            bool recursive,
+            QDict<void> *killDict,
+            QDict<void> *paths
+           )
+{
+  //printf("killDict=%p count=%d\n",killDict,killDict->count());
+  DirWalk walk;
+  walk.fnList          = fnList;
+  walk.fnDict          = fnDict;
+  walk.exclDict        = exclDict;
+  walk.resultList      = resultList;
+  walk.resultDict      = resultDict;
+  walk.errorIfNotExist = errorIfNotExist;
+  walk.recursive       = recursive;
+  walk.excludeSymlinks = Config_getBool("EXCLUDE_SYMLINKS");
+  walk.killDict        = killDict;
+  walk.paths           = paths;
+  // compile the patterns once for the whole tree
+  FilePatternMatcher *patterns = patList ? new FilePatternMatcher(patList) : 0;
+  FilePatternMatcher exclPatterns(exclPatList);
+  int numThreads = numProcThreads();
+  DirScanner scanner(patterns,&exclPatterns,walk,numThreads>1 ? numThreads : 0);
+  int totalSize = readDirWithScanner(scanner,walk,fi->absFilePath().utf8(),
+                                     fi->isSymLink(),0);
+  delete patterns;
   return totalSize;
 }
 
@@ -9573,7 +10245,7 @@ int readFileOrDirectory(const char *s,
               {
                 fn = new FileName(filePath,name);
                 fn->append(fd);
-                if (fnList) fnList->inSort(fn);
+                if (fnList) fnList->append(fn); // sorted when all input is read
                 fnDict->insert(name,fn);
               }
             }
@@ -9779,6 +10451,8 @@ static void devUsage()
   msg("  -m          dump symbol map\n");
   msg("  -b          output to wizard\n");
   msg("  -T          activates output generation via Django like template\n");
+  msg("  -t <file>   write a trace of where the time is spent to <file>, which can be\n"
+      "              viewed with chrome://tracing\n");
   msg("  -d <level>  enable a debug level, such as (multiple invocations of -d are possible):\n");
   Debug::printFlags();
 }
@@ -10250,6 +10924,16 @@ void readConfiguration(int argc, char **argv)
             "Only use if you are a doxygen developer\n");
         g_useOutputTemplate=TRUE;
         break;
+      case 't':
+        g_traceFile=getArg(argc,argv,optind);
+        if (g_traceFile.isEmpty())
+        {
+          err("option \"-t\" is missing a file name.\n");
+          devUsage();
+          cleanUpDoxygen();
+          exit(1);
+        }
+        break;
       case 'h':
       case '?':
         usage(argv[0]);
@@ -10262,6 +10946,11 @@ void readConfiguration(int argc, char **argv)
     }
     optind++;
   }
+
+  if (Debug::isFlagSet(Debug::Time) || !g_traceFile.isEmpty())
+  {
+    Profiler::enable();
+  }
   
   /**************************************************************************
    *            Parse or generate the config file                           *
@@ -10639,6 +11328,7 @@ void searchInputFiles()
     }
     s=inputList.next();
   }
+  Doxygen::inputNameList->sort();
   delete killDict;
   g_s.end();
 }
@@ -10691,8 +11381,7 @@ void parseInput()
   if (cacheSize<0) cacheSize=0;
   if (cacheSize>9) cacheSize=9;
   uint lookupSize = 65536 << cacheSize;
-  Doxygen::lookupCache = new QCache<LookupInfo>(lookupSize,lookupSize);
-  Doxygen::lookupCache->setAutoDelete(TRUE);
+  Doxygen::lookupCache = new LookupCache(lookupSize);
 
 #ifdef HAS_SIGNALS
   signal(SIGINT, stopDoxygen);
@@ -10716,6 +11405,15 @@ void parseInput()
    *            Check/create output directorties                            *
    **************************************************************************/
 
+  if (!Config_getString("FILTER_CACHE_DIR").isEmpty())
+    createOutputDirectory(outputDirectory,"FILTER_CACHE_DIR","");
+  if (Config_getBool("HAVE_DOT") && !Config_getString("DOT_CACHE_DIR").isEmpty())
+    createOutputDirectory(outputDirectory,"DOT_CACHE_DIR","");
+  if (!Config_getString("TAGFILE_CACHE_DIR").isEmpty())
+    createOutputDirectory(outputDirectory,"TAGFILE_CACHE_DIR","");
+  if (Config_getBool("ENABLE_PREPROCESSING") && !Config_getString("MACRO_CACHE_DIR").isEmpty())
+    createOutputDirectory(outputDirectory,"MACRO_CACHE_DIR","");
+
   QCString htmlOutput;
   bool &generateHtml = Config_getBool("GENERATE_HTML");
   if (generateHtml)
@@ -10827,6 +11525,7 @@ void parseInput()
 
   g_storage = new FileStorage;
   g_storage->setName(Doxygen::entryDBFileName);
+  g_storage->setCompressed(Config_getBool("COMPRESS_TEMP_STORAGE"));
   if (!g_storage->open(IO_WriteOnly))
   {
     err("Failed to create temporary storage file %s\n",
@@ -10858,8 +11557,10 @@ void parseInput()
 
   g_s.begin("Parsing files\n");
   parseFiles(root,rootNav);
+  g_s.step("Closing entry storage");
   g_storage->close();
   g_s.end();
+  g_storage->printStats();
 
   // we are done with input scanning now, so free up the buffers used by flex
   // (can be around 4MB)
@@ -10903,9 +11604,11 @@ void parseInput()
   g_s.end();
 
   g_s.begin("Associating documentation with classes...\n");
+  g_s.step("buildClassDocList");
   buildClassDocList(rootNav);
 
   // build list of using declarations here (global list)
+  g_s.step("buildListOfUsingDecls");
   buildListOfUsingDecls(rootNav);
   g_s.end();
 
@@ -10955,6 +11658,7 @@ void parseInput()
 
   g_s.begin("Building interface member list...\n");
   buildInterfaceAndServiceList(rootNav); // UNO IDL
+  g_s.end();
 
   g_s.begin("Building member list...\n"); // using class info only !
   buildFunctionList(rootNav);
@@ -10993,12 +11697,16 @@ void parseInput()
   g_s.end();
 
   g_s.begin("Computing class relations...\n");
+  g_s.step("computeTemplateClassRelations");
   computeTemplateClassRelations();
+  g_s.step("flushUnresolvedRelations");
   flushUnresolvedRelations();
   if (Config_getBool("OPTIMIZE_OUTPUT_VHDL"))
   {
+    g_s.step("computeVhdlComponentRelations");
     VhdlDocGen::computeVhdlComponentRelations(); 
   }
+  g_s.step("computeClassRelations");
   computeClassRelations();
   g_classEntries.clear();
   g_s.end();
@@ -11009,10 +11717,14 @@ void parseInput()
   g_s.end();
 
   g_s.begin("Searching for member function documentation...\n");
+  g_s.step("findObjCMethodDefinitions");
   findObjCMethodDefinitions(rootNav);
+  g_s.step("findMemberDocumentation");
   findMemberDocumentation(rootNav); // may introduce new members !
 
+  g_s.step("transferRelatedFunctionDocumentation");
   transferRelatedFunctionDocumentation();
+  g_s.step("transferFunctionDocumentation");
   transferFunctionDocumentation();
   g_s.end();
 
@@ -11034,9 +11746,13 @@ void parseInput()
   g_s.end();
 
   g_s.begin("Sorting lists...\n");
+  g_s.step("memberNameSDict");
   Doxygen::memberNameSDict->sort();
+  g_s.step("functionNameSDict");
   Doxygen::functionNameSDict->sort();
+  g_s.step("hiddenClasses");
   Doxygen::hiddenClasses->sort();
+  g_s.step("classSDict");
   Doxygen::classSDict->sort();
   g_s.end();
 
@@ -11054,7 +11770,9 @@ void parseInput()
   g_s.end();
 
   g_s.begin("Computing member relations...\n");
+  g_s.step("mergeCategories");
   mergeCategories();
+  g_s.step("computeMemberRelations");
   computeMemberRelations();
   g_s.end();
 
@@ -11095,7 +11813,9 @@ void parseInput()
   g_s.end();
 
   g_s.begin("Adding xrefitems...\n");
+  g_s.step("addListReferences");
   addListReferences();
+  g_s.step("generateXRefPages");
   generateXRefPages();
   g_s.end();
 
@@ -11141,6 +11861,10 @@ void parseInput()
   addMembersToIndex();
   g_s.end();
 
+  // all definitions have been created, the strings they interned
+  // no longer need to be in the pool
+  QCString::clearInternPool();
+
   if (Config_getBool("OPTIMIZE_OUTPUT_VHDL") && 
       Config_getBool("HAVE_DOT") &&
       Config_getEnum("DOT_IMAGE_FORMAT")=="svg")
@@ -11164,6 +11888,10 @@ void generateOutput()
 
   initSearchIndexer();
 
+  int maxProcesses = Config_getInt("MAX_EXTERNAL_PROCESSES");
+  if (maxProcesses==0) maxProcesses = QMAX(1,QThread::idealThreadCount());
+  portable_setMaxProcesses(maxProcesses);
+
   bool generateHtml  = Config_getBool("GENERATE_HTML");
   bool generateLatex = Config_getBool("GENERATE_LATEX");
   bool generateMan   = Config_getBool("GENERATE_MAN");
@@ -11423,6 +12151,15 @@ void generateOutput()
         searchDataFile.prepend(Config_getString("OUTPUT_DIRECTORY")+"/");
       }
       Doxygen::searchIndex->write(searchDataFile);
+      QCString searchIndexFile = Config_getString("SEARCHDATA_INDEX");
+      if (!searchIndexFile.isEmpty())
+      {
+        if (!portable_isAbsolutePath(searchIndexFile))
+        {
+          searchIndexFile.prepend(Config_getString("OUTPUT_DIRECTORY")+"/");
+        }
+        ((SearchIndexExternal*)Doxygen::searchIndex)->writeCompactIndex(searchIndexFile);
+      }
     }
     g_s.end();
   }
@@ -11484,17 +12221,27 @@ void generateOutput()
   }
 
   int cacheParam;
-  msg("lookup cache used %d/%d hits=%d misses=%d\n",
+  msg("lookup cache used %d/%d hits=%d misses=%d evictions=%d\n",
       Doxygen::lookupCache->count(),
       Doxygen::lookupCache->size(),
       Doxygen::lookupCache->hits(),
-      Doxygen::lookupCache->misses());
+      Doxygen::lookupCache->misses(),
+      Doxygen::lookupCache->evictions());
   cacheParam = computeIdealCacheParam(Doxygen::lookupCache->misses()*2/3); // part of the cache is flushed, hence the 2/3 correction factor
   if (cacheParam>Config_getInt("LOOKUP_CACHE_SIZE"))
   {
     msg("Note: based on cache misses the ideal setting for LOOKUP_CACHE_SIZE is %d at the cost of higher memory usage.\n",cacheParam);
   }
 
+  portable_printProcessStats();
+
+  if (!g_traceFile.isEmpty())
+  {
+    Profiler::counter("peak RSS (kB)",portable_peakMemoryUsage());
+    msg("Writing trace to %s...\n",g_traceFile.data());
+    Profiler::writeTrace(g_traceFile);
+  }
+
   if (Debug::isFlagSet(Debug::Time))
   {
     msg("Total elapsed time: %.3f seconds\n(of which %.3f seconds waiting for external tools to finish)\n",
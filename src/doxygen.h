@@ -20,7 +20,6 @@
 #define DOXYGEN_H
 
 #include <qdatetime.h>
-#include <qcache.h>
 #include <qstrlist.h>
 #include <qdict.h>
 #include <qintdict.h>
@@ -61,6 +60,7 @@ class IndexList;
 class FormulaList;
 class FormulaDict;
 class FormulaNameDict;
+class LookupCache;
 class SectionDict;
 struct MemberGroupInfo;
 
@@ -75,17 +75,6 @@ class StringDict : public QDict<QCString>
     virtual ~StringDict() {}
 };
 
-struct LookupInfo
-{
-  LookupInfo() : classDef(0), typeDef(0) {}
-  LookupInfo(ClassDef *cd,MemberDef *td,QCString ts,QCString rt) 
-    : classDef(cd), typeDef(td), templSpec(ts),resolvedType(rt) {}
-  ClassDef  *classDef;
-  MemberDef *typeDef;
-  QCString   templSpec;
-  QCString   resolvedType;
-};
-
 extern QCString g_spaces;
 
 /*! \brief This class serves as a namespace for global variables used by doxygen.
@@ -135,7 +124,7 @@ class Doxygen
     static QDict<Definition>        *clangUsrMap;
     static bool                      outputToWizard;
     static QDict<int>               *htmlDirMap;
-    static QCache<LookupInfo>       *lookupCache;
+    static LookupCache              *lookupCache;
     static DirSDict                 *directories;
     static SDict<DirRelation>        dirRelations;
     static ParserManager            *parserManager;
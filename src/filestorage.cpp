@@ -0,0 +1,448 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2013 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "filestorage.h"
+#include "message.h"
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#define FILESTORAGE_USE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define FILESTORAGE_USE_MMAP 0
+#endif
+
+// Size of an uncompressed block, the offset in a block is stored in the
+// lower bits of a position, so this needs to be a power of 2.
+#define COMPRESSED_BLOCK_BITS   16
+#define COMPRESSED_BLOCK_SIZE   (1<<COMPRESSED_BLOCK_BITS)
+// Each block is preceded by a header with the compressed and the
+// uncompressed size. If both are equal the block is stored uncompressed.
+#define BLOCK_HEADER_SIZE       8
+
+//------------------------------------------------------------------------
+// A small LZ77 style compressor using the LZ4 block format: a sequence of
+// (literal run, back reference) pairs, optimized for speed rather than
+// for compression ratio.
+
+#define LZ_MINMATCH   4
+#define LZ_HASH_BITS  12
+#define LZ_MAX_OFFSET 65535
+
+static inline uint lzRead32(const uchar *p)
+{
+  uint v;
+  memcpy(&v,p,4);
+  return v;
+}
+
+static inline uint lzHash(const uchar *p)
+{
+  return (lzRead32(p)*2654435761U)>>(32-LZ_HASH_BITS);
+}
+
+static inline uchar *lzWriteLength(uchar *op,uint len)
+{
+  while (len>=255)
+  {
+    *op++=255;
+    len-=255;
+  }
+  *op++=(uchar)len;
+  return op;
+}
+
+/*! Returns the maximum size of the compressed form of \a len bytes. */
+static inline uint lzCompressBound(uint len)
+{
+  return len+len/255+16;
+}
+
+/*! Compresses \a len bytes from \a source into \a dest, which should
+ *  be at least lzCompressBound(len) bytes large.
+ *  Returns the size of the compressed data.
+ */
+static uint lzCompress(const char *source,uint len,char *dest)
+{
+  const uchar *src    = (const uchar *)source;
+  const uchar *ip     = src;
+  const uchar *anchor = src;
+  const uchar *iend   = src+len;
+  uchar *op = (uchar *)dest;
+  if (len>12)
+  {
+    // the format requires that the last 5 bytes are literals and that
+    // the last match starts at least 12 bytes before the end.
+    const uchar *mflimit    = iend-12;
+    const uchar *matchlimit = iend-5;
+    uint table[1<<LZ_HASH_BITS];
+    memset(table,0,sizeof(table));
+    while (ip<mflimit)
+    {
+      uint h = lzHash(ip);
+      const uchar *ref = src+table[h];
+      table[h] = (uint)(ip-src);
+      if (ref<ip && ip-ref<=LZ_MAX_OFFSET && lzRead32(ref)==lzRead32(ip))
+      {
+        // extend the match
+        const uchar *mp = ip+LZ_MINMATCH;
+        const uchar *rp = ref+LZ_MINMATCH;
+        while (mp<matchlimit && *mp==*rp) mp++,rp++;
+        uint litLen   = (uint)(ip-anchor);
+        uint matchLen = (uint)(mp-ip)-LZ_MINMATCH;
+        uint offset   = (uint)(ip-ref);
+        // token
+        uchar *token = op++;
+        *token = (uchar)(((litLen>=15 ? 15 : litLen)<<4) | (matchLen>=15 ? 15 : matchLen));
+        // literals
+        if (litLen>=15) op=lzWriteLength(op,litLen-15);
+        memcpy(op,anchor,litLen);
+        op+=litLen;
+        // back reference
+        *op++=(uchar)(offset&0xff);
+        *op++=(uchar)(offset>>8);
+        if (matchLen>=15) op=lzWriteLength(op,matchLen-15);
+        ip = anchor = mp;
+      }
+      else
+      {
+        ip++;
+      }
+    }
+  }
+  // the remaining bytes are literals
+  uint litLen = (uint)(iend-anchor);
+  *op++ = (uchar)((litLen>=15 ? 15 : litLen)<<4);
+  if (litLen>=15) op=lzWriteLength(op,litLen-15);
+  memcpy(op,anchor,litLen);
+  op+=litLen;
+  return (uint)(op-(uchar *)dest);
+}
+
+/*! Decompresses \a len bytes from \a source into \a dest, which has room
+ *  for \a maxLen bytes. Returns the size of the decompressed data or
+ *  -1 if the data is corrupt.
+ */
+static int lzDecompress(const char *source,uint len,char *dest,uint maxLen)
+{
+  const uchar *ip   = (const uchar *)source;
+  const uchar *iend = ip+len;
+  uchar *dst  = (uchar *)dest;
+  uchar *op   = dst;
+  uchar *oend = dst+maxLen;
+  while (ip<iend)
+  {
+    uint token  = *ip++;
+    uint litLen = token>>4;
+    if (litLen==15)
+    {
+      uint s;
+      do
+      {
+        if (ip>=iend) return -1;
+        s = *ip++;
+        litLen+=s;
+      }
+      while (s==255);
+    }
+    if (litLen>(uint)(iend-ip) || litLen>(uint)(oend-op)) return -1;
+    memcpy(op,ip,litLen);
+    op+=litLen;
+    ip+=litLen;
+    if (ip>=iend) break; // last sequence has no back reference
+    if (iend-ip<2) return -1;
+    uint offset = ip[0] | (ip[1]<<8);
+    ip+=2;
+    if (offset==0 || offset>(uint)(op-dst)) return -1;
+    uint matchLen = token&15;
+    if (matchLen==15)
+    {
+      uint s;
+      do
+      {
+        if (ip>=iend) return -1;
+        s = *ip++;
+        matchLen+=s;
+      }
+      while (s==255);
+    }
+    matchLen+=LZ_MINMATCH;
+    if (matchLen>(uint)(oend-op)) return -1;
+    const uchar *ref = op-offset;
+    if (offset>=matchLen)
+    {
+      memcpy(op,ref,matchLen);
+      op+=matchLen;
+    }
+    else // overlapping copy
+    {
+      while (matchLen--) *op++=*ref++;
+    }
+  }
+  return (int)(op-dst);
+}
+
+//------------------------------------------------------------------------
+
+FileStorage::FileStorage()
+  : m_readOnly(FALSE), m_map(0), m_off(0), m_size(0),
+    m_compressed(FALSE), m_block(0), m_cbuf(0), m_blockLen(0), m_blockOff(0),
+    m_blockPos(-1), m_nextBlockPos(0), m_rawBytes(0), m_storedBytes(0),
+    m_numBlocks(0)
+{
+}
+
+FileStorage::FileStorage( const QString &name)
+  : m_readOnly(FALSE), m_map(0), m_off(0), m_size(0),
+    m_compressed(FALSE), m_block(0), m_cbuf(0), m_blockLen(0), m_blockOff(0),
+    m_blockPos(-1), m_nextBlockPos(0), m_rawBytes(0), m_storedBytes(0),
+    m_numBlocks(0)
+{
+  m_file.setName(name);
+}
+
+FileStorage::~FileStorage()
+{
+  close();
+}
+
+bool FileStorage::open( int m )
+{
+  m_readOnly = m==IO_ReadOnly;
+  if (!m_file.open(m)) return FALSE;
+  if (m_compressed)
+  {
+    if (m_block==0) m_block = (char*)malloc(COMPRESSED_BLOCK_SIZE);
+    if (m_cbuf==0)  m_cbuf  = (char*)malloc(lzCompressBound(COMPRESSED_BLOCK_SIZE));
+    m_blockLen = 0;
+    m_blockOff = 0;
+    m_blockPos = m_readOnly ? -1 : 0;
+    m_nextBlockPos = 0;
+  }
+  if (m_readOnly) map();
+  return TRUE;
+}
+
+void FileStorage::close()
+{
+  if (m_compressed && !m_readOnly && m_file.isOpen())
+  {
+    flushBlock();
+  }
+  unmap();
+  m_file.close();
+  free(m_block); m_block=0;
+  free(m_cbuf);  m_cbuf=0;
+}
+
+int FileStorage::write(const char *buf,uint size)
+{
+  assert(m_readOnly==FALSE);
+  if (!m_compressed)
+  {
+    return m_file.writeBlock(buf,size);
+  }
+  uint written=0;
+  while (written<size)
+  {
+    uint n = QMIN(size-written,COMPRESSED_BLOCK_SIZE-m_blockLen);
+    memcpy(m_block+m_blockLen,buf+written,n);
+    m_blockLen+=n;
+    written+=n;
+    if (m_blockLen==COMPRESSED_BLOCK_SIZE && !flushBlock()) return -1;
+  }
+  return size;
+}
+
+int FileStorage::read(char *buf,uint size)
+{
+  if (!m_compressed)
+  {
+    return rawRead(buf,size);
+  }
+  uint numRead=0;
+  while (numRead<size)
+  {
+    if (m_blockOff==m_blockLen) // continue in the next block
+    {
+      if (m_blockPos==-1 || !loadBlock(m_nextBlockPos)) break;
+    }
+    uint n = QMIN(size-numRead,m_blockLen-m_blockOff);
+    memcpy(buf+numRead,m_block+m_blockOff,n);
+    m_blockOff+=n;
+    numRead+=n;
+  }
+  return numRead;
+}
+
+bool FileStorage::seek(int64 pos)
+{
+  if (!m_compressed)
+  {
+    return rawSeek(pos);
+  }
+  int64 blockPos = pos>>COMPRESSED_BLOCK_BITS;
+  uint  blockOff = (uint)(pos&(COMPRESSED_BLOCK_SIZE-1));
+  if (blockPos!=m_blockPos && !loadBlock(blockPos)) return FALSE;
+  if (blockOff>m_blockLen) return FALSE;
+  m_blockOff = blockOff;
+  return TRUE;
+}
+
+int64 FileStorage::pos() const
+{
+  if (!m_compressed)
+  {
+    return rawPos();
+  }
+  uint blockOff = m_readOnly ? m_blockOff : m_blockLen;
+  return (m_blockPos<<COMPRESSED_BLOCK_BITS)+blockOff;
+}
+
+void FileStorage::printStats()
+{
+  if (m_compressed && m_rawBytes>0)
+  {
+    msg("Temporary storage: %u blocks, %.1f MB of data stored in %.1f MB (ratio %.2f)\n",
+        m_numBlocks,(double)m_rawBytes/(1024.0*1024.0),
+        (double)m_storedBytes/(1024.0*1024.0),
+        (double)m_rawBytes/(double)m_storedBytes);
+  }
+}
+
+//------------------------------------------------------------------------
+
+/*! Compresses and writes the current block. */
+bool FileStorage::flushBlock()
+{
+  if (m_blockLen==0) return TRUE;
+  uint cLen = lzCompress(m_block,m_blockLen,m_cbuf);
+  const char *data = m_cbuf;
+  if (cLen>=m_blockLen) // store uncompressed
+  {
+    cLen = m_blockLen;
+    data = m_block;
+  }
+  uint header[2] = { cLen, m_blockLen };
+  if (m_file.writeBlock((const char *)header,BLOCK_HEADER_SIZE)!=BLOCK_HEADER_SIZE ||
+      m_file.writeBlock(data,cLen)!=(int)cLen)
+  {
+    err("Failed to write to temporary storage file %s\n",m_file.name().data());
+    return FALSE;
+  }
+  m_rawBytes    += m_blockLen;
+  m_storedBytes += cLen+BLOCK_HEADER_SIZE;
+  m_numBlocks++;
+  m_blockPos    += cLen+BLOCK_HEADER_SIZE;
+  m_blockLen     = 0;
+  return TRUE;
+}
+
+/*! Reads and decompresses the block stored at file offset \a pos. */
+bool FileStorage::loadBlock(int64 pos)
+{
+  uint header[2];
+  if (!rawSeek(pos) || rawRead((char *)header,BLOCK_HEADER_SIZE)!=BLOCK_HEADER_SIZE)
+  {
+    return FALSE;
+  }
+  uint cLen = header[0], len = header[1];
+  if (len>COMPRESSED_BLOCK_SIZE || cLen>len) return FALSE;
+  if (cLen==len) // stored uncompressed
+  {
+    if (rawRead(m_block,len)!=(int)len) return FALSE;
+  }
+  else
+  {
+    const char *data = m_cbuf;
+    if (m_map) // decompress directly from the mapping
+    {
+      if (m_off+(int64)cLen>m_size) return FALSE;
+      data = m_map+m_off;
+    }
+    else if (rawRead(m_cbuf,cLen)!=(int)cLen)
+    {
+      return FALSE;
+    }
+    if (lzDecompress(data,cLen,m_block,COMPRESSED_BLOCK_SIZE)!=(int)len) return FALSE;
+  }
+  m_blockPos     = pos;
+  m_nextBlockPos = pos+BLOCK_HEADER_SIZE+cLen;
+  m_blockLen     = len;
+  m_blockOff     = 0;
+  return TRUE;
+}
+
+//------------------------------------------------------------------------
+
+int FileStorage::rawRead(char *buf,uint size)
+{
+  if (m_map)
+  {
+    if (m_off+(int64)size>m_size) size=(uint)(m_size-m_off);
+    memcpy(buf,m_map+m_off,size);
+    m_off+=size;
+    return size;
+  }
+  return m_file.readBlock(buf,size);
+}
+
+bool FileStorage::rawSeek(int64 pos)
+{
+  if (m_map)
+  {
+    if (pos<0 || pos>m_size) return FALSE;
+    m_off=pos;
+    return TRUE;
+  }
+  return m_file.seek(pos);
+}
+
+int64 FileStorage::rawPos() const
+{
+  return m_map ? m_off : m_file.pos();
+}
+
+void FileStorage::map()
+{
+#if FILESTORAGE_USE_MMAP
+  struct stat st;
+  if (fstat(m_file.handle(),&st)!=0 || st.st_size<=0) return;
+  if ((uint64)st.st_size>(uint64)(size_t)-1) return; // does not fit
+  void *p = mmap(NULL,(size_t)st.st_size,PROT_READ,MAP_SHARED,m_file.handle(),0);
+  if (p==MAP_FAILED) return; // fall back to normal file reading
+  m_map  = (const char *)p;
+  m_size = st.st_size;
+  m_off  = 0;
+#endif
+}
+
+void FileStorage::unmap()
+{
+#if FILESTORAGE_USE_MMAP
+  if (m_map)
+  {
+    munmap((void *)m_map,(size_t)m_size);
+  }
+#endif
+  m_map  = 0;
+  m_off  = 0;
+  m_size = 0;
+}
@@ -3,8 +3,8 @@
  * Copyright (C) 1997-2013 by Dimitri van Heesch.
  *
  * Permission to use, copy, modify, and distribute this software and its
- * documentation under the terms of the GNU General Public License is hereby 
- * granted. No representations are made about the suitability of this software 
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
  * for any purpose. It is provided "as is" without express or implied warranty.
  * See the GNU General Public License for more details.
  *
@@ -21,115 +21,69 @@
 #ifndef FILESTORAGE_H
 #define FILESTORAGE_H
 
-/** @brief Store implementation based on a file. 
+/** @brief Store implementation based on a file.
     Writing is linear, after that the file is re-opened for reading.
     Reading is random (seek+read).
- */
-class FileStorage : public StorageIntf
-{
-  public:
-    FileStorage() : m_readOnly(FALSE) {}
-    FileStorage( const QString &name) : 
-                    m_readOnly(FALSE)    { m_file.setName(name); }
-    int read(char *buf,uint size)        { return m_file.readBlock(buf,size); }
-    int write(const char *buf,uint size) { assert(m_readOnly==FALSE); return m_file.writeBlock(buf,size); }
-    bool open( int m )                   { m_readOnly = m==IO_ReadOnly; return m_file.open(m); }
-    bool seek(int64 pos)                 { return m_file.seek(pos); }
-    int64 pos() const                    { return m_file.pos(); }
-    void close()                         { m_file.close(); }
-    void setName( const char *name )     { m_file.setName(name); }
-  private:
-    bool m_readOnly;
-    QFile m_file;
-};
 
-#if 0 // experimental version using mmap after opening the file as read only.
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <string.h>
-#include <unistd.h>
-#include <stdio.h>
+    When the file is opened for reading it is mapped into memory if the
+    platform supports it, so a seek+read sequence becomes a pointer update
+    and a memcpy instead of a sequence of stdio calls. If the file cannot
+    be mapped (for instance because it does not fit in the address space)
+    the file is read via QFile instead. Offsets are 64 bit in both modes.
 
+    Optionally the data can be stored compressed. It is then written as a
+    sequence of independently compressed blocks, and the positions returned
+    by pos() encode both the file offset of a block and the offset within
+    the uncompressed block. Such positions can only be used with seek().
+ */
 class FileStorage : public StorageIntf
 {
   public:
-    FileStorage() : m_readOnly(FALSE), m_map(0), m_off(0), m_size(0) {}
-    FileStorage( const QString &name) : 
-                    m_readOnly(FALSE)    { m_file.setName(name); }
+    FileStorage();
+    FileStorage( const QString &name);
+   ~FileStorage();
+    int read(char *buf,uint size);
+    int write(const char *buf,uint size);
+    bool open( int m );
+    bool seek(int64 pos);
+    int64 pos() const;
+    void close();
     void setName( const char *name )     { m_file.setName(name); }
-    bool open( int m )                   
-    { 
-      if (m==IO_ReadOnly)
-      {
-        m_readOnly=TRUE;
-        QString name = m_file.name();
-        m_file.close();
-        m_fd = ::open(name.data(),O_RDONLY);
-        struct stat stat;
-        fstat(m_fd,&stat);
-        m_size = stat.st_size;
-        m_map = mmap(NULL,m_size,PROT_READ,MAP_SHARED,m_fd,0);
-        if (m_map==MAP_FAILED) perror("mmap failed");
-        assert(m_map!=MAP_FAILED);
-        m_off = 0;
-        return TRUE;
-      }
-      else
-      {
-        m_readOnly = FALSE;
-        return m_file.open(m); 
-      }
-    }
-    int write(const char *buf,uint size) 
-    { 
-      assert(m_map==0);
-      return m_file.writeBlock(buf,size); 
-    }
-    int read(char *buf,uint size)        
-    { 
-      assert(m_map!=0);
-      memcpy(buf,((char *)m_map)+m_off,size); 
-      m_off+=size; 
-      return size; 
-    }
-    bool seek(int64 pos)                 
-    { 
-      m_off=pos; 
-      return TRUE; 
-    }
-    int64 pos() const                    
-    { 
-      if (m_readOnly)
-      {
-        return m_off; 
-      }
-      else
-      {
-        return m_file.pos();
-      }
-    }
-    void close()                         
-    { 
-      if (m_readOnly)
-      {
-        munmap(m_map,m_size); 
-        ::close(m_fd);
-        exit(1);
-      }
-      else
-      {
-        m_file.close();
-      }
-    }
+    /*! Enables or disables compression. Must be called before the
+     *  file is opened for writing, and kept the same for reading.
+     */
+    void setCompressed(bool b)           { m_compressed=b; }
+    bool isCompressed() const            { return m_compressed; }
+    /*! Returns TRUE if the file is read via a memory mapping. */
+    bool isMapped() const                { return m_map!=0; }
+    void printStats();
+
   private:
+    int   rawRead(char *buf,uint size);
+    bool  rawSeek(int64 pos);
+    int64 rawPos() const;
+    void  map();
+    void  unmap();
+    bool  flushBlock();
+    bool  loadBlock(int64 pos);
+
     bool m_readOnly;
     QFile m_file;
-    int m_fd;
-    void *m_map;
-    off_t m_off;
-    off_t m_size;
+    const char *m_map;
+    int64 m_off;
+    int64 m_size;
+
+    // compression related state
+    bool   m_compressed;
+    char  *m_block;        // uncompressed data of the current block
+    char  *m_cbuf;         // buffer for compressed data
+    uint   m_blockLen;     // number of valid bytes in m_block
+    uint   m_blockOff;     // read or write position in m_block
+    int64  m_blockPos;     // file offset of the current block
+    int64  m_nextBlockPos; // file offset of the block following the current one
+    uint64 m_rawBytes;     // number of uncompressed bytes written
+    uint64 m_storedBytes;  // number of bytes written to the file
+    uint   m_numBlocks;    // number of blocks written
 };
-#endif
 
 #endif
@@ -1027,7 +1027,7 @@ static QCString getSearchBox(bool serverSide, QCString relPath, bool highlightSe
 static QCString removeEmptyLines(const QCString &s)
 {
   BufStr out(s.length()+1);
-  char *p=s.data();
+  const char *p=s.data();
   if (p)
   {
     char c;
@@ -1035,7 +1035,7 @@ static QCString removeEmptyLines(const QCString &s)
     {
       if (c=='\n')
       {
-        char *e = p;
+        const char *e = p;
         while (*e==' ' || *e=='\t') e++;
         if (*e=='\n') 
         {
@@ -583,7 +583,7 @@ QCString HtmlHelp::recode(const QCString &s)
   QCString output(oSize);
   size_t iLeft     = iSize;
   size_t oLeft     = oSize;
-  char *iPtr       = s.data();
+  char *iPtr       = (char *)s.data(); // iconv does not modify the input
   char *oPtr       = output.data();
   if (!portable_iconv(m_fromUtf8,&iPtr,&iLeft,&oPtr,&oLeft))
   {
@@ -0,0 +1,319 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2013 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <string.h>
+
+#include "lookupcache.h"
+
+// number of shards, should be a power of 2
+#define NUM_SHARDS 16
+
+//------------------------------------------------------------------------
+
+static inline uint hashString(uint h,const char *s)
+{
+  // FNV-1a
+  if (s)
+  {
+    while (*s)
+    {
+      h ^= (uchar)*s++;
+      h *= 16777619U;
+    }
+  }
+  h ^= 0xff; // separator, so ("ab","c") and ("a","bc") differ
+  h *= 16777619U;
+  return h;
+}
+
+static inline uint hashPointer(uint h,const void *p)
+{
+  unsigned long v = (unsigned long)p;
+  h ^= (uint)(v ^ (v>>16>>16)); // two shifts, since long may be 32 bit
+  h *= 16777619U;
+  return h;
+}
+
+LookupKey::LookupKey(const Definition *s,const FileDef *fs,
+                     const char *n,const char *e)
+  : scope(s), fileScope(fs), name(n), explicitScopePart(e)
+{
+  uint h = 2166136261U;
+  h = hashPointer(h,s);
+  h = hashPointer(h,fs);
+  h = hashString(h,n);
+  h = hashString(h,e);
+  // final mix, the upper bits select the shard, the lower bits the bucket
+  h ^= h>>15;
+  h *= 0x2c1b3c6dU;
+  h ^= h>>12;
+  hash = h;
+}
+
+// compares two strings treating 0 as the empty string
+static inline bool sameString(const char *s1,const char *s2)
+{
+  return qstrcmp(s1 ? s1 : "",s2 ? s2 : "")==0;
+}
+
+//------------------------------------------------------------------------
+
+/** Cached lookup result */
+struct LookupCache::Node
+{
+  uint              hash;
+  const Definition *scope;
+  const FileDef    *fileScope;
+  QCString          name;
+  QCString          explicitScopePart;
+  LookupInfo        info;
+  Node             *next;    // next node in the same bucket
+  Node             *lruPrev; // more recently used node
+  Node             *lruNext; // less recently used node
+
+  bool matches(const LookupKey &key) const
+  {
+    return hash==key.hash && scope==key.scope && fileScope==key.fileScope &&
+           sameString(name,key.name) &&
+           sameString(explicitScopePart,key.explicitScopePart);
+  }
+};
+
+/** Part of the cache protected by a single lock */
+struct LookupCache::Shard
+{
+  Shard() : buckets(0), numBuckets(0), capacity(0), count(0),
+            lruHead(0), lruTail(0), hits(0), misses(0), evictions(0) {}
+  mutable QMutex mutex;
+  Node **buckets;
+  uint   numBuckets;    // power of 2
+  uint   capacity;
+  uint   count;
+  Node  *lruHead;       // most recently used
+  Node  *lruTail;       // least recently used
+  uint   hits;
+  uint   misses;
+  uint   evictions;
+
+  Node **bucketFor(uint hash)
+  {
+    return &buckets[hash&(numBuckets-1)];
+  }
+  void lruUnlink(Node *n)
+  {
+    if (n->lruPrev) n->lruPrev->lruNext=n->lruNext; else lruHead=n->lruNext;
+    if (n->lruNext) n->lruNext->lruPrev=n->lruPrev; else lruTail=n->lruPrev;
+    n->lruPrev=n->lruNext=0;
+  }
+  void lruPushFront(Node *n)
+  {
+    n->lruPrev=0;
+    n->lruNext=lruHead;
+    if (lruHead) lruHead->lruPrev=n; else lruTail=n;
+    lruHead=n;
+  }
+  Node *lookup(const LookupKey &key)
+  {
+    Node *n = *bucketFor(key.hash);
+    while (n && !n->matches(key)) n=n->next;
+    return n;
+  }
+  void remove(Node *n)
+  {
+    Node **pn = bucketFor(n->hash);
+    while (*pn!=n) pn=&(*pn)->next;
+    *pn = n->next;
+    lruUnlink(n);
+    delete n;
+    count--;
+  }
+  void clear()
+  {
+    Node *n = lruHead;
+    while (n)
+    {
+      Node *next = n->lruNext;
+      delete n;
+      n = next;
+    }
+    memset(buckets,0,numBuckets*sizeof(Node*));
+    lruHead=lruTail=0;
+    count=0;
+  }
+};
+
+//------------------------------------------------------------------------
+
+LookupCache::LookupCache(uint size) : m_size(size)
+{
+  m_shards = new Shard[NUM_SHARDS];
+  uint capacity = QMAX(1,(size+NUM_SHARDS-1)/NUM_SHARDS);
+  uint numBuckets = 1;
+  while (numBuckets<capacity) numBuckets<<=1;
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    Shard &s = m_shards[i];
+    s.capacity   = capacity;
+    s.numBuckets = numBuckets;
+    s.buckets    = new Node*[numBuckets];
+    memset(s.buckets,0,numBuckets*sizeof(Node*));
+  }
+}
+
+LookupCache::~LookupCache()
+{
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    m_shards[i].clear();
+    delete[] m_shards[i].buckets;
+  }
+  delete[] m_shards;
+}
+
+LookupCache::Shard *LookupCache::shardFor(const LookupKey &key) const
+{
+  return &m_shards[key.hash>>28 & (NUM_SHARDS-1)];
+}
+
+bool LookupCache::find(const LookupKey &key,LookupInfo &info)
+{
+  Shard *s = shardFor(key);
+  QMutexLocker locker(&s->mutex);
+  Node *n = s->lookup(key);
+  if (n)
+  {
+    s->hits++;
+    if (n!=s->lruHead)
+    {
+      s->lruUnlink(n);
+      s->lruPushFront(n);
+    }
+    info = n->info;
+    return TRUE;
+  }
+  s->misses++;
+  return FALSE;
+}
+
+void LookupCache::insert(const LookupKey &key,const LookupInfo &info)
+{
+  Shard *s = shardFor(key);
+  QMutexLocker locker(&s->mutex);
+  Node *n = s->lookup(key);
+  if (n) // update existing result
+  {
+    n->info = info;
+    if (n!=s->lruHead)
+    {
+      s->lruUnlink(n);
+      s->lruPushFront(n);
+    }
+    return;
+  }
+  if (s->count>=s->capacity) // make room
+  {
+    s->remove(s->lruTail);
+    s->evictions++;
+  }
+  n = new Node;
+  n->hash              = key.hash;
+  n->scope             = key.scope;
+  n->fileScope         = key.fileScope;
+  n->name              = key.name;
+  n->explicitScopePart = key.explicitScopePart;
+  n->info              = info;
+  Node **bucket = s->bucketFor(key.hash);
+  n->next = *bucket;
+  *bucket = n;
+  s->lruPushFront(n);
+  s->count++;
+}
+
+void LookupCache::removeIf(bool (*pred)(const LookupInfo &info))
+{
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    Shard &s = m_shards[i];
+    QMutexLocker locker(&s.mutex);
+    Node *n = s.lruHead;
+    while (n)
+    {
+      Node *next = n->lruNext;
+      if (pred(n->info)) s.remove(n);
+      n = next;
+    }
+  }
+}
+
+void LookupCache::clear()
+{
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    QMutexLocker locker(&m_shards[i].mutex);
+    m_shards[i].clear();
+  }
+}
+
+uint LookupCache::count() const
+{
+  uint total=0;
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    QMutexLocker locker(&m_shards[i].mutex);
+    total+=m_shards[i].count;
+  }
+  return total;
+}
+
+uint LookupCache::hits() const
+{
+  uint total=0;
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    QMutexLocker locker(&m_shards[i].mutex);
+    total+=m_shards[i].hits;
+  }
+  return total;
+}
+
+uint LookupCache::misses() const
+{
+  uint total=0;
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    QMutexLocker locker(&m_shards[i].mutex);
+    total+=m_shards[i].misses;
+  }
+  return total;
+}
+
+uint LookupCache::evictions() const
+{
+  uint total=0;
+  int i;
+  for (i=0;i<NUM_SHARDS;i++)
+  {
+    QMutexLocker locker(&m_shards[i].mutex);
+    total+=m_shards[i].evictions;
+  }
+  return total;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2013 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+
+#include <qcstring.h>
+#include <qmutex.h>
+
+class ClassDef;
+class MemberDef;
+class Definition;
+class FileDef;
+
+/** Result of a symbol lookup as stored in the LookupCache. */
+struct LookupInfo
+{
+  LookupInfo() : classDef(0), typeDef(0) {}
+  LookupInfo(ClassDef *cd,MemberDef *td,QCString ts,QCString rt)
+    : classDef(cd), typeDef(td), templSpec(ts),resolvedType(rt) {}
+  ClassDef  *classDef;
+  MemberDef *typeDef;
+  QCString   templSpec;
+  QCString   resolvedType;
+};
+
+/** Key identifying a symbol lookup: the \a name with optional explicit
+ *  scope prefix \a explicitScopePart searched from \a scope. The
+ *  \a fileScope is only needed if the file contains using statements
+ *  that can influence the result, and 0 otherwise.
+ */
+struct LookupKey
+{
+  LookupKey(const Definition *s,const FileDef *fs,
+            const char *n,const char *e);
+  const Definition *scope;
+  const FileDef    *fileScope;
+  const char       *name;
+  const char       *explicitScopePart;
+  uint              hash;
+};
+
+/** @brief Cache of symbol lookup results.
+ *
+ *  The cache is split into a number of shards, each with its own lock,
+ *  hash table and least recently used list, so it can be used from
+ *  multiple threads. Lookups compare the scope and file scope by
+ *  identity and only compare the strings when the hash values match,
+ *  so no combined key string needs to be built.
+ *
+ *  Results are copied in and out of the cache, so a result stays valid
+ *  even when another thread evicts the entry.
+ */
+class LookupCache
+{
+  public:
+    /*! Creates a cache that holds at most \a size results. */
+    LookupCache(uint size);
+   ~LookupCache();
+
+    /*! Looks up \a key. Returns TRUE and sets \a info if found. */
+    bool find(const LookupKey &key,LookupInfo &info);
+
+    /*! Stores \a info as the result for \a key, replacing any previous
+     *  result. If the cache is full the least recently used result of
+     *  the shard is evicted.
+     */
+    void insert(const LookupKey &key,const LookupInfo &info);
+
+    /*! Removes all results for which \a pred returns TRUE. */
+    void removeIf(bool (*pred)(const LookupInfo &info));
+
+    /*! Removes all results. */
+    void clear();
+
+    uint count() const;
+    uint size() const { return m_size; }
+    uint hits() const;
+    uint misses() const;
+    uint evictions() const;
+
+  private:
+    struct Node;
+    struct Shard;
+    Shard *shardFor(const LookupKey &key) const;
+    Shard *m_shards;
+    uint   m_size;
+};
+
+#endif
@@ -632,9 +632,9 @@ void MemberDefImpl::init(Definition *def,
   //  type.stripPrefix("struct ");
   //  type.stripPrefix("class " );
   //  type.stripPrefix("union " );
-  type=removeRedundantWhiteSpace(type);
+  type=removeRedundantWhiteSpace(type).intern();
   args=a;
-  args=removeRedundantWhiteSpace(args);
+  args=removeRedundantWhiteSpace(args).intern();
   if (type.isEmpty()) decl=def->name()+args; else decl=type+" "+def->name()+args;
 
   memberGroup=0;
@@ -1249,10 +1249,11 @@ ClassDef *MemberDef::getClassDefOfAnonymousType()
   if (i!=-1) // found anonymous scope in type
   {
     int il=i-1,ir=i+l;
+    const char *p=ltype; // only read, so ltype stays shared
     // extract anonymous scope
-    while (il>=0 && (isId(ltype.at(il)) || ltype.at(il)==':' || ltype.at(il)=='@')) il--;
+    while (il>=0 && (isId(p[il]) || p[il]==':' || p[il]=='@')) il--;
     if (il>0) il++; else if (il<0) il=0;
-    while (ir<(int)ltype.length() && (isId(ltype.at(ir)) || ltype.at(ir)==':' || ltype.at(ir)=='@')) ir++;
+    while (ir<(int)ltype.length() && (isId(p[ir]) || p[ir]==':' || p[ir]=='@')) ir++;
 
     QCString annName = ltype.mid(il,ir-il);
 
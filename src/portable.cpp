@@ -4,17 +4,29 @@
 #undef UNICODE
 #define _WIN32_DCOM
 #include <windows.h>
+#include <sys/utime.h>
 #else
 #include <unistd.h>
+#include <utime.h>
 #include <stdlib.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <spawn.h>
+#include <sys/time.h>
+#include <sys/resource.h>
 extern char **environ;
 #endif
 
 #include <qglobal.h>
 #include <qdatetime.h>
+#include <qcstring.h>
+#include <qstrlist.h>
+#include <qdict.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
 
 #if defined(_MSC_VER) || defined(__BORLANDC__)
 #define popen _popen
@@ -30,94 +42,264 @@ extern char **environ;
 static double  g_sysElapsedTime;
 static QTime   g_time;
 
-int portable_system(const char *command,const char *args,bool commandHasConsole)
+//----------------------------------------------------------------------
+
+/** Run time statistics for one external tool */
+struct ProcessStats
 {
+  ProcessStats() : count(0), failures(0), totalTime(0), maxTime(0) {}
+  int count;
+  int failures;
+  int totalTime; // in ms
+  int maxTime;   // in ms
+};
+
+static QMutex         g_processMutex;
+static QWaitCondition g_processSlotFree;
+static int            g_maxProcesses = 0; // 0 means no limit
+static int            g_numProcesses = 0;
+
+/** Run time statistics per external tool */
+class ProcessStatsDict : public QDict<ProcessStats>
+{
+  public:
+    ProcessStatsDict() : QDict<ProcessStats>(257) { setAutoDelete(TRUE); }
+};
 
-  if (command==0) return 1;
+static ProcessStatsDict g_processStats;
 
-  QCString fullCmd=command;
-  fullCmd=fullCmd.stripWhiteSpace();
-  if (fullCmd.at(0)!='"' && fullCmd.find(' ')!=-1)
-  {
-    // add quotes around command as it contains spaces and is not quoted already
-    fullCmd="\""+fullCmd+"\"";
-  }
-  fullCmd += " ";
-  fullCmd += args;
-#ifndef NODEBUG
-  Debug::print(Debug::ExtCmd,0,"Executing external command `%s`\n",fullCmd.data());
+/** Returns a time stamp in ms. Unlike QTime this can be used from
+ *  multiple threads. */
+static long currentTimeMs()
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return (long)GetTickCount();
+#else
+  struct timeval tv;
+  gettimeofday(&tv,0);
+  return tv.tv_sec*1000L+tv.tv_usec/1000;
 #endif
+}
 
-#if !defined(_WIN32) || defined(__CYGWIN__)
-  (void)commandHasConsole;
-  /*! taken from the system() manpage on my Linux box */
-  int pid,status=0;
+void portable_setMaxProcesses(int maxProcesses)
+{
+  QMutexLocker locker(&g_processMutex);
+  g_maxProcesses = QMAX(0,maxProcesses);
+  g_processSlotFree.wakeAll();
+}
 
-#ifdef _OS_SOLARIS // for Solaris we use vfork since it is more memory efficient
+/** Waits until the number of running external processes is below the limit */
+static void acquireProcessSlot()
+{
+  QMutexLocker locker(&g_processMutex);
+  while (g_maxProcesses>0 && g_numProcesses>=g_maxProcesses)
+  {
+    g_processSlotFree.wait(&g_processMutex);
+  }
+  g_numProcesses++;
+}
 
-  // on Solaris fork() duplicates the memory usage
-  // so we use vfork instead
-  
-  // spawn shell
-  if ((pid=vfork())<0)
+/** Releases the slot of a finished process and records its run time */
+static void releaseProcessSlot(const char *command,int elapsed,int exitCode)
+{
+  QMutexLocker locker(&g_processMutex);
+  g_numProcesses--;
+  g_processSlotFree.wakeOne();
+
+  // use the base name of the command as the name of the tool
+  QCString tool = command;
+  tool = tool.stripWhiteSpace();
+  if (tool.at(0)=='"') tool = tool.mid(1,tool.find('"',1)-1);
+  int i = QMAX(tool.findRev('/'),tool.findRev('\\'));
+  if (i!=-1) tool = tool.mid(i+1);
+  ProcessStats *ps = g_processStats.find(tool);
+  if (ps==0)
   {
-    status=-1;
+    ps = new ProcessStats;
+    g_processStats.insert(tool,ps);
   }
-  else if (pid==0)
+  ps->count++;
+  if (exitCode!=0) ps->failures++;
+  ps->totalTime+=elapsed;
+  if (elapsed>ps->maxTime) ps->maxTime=elapsed;
+}
+
+void portable_printProcessStats()
+{
+#ifndef NODEBUG
+  QMutexLocker locker(&g_processMutex);
+  QDictIterator<ProcessStats> it(g_processStats);
+  ProcessStats *ps;
+  for (;(ps=it.current());++it)
   {
-     execl("/bin/sh","sh","-c",fullCmd.data(),(char*)0);
-     _exit(127);
+    Debug::print(Debug::ExtCmd,0,"External tool `%s`: %d runs (%d failed), "
+                 "%.3f seconds in total, %.3f seconds at most\n",
+                 it.currentKey(),ps->count,ps->failures,
+                 ps->totalTime/1000.0,ps->maxTime/1000.0);
   }
-  else
+#endif
+}
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+
+/** Splits the command line \a cmd into arguments using the quoting rules
+ *  of the shell. Returns FALSE if the command line needs the shell, for
+ *  instance because it contains redirections, pipes or variables.
+ */
+static bool splitCommandLine(const char *cmd,QStrList &argList)
+{
+  const char *p = cmd;
+  char c;
+  QCString arg;
+  bool inArg=FALSE;
+  while ((c=*p++))
   {
-    while (waitpid(pid,&status,0 )<0)
+    switch (c)
     {
-      if (errno!=EINTR)
-      {
-        status=-1;
+      case ' ': case '\t':
+        if (inArg) argList.append(arg);
+        arg.resize(0);
+        inArg=FALSE;
+        break;
+      case '\'':
+        while (*p && *p!='\'') arg+=*p++;
+        if (*p++==0) return FALSE; // unterminated quote
+        inArg=TRUE;
+        break;
+      case '"':
+        while (*p && *p!='"')
+        {
+          if (*p=='$' || *p=='`') return FALSE; // substitution
+          if (*p=='\\' && (p[1]=='"' || p[1]=='\\')) p++;
+          arg+=*p++;
+        }
+        if (*p++==0) return FALSE; // unterminated quote
+        inArg=TRUE;
+        break;
+      case '\\':
+        if (*p==0) return FALSE;
+        arg+=*p++;
+        inArg=TRUE;
+        break;
+      case '|': case '&': case ';': case '<': case '>': case '(': case ')':
+      case '$': case '`': case '*': case '?': case '[': case '~': case '{':
+      case '#': case '\n':
+        return FALSE; // let the shell deal with these
+      default:
+        arg+=c;
+        inArg=TRUE;
         break;
-      }
     }
   }
-  return status;
-
-#else  // Other Unices just use fork
+  if (inArg) argList.append(arg);
+  return !argList.isEmpty();
+}
 
-  pid = fork();
-  if (pid==-1)
+/** Starts a process for \a cmd and waits for it to finish. The process is
+ *  created with posix_spawn, which does not copy the page tables of
+ *  doxygen's (possibly large) address space like fork does. Unless the
+ *  command line needs the shell, the program is started directly.
+ */
+static int spawnProcess(const char *cmd)
+{
+  QStrList argList;
+  const char **argv;
+  uint i=0;
+  pid_t pid;
+  int rc;
+  if (splitCommandLine(cmd,argList))
   {
-    perror("fork error");
-	  return -1;
+    argv = new const char*[argList.count()+1];
+    const char *arg;
+    for (arg=argList.first();arg;arg=argList.next()) argv[i++]=arg;
+    argv[i]=0;
+    rc = posix_spawnp(&pid,argv[0],0,0,(char * const *)argv,environ);
   }
-  if (pid==0)
+  else
   {
-    const char * argv[4];
+    argv = new const char*[4];
     argv[0] = "sh";
     argv[1] = "-c";
-    argv[2] = fullCmd.data();
+    argv[2] = cmd;
     argv[3] = 0;
-    execve("/bin/sh",(char * const *)argv,environ);
-    exit(127);
+    rc = posix_spawn(&pid,"/bin/sh",0,0,(char * const *)argv,environ);
   }
-  for (;;)
+  if (rc!=0)
   {
-    if (waitpid(pid,&status,0)==-1)
+    // same message and exit code as the shell gives for a command that
+    // cannot be run
+    if (rc==ENOENT)
     {
-      if (errno!=EINTR) return -1;
+      fprintf(stderr,"%s: command not found\n",argv[0]);
     }
     else
     {
-      if (WIFEXITED(status))
-      {
-        return WEXITSTATUS(status);
-      }
-      else
-      {
-        return status;
-      }
+      fprintf(stderr,"%s: %s\n",argv[0],strerror(rc));
     }
+    delete[] argv;
+    return rc==ENOENT ? 127 : 126;
+  }
+  delete[] argv;
+
+  int status=0;
+  while (waitpid(pid,&status,0)==-1)
+  {
+    if (errno!=EINTR) return -1;
+  }
+  if (WIFEXITED(status))
+  {
+    return WEXITSTATUS(status);
   }
-#endif // !_OS_SOLARIS
+  else
+  {
+    return status;
+  }
+}
+
+#endif
+
+static int runProcess(const char *command,const char *args,const char *fullCmd,
+                      bool commandHasConsole);
+
+int portable_system(const char *command,const char *args,bool commandHasConsole)
+{
+
+  if (command==0) return 1;
+
+  QCString fullCmd=command;
+  fullCmd=fullCmd.stripWhiteSpace();
+  if (fullCmd.at(0)!='"' && fullCmd.find(' ')!=-1)
+  {
+    // add quotes around command as it contains spaces and is not quoted already
+    fullCmd="\""+fullCmd+"\"";
+  }
+  fullCmd += " ";
+  fullCmd += args;
+#ifndef NODEBUG
+  Debug::print(Debug::ExtCmd,0,"Executing external command `%s`\n",fullCmd.data());
+#endif
+
+  acquireProcessSlot();
+  long startTime = currentTimeMs();
+  int exitCode = runProcess(command,args,fullCmd,commandHasConsole);
+  int elapsed = (int)(currentTimeMs()-startTime);
+  releaseProcessSlot(command,elapsed,exitCode);
+
+#ifndef NODEBUG
+  Debug::print(Debug::ExtCmd,0,"Finished external command `%s` in %.3f seconds with exit code %d\n",
+               fullCmd.data(),elapsed/1000.0,exitCode);
+#endif
+  return exitCode;
+}
+
+static int runProcess(const char *command,const char *args,const char *fullCmd,
+                      bool commandHasConsole)
+{
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  (void)command;
+  (void)args;
+  (void)commandHasConsole;
+  return spawnProcess(fullCmd);
 
 #else // Win32 specific
   if (commandHasConsole)
@@ -413,6 +595,23 @@ double portable_getSysElapsedTime()
   return g_sysElapsedTime;
 }
 
+/** Returns the largest amount of memory used by the process so far in kB,
+ *  or 0 if this is not known. */
+long portable_peakMemoryUsage()
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF,&usage)!=0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss/1024; // reported in bytes
+#else
+  return usage.ru_maxrss;      // reported in kB
+#endif
+#endif
+}
+
 void portable_sleep(int ms)
 {
 #if defined(_WIN32) && !defined(__CYGWIN__)
@@ -439,4 +638,20 @@ bool portable_isAbsolutePath(const char *fileName)
   return false;
 }
 
+bool portable_link(const char *src,const char *dest)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return CreateHardLinkA(dest,src,NULL)!=0;
+#else
+  return link(src,dest)==0;
+#endif
+}
 
+void portable_touch(const char *fileName)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  _utime(fileName,NULL);
+#else
+  utime(fileName,NULL);
+#endif
+}
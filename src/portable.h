@@ -16,6 +16,8 @@ typedef off_t portable_off_t;
  */
 
 int            portable_system(const char *command,const char *args,bool commandHasConsole=TRUE);
+void           portable_setMaxProcesses(int maxProcesses);
+void           portable_printProcessStats();
 uint           portable_pid();
 const char *   portable_getenv(const char *variable);
 void           portable_setenv(const char *variable,const char *value);
@@ -34,7 +36,10 @@ void           portable_sysTimerStart();
 void           portable_sysTimerStop();
 double         portable_getSysElapsedTime();
 void           portable_sleep(int ms);
+long           portable_peakMemoryUsage();
 bool           portable_isAbsolutePath(const char *fileName);
+bool           portable_link(const char *src,const char *dest);
+void           portable_touch(const char *fileName);
 
 extern "C" {
   void *         portable_iconv_open(const char* tocode, const char* fromcode);
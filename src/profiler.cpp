@@ -0,0 +1,338 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2013 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+
+#include <qfile.h>
+#include <qlist.h>
+#include <qdict.h>
+#include <qmutex.h>
+
+#include "profiler.h"
+#include "ftextstream.h"
+#include "message.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+typedef DWORD ThreadKey;
+static ThreadKey currentThreadKey()      { return GetCurrentThreadId(); }
+static bool sameThread(ThreadKey t1,ThreadKey t2) { return t1==t2; }
+#else
+typedef pthread_t ThreadKey;
+static ThreadKey currentThreadKey()      { return pthread_self(); }
+static bool sameThread(ThreadKey t1,ThreadKey t2) { return pthread_equal(t1,t2); }
+#endif
+
+/** Returns the number of microseconds since some fixed point in time.
+ *  Unlike QTime this can be used from multiple threads. */
+static double currentTime()
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  static LARGE_INTEGER freq;
+  if (freq.QuadPart==0) QueryPerformanceFrequency(&freq);
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+  return (double)now.QuadPart*1000000.0/(double)freq.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv,0);
+  return tv.tv_sec*1000000.0+tv.tv_usec;
+#endif
+}
+
+//------------------------------------------------------------------------
+
+/** A timer as it appears in the trace */
+struct ProfileEvent
+{
+  ProfileEvent(const char *n,const char *d,int t,double s)
+    : name(n), detail(d), thread(t), start(s), duration(0) {}
+  QCString name;
+  QCString detail;
+  int      thread;
+  double   start;    // in us since the profiler was enabled
+  double   duration; // in us
+};
+
+/** A value of a counter as it appears in the trace */
+struct ProfileCounter
+{
+  ProfileCounter(const char *n,double t,long v) : name(n), time(t), value(v) {}
+  QCString name;
+  double   time;
+  long     value;
+};
+
+/** Accumulated time of all timers with the same name and the same
+ *  enclosing timers in one thread */
+struct SummaryNode
+{
+  SummaryNode(const char *n) : name(n), count(0), total(0), self(0), childDict(17)
+  {
+    children.setAutoDelete(TRUE);
+  }
+  SummaryNode *child(const char *n)
+  {
+    SummaryNode *c = childDict.find(n);
+    if (c==0)
+    {
+      c = new SummaryNode(n);
+      children.append(c);
+      childDict.insert(n,c);
+    }
+    return c;
+  }
+  QCString           name;
+  int                count;
+  double             total;
+  double             self;
+  QList<SummaryNode> children; // in order of first use
+  QDict<SummaryNode> childDict;
+};
+
+/** A running timer */
+struct ProfileFrame
+{
+  ProfileFrame(ProfileEvent *e,SummaryNode *n) : event(e), node(n), childTime(0) {}
+  ProfileEvent *event;
+  SummaryNode  *node;
+  double        childTime;
+};
+
+/** Timers of a single thread */
+struct ProfileThread
+{
+  ProfileThread(int i,ThreadKey k) : index(i), key(k), root("")
+  {
+    stack.setAutoDelete(TRUE);
+  }
+  int                 index;
+  ThreadKey           key;
+  QCString            name;
+  QList<ProfileFrame> stack;
+  SummaryNode         root;
+};
+
+static QMutex                g_mutex;
+static double                g_startTime;
+static QList<ProfileThread>  g_threads;
+static QList<ProfileEvent>   g_events;
+static QList<ProfileCounter> g_counters;
+
+bool Profiler::s_enabled = FALSE;
+
+/** Returns the data of the calling thread, g_mutex must be locked */
+static ProfileThread *currentThread()
+{
+  ThreadKey key = currentThreadKey();
+  QListIterator<ProfileThread> it(g_threads);
+  ProfileThread *t;
+  for (;(t=it.current());++it)
+  {
+    if (sameThread(t->key,key)) return t;
+  }
+  t = new ProfileThread(g_threads.count(),key);
+  t->name.sprintf("thread %d",t->index);
+  g_threads.append(t);
+  return t;
+}
+
+void Profiler::enable()
+{
+  QMutexLocker locker(&g_mutex);
+  if (s_enabled) return;
+  g_threads.setAutoDelete(TRUE);
+  g_events.setAutoDelete(TRUE);
+  g_counters.setAutoDelete(TRUE);
+  g_startTime = currentTime();
+  currentThread()->name = "main";
+  s_enabled = TRUE;
+}
+
+void Profiler::setThreadName(const char *name)
+{
+  if (!s_enabled) return;
+  QMutexLocker locker(&g_mutex);
+  ProfileThread *self = currentThread();
+  // make the name unique, e.g. for a pool of worker threads
+  int n=1;
+  QCString uniqueName = name;
+  bool found=TRUE;
+  while (found)
+  {
+    found=FALSE;
+    QListIterator<ProfileThread> it(g_threads);
+    ProfileThread *t;
+    for (;(t=it.current()) && !found;++it)
+    {
+      found = t!=self && t->name==uniqueName;
+    }
+    if (found) uniqueName.sprintf("%s %d",name,++n);
+  }
+  self->name = uniqueName;
+}
+
+void Profiler::begin(const char *name,const char *detail)
+{
+  if (!s_enabled) return;
+  double now = currentTime()-g_startTime;
+  QMutexLocker locker(&g_mutex);
+  ProfileThread *t = currentThread();
+  ProfileFrame *parent = t->stack.getLast();
+  SummaryNode *node = (parent ? parent->node : &t->root)->child(name);
+  ProfileEvent *e = new ProfileEvent(name,detail,t->index,now);
+  g_events.append(e);
+  t->stack.append(new ProfileFrame(e,node));
+}
+
+void Profiler::end()
+{
+  if (!s_enabled) return;
+  double now = currentTime()-g_startTime;
+  QMutexLocker locker(&g_mutex);
+  ProfileThread *t = currentThread();
+  ProfileFrame *f = t->stack.getLast();
+  if (f==0) return; // unbalanced end()
+  double duration = now-f->event->start;
+  f->event->duration = duration;
+  f->node->count++;
+  f->node->total+=duration;
+  f->node->self+=duration-f->childTime;
+  t->stack.removeLast();
+  ProfileFrame *parent = t->stack.getLast();
+  if (parent) parent->childTime+=duration;
+}
+
+void Profiler::counter(const char *name,long value)
+{
+  if (!s_enabled) return;
+  double now = currentTime()-g_startTime;
+  QMutexLocker locker(&g_mutex);
+  g_counters.append(new ProfileCounter(name,now,value));
+}
+
+//------------------------------------------------------------------------
+
+static void printSummaryNode(const SummaryNode *node,int indent)
+{
+  QListIterator<SummaryNode> it(node->children);
+  SummaryNode *c;
+  for (;(c=it.current());++it)
+  {
+    msg("%10.3f %10.3f %8d  %*s%s\n",c->total/1000000.0,c->self/1000000.0,
+        c->count,indent*2,"",c->name.data());
+    printSummaryNode(c,indent+1);
+  }
+}
+
+void Profiler::printSummary()
+{
+  if (!s_enabled) return;
+  QMutexLocker locker(&g_mutex);
+  QListIterator<ProfileThread> it(g_threads);
+  ProfileThread *t;
+  for (;(t=it.current());++it)
+  {
+    if (t->root.children.isEmpty()) continue;
+    msg("----------------------\n");
+    msg("Time spent in thread %s:\n",t->name.data());
+    msg("%10s %10s %8s  %s\n","total(s)","self(s)","calls","name");
+    printSummaryNode(&t->root,0);
+  }
+}
+
+static QCString escapeJson(const char *s)
+{
+  QCString result;
+  if (s==0) return result;
+  char c;
+  while ((c=*s++))
+  {
+    switch (c)
+    {
+      case '"':  result+="\\\""; break;
+      case '\\': result+="\\\\"; break;
+      case '\n': result+="\\n";  break;
+      case '\t': result+="\\t";  break;
+      default:
+        if ((uchar)c<0x20)
+        {
+          QCString hex;
+          hex.sprintf("\\u%04x",(uchar)c);
+          result+=hex;
+        }
+        else
+        {
+          result+=c;
+        }
+        break;
+    }
+  }
+  return result;
+}
+
+bool Profiler::writeTrace(const char *fileName)
+{
+  if (!s_enabled) return FALSE;
+  QFile f(fileName);
+  if (!f.open(IO_WriteOnly))
+  {
+    err("Failed to open file %s for writing!\n",fileName);
+    return FALSE;
+  }
+  QMutexLocker locker(&g_mutex);
+  FTextStream t(&f);
+  t << "{\"traceEvents\":[" << endl;
+  bool first=TRUE;
+  QListIterator<ProfileThread> thi(g_threads);
+  ProfileThread *th;
+  for (;(th=thi.current());++thi)
+  {
+    if (!first) t << "," << endl;
+    t << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << th->index
+      << ",\"args\":{\"name\":\"" << escapeJson(th->name) << "\"}}";
+    first=FALSE;
+  }
+  QCString ts;
+  QListIterator<ProfileEvent> ei(g_events);
+  ProfileEvent *e;
+  for (;(e=ei.current());++ei)
+  {
+    t << "," << endl;
+    ts.sprintf("\"ts\":%.0f,\"dur\":%.0f",e->start,e->duration);
+    t << "{\"name\":\"" << escapeJson(e->name) << "\",\"ph\":\"X\"," << ts
+      << ",\"pid\":1,\"tid\":" << e->thread;
+    if (!e->detail.isEmpty())
+    {
+      t << ",\"args\":{\"detail\":\"" << escapeJson(e->detail) << "\"}";
+    }
+    t << "}";
+  }
+  QListIterator<ProfileCounter> ci(g_counters);
+  ProfileCounter *c;
+  for (;(c=ci.current());++ci)
+  {
+    t << "," << endl;
+    ts.sprintf("\"ts\":%.0f",c->time);
+    t << "{\"name\":\"" << escapeJson(c->name) << "\",\"ph\":\"C\"," << ts
+      << ",\"pid\":1,\"args\":{\"value\":" << c->value << "}}";
+  }
+  t << endl << "]}" << endl;
+  return TRUE;
+}
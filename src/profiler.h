@@ -0,0 +1,85 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2013 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <qglobal.h>
+
+/** @brief Records where the time of a doxygen run is spent.
+ *
+ *  Timers are started with begin() and stopped with end() and can be
+ *  nested. Each thread has its own stack of timers, which shows up as a
+ *  separate track in the trace. Counters record a value over time.
+ *
+ *  The results can be printed as a table with printSummary() and written
+ *  in the trace event format of Chrome with writeTrace(). The trace can
+ *  be viewed with chrome://tracing or https://ui.perfetto.dev.
+ *
+ *  Nothing is recorded until enable() has been called.
+ */
+class Profiler
+{
+  public:
+    /*! Starts recording. Should be called from the main thread. */
+    static void enable();
+
+    /*! Returns TRUE if recording has been enabled. */
+    static bool isEnabled() { return s_enabled; }
+
+    /*! Sets the name of the track of the calling thread. */
+    static void setThreadName(const char *name);
+
+    /*! Starts a timer for \a name in the calling thread. The optional
+     *  \a detail (e.g. a file name) is only shown in the trace.
+     */
+    static void begin(const char *name,const char *detail=0);
+
+    /*! Stops the last timer started by the calling thread. */
+    static void end();
+
+    /*! Records the current \a value of counter \a name. */
+    static void counter(const char *name,long value);
+
+    /*! Prints the total and self time of each timer, per thread. */
+    static void printSummary();
+
+    /*! Writes all recorded events to \a fileName in Chrome's
+     *  trace event format. Returns FALSE if the file could not be written.
+     */
+    static bool writeTrace(const char *fileName);
+
+  private:
+    static bool s_enabled;
+};
+
+/** Times the scope in which it is declared. */
+class ProfileScope
+{
+  public:
+    ProfileScope(const char *name,const char *detail=0)
+      : m_active(Profiler::isEnabled())
+    {
+      if (m_active) Profiler::begin(name,detail);
+    }
+   ~ProfileScope()
+    {
+      if (m_active) Profiler::end();
+    }
+  private:
+    bool m_active;
+};
+
+#endif
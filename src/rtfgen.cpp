@@ -2284,7 +2284,7 @@ static void encodeForOutput(FTextStream &t,const QCString &s)
     {
       size_t iLeft=l;
       size_t oLeft=enc.size();
-      char *inputPtr = s.data();
+      char *inputPtr = (char *)s.data(); // iconv does not modify the input
       char *outputPtr = enc.data();
       if (!portable_iconv(cd, &inputPtr, &iLeft, &outputPtr, &oLeft))
       {
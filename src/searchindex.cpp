@@ -20,6 +20,10 @@
 
 #include <qfile.h>
 #include <qregexp.h>
+#include <qqueue.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
 
 #include "searchindex.h"
 #include "config.h"
@@ -254,7 +258,7 @@ static void writeInt(QFile &f,int index)
 static void writeString(QFile &f,const char *s)
 {
   const char *p = s;
-  while (*p) f.putch(*p++);
+  if (p) while (*p) f.putch(*p++);
   f.putch(0);
 }
 
@@ -420,20 +424,44 @@ struct SearchDocEntry
   QCString url; 
   GrowBuf  importantText;
   GrowBuf  normalText;
+  int      index;
 };
 
 struct SearchIndexExternal::Private
 {
-  Private() : docEntries(12251) {}
+  Private() : docEntries(12251), words(0) {}
+ ~Private() { delete words; }
   SDict<SearchDocEntry> docEntries;
   SearchDocEntry *current;
+  QDict<IndexWord> *words;  // only created if a compact index is written
+  bool compact;
+  void addIndexWord(const char *word,bool hiPriority);
 };
 
+void SearchIndexExternal::Private::addIndexWord(const char *word,bool hiPriority)
+{
+  if (word==0 || *word=='\0') return;
+  QCString wStr = QCString(word).lower();
+  if (words==0)
+  {
+    words = new QDict<IndexWord>(328829);
+    words->setAutoDelete(TRUE);
+  }
+  IndexWord *w = words->find(wStr);
+  if (w==0)
+  {
+    w = new IndexWord(wStr);
+    words->insert(wStr,w);
+  }
+  w->addUrlIndex(current->index,hiPriority);
+}
+
 SearchIndexExternal::SearchIndexExternal() : SearchIndexIntf(External)
 {
   p = new SearchIndexExternal::Private;
   p->docEntries.setAutoDelete(TRUE);
   p->current=0;
+  p->compact=!Config_getString("SEARCHDATA_INDEX").isEmpty();
 }
 
 SearchIndexExternal::~SearchIndexExternal()
@@ -518,8 +546,15 @@ void SearchIndexExternal::setCurrentDoc(Definition *ctx,const char *anchor,bool
     }
     e->extId = extId;
     e->url  = url;
+    e->index = p->docEntries.count();
     p->current = e;
     p->docEntries.append(key,e);
+    if (p->compact) // make the document findable by its (unqualified) name
+    {
+      p->addIndexWord(e->name,TRUE);
+      int i = e->name.findRev("::");
+      if (i!=-1) p->addIndexWord(e->name.mid(i+2),TRUE);
+    }
     //printf("searchIndexExt %s : %s\n",e->name.data(),e->url.data());
   }
 }
@@ -530,6 +565,7 @@ void SearchIndexExternal::addWord(const char *word,bool hiPriority)
   GrowBuf *pText = hiPriority ? &p->current->importantText : &p->current->normalText;
   if (pText->getPos()>0) pText->addChar(' ');
   pText->addStr(word);
+  if (p->compact) p->addIndexWord(word,hiPriority);
   //printf("addWord %s\n",word);
 }
 
@@ -571,6 +607,172 @@ void SearchIndexExternal::write(const char *fileName)
   }
 }
 
+// compact index file format: (all multi-byte values are stored in big endian
+// format, varints use 7 bits per byte starting with the least significant
+// bits, the high bit is set in all but the last byte)
+//   4 byte header 'DOXC' + 4 byte version
+//   4 byte number of terms, 4 byte number of term blocks, 4 byte number of documents
+//   4 byte offset to the block index, 4 byte offset to the document index
+//   for each term (in sorted order): the posting list consisting of
+//     for each document containing the term (in document order):
+//       varint document number (relative to the previous document in the list)
+//       varint frequency counter (as computed by IndexWord::addUrlIndex)
+//   for each block of (at most) compactTermsPerBlock sorted terms:
+//     for each term: varint length of the prefix shared with the previous term
+//                    in the block (0 for the first term) + varint length of the
+//                    remaining characters + the remaining characters
+//                    + varint number of documents + varint offset to the postings
+//   block index: for each block a 4 byte offset to the first term
+//   for each document: \0 terminated type, name, args, tag and url strings
+//   document index: for each document a 4 byte offset to its data
+
+const int compactIndexVersion  = 1;
+const int compactTermsPerBlock = 16;
+
+static void writeVarint(QFile &f,uint v)
+{
+  while (v>=0x80)
+  {
+    f.putch((v&0x7f)|0x80);
+    v>>=7;
+  }
+  f.putch(v);
+}
+
+static int compareIndexWords(const void *p1,const void *p2)
+{
+  const IndexWord *w1 = *(const IndexWord **)p1;
+  const IndexWord *w2 = *(const IndexWord **)p2;
+  return qstrcmp(w1->word(),w2->word());
+}
+
+static int compareUrlInfos(const void *p1,const void *p2)
+{
+  const URLInfo *u1 = *(const URLInfo **)p1;
+  const URLInfo *u2 = *(const URLInfo **)p2;
+  return u1->urlIdx - u2->urlIdx;
+}
+
+static int sharedPrefixLength(const char *s1,const char *s2)
+{
+  int i=0;
+  while (s1[i] && s1[i]==s2[i]) i++;
+  return i;
+}
+
+void SearchIndexExternal::writeCompactIndex(const char *fileName)
+{
+  if (!p->compact) return;
+  QFile f(fileName);
+  if (!f.open(IO_WriteOnly))
+  {
+    err("Failed to open file %s for writing!\n",fileName);
+    return;
+  }
+
+  // sort the terms
+  uint numTerms = p->words ? p->words->count() : 0;
+  IndexWord **terms = new IndexWord*[QMAX(numTerms,1)];
+  IndexWord *iw;
+  uint i=0;
+  if (p->words)
+  {
+    QDictIterator<IndexWord> wdi(*p->words);
+    for (wdi.toFirst();(iw=wdi.current());++wdi) terms[i++]=iw;
+  }
+  qsort(terms,numTerms,sizeof(IndexWord*),compareIndexWords);
+  uint numBlocks = (numTerms+compactTermsPerBlock-1)/compactTermsPerBlock;
+  uint numDocs   = p->docEntries.count();
+
+  // write header, the offsets are filled in at the end
+  f.putch('D'); f.putch('O'); f.putch('X'); f.putch('C');
+  writeInt(f,compactIndexVersion);
+  writeInt(f,numTerms);
+  writeInt(f,numBlocks);
+  writeInt(f,numDocs);
+  int offsetsPos = f.at();
+  writeInt(f,0);
+  writeInt(f,0);
+
+  // write posting lists
+  uint *postingOffsets = new uint[QMAX(numTerms,1)];
+  URLInfo **postings = 0;
+  uint postingsSize = 0;
+  for (i=0;i<numTerms;i++)
+  {
+    const QIntDict<URLInfo> &urls = terms[i]->urls();
+    uint numUrls = urls.count();
+    if (numUrls>postingsSize)
+    {
+      delete[] postings;
+      postingsSize = QMAX(numUrls,postingsSize*2);
+      postings = new URLInfo*[postingsSize];
+    }
+    QIntDictIterator<URLInfo> uli(urls);
+    URLInfo *ui;
+    uint j=0;
+    for (uli.toFirst();(ui=uli.current());++uli) postings[j++]=ui;
+    qsort(postings,numUrls,sizeof(URLInfo*),compareUrlInfos);
+    postingOffsets[i] = f.at();
+    int prevIdx = 0;
+    for (j=0;j<numUrls;j++)
+    {
+      writeVarint(f,postings[j]->urlIdx-prevIdx);
+      writeVarint(f,postings[j]->freq);
+      prevIdx = postings[j]->urlIdx;
+    }
+  }
+  delete[] postings;
+
+  // write term blocks
+  uint *blockOffsets = new uint[QMAX(numBlocks,1)];
+  for (i=0;i<numTerms;i++)
+  {
+    QCString word = terms[i]->word();
+    int shared = 0;
+    if (i%compactTermsPerBlock==0)
+    {
+      blockOffsets[i/compactTermsPerBlock] = f.at();
+    }
+    else
+    {
+      shared = sharedPrefixLength(terms[i-1]->word(),word);
+    }
+    writeVarint(f,shared);
+    writeVarint(f,word.length()-shared);
+    f.writeBlock(word.data()+shared,word.length()-shared);
+    writeVarint(f,terms[i]->urls().count());
+    writeVarint(f,postingOffsets[i]);
+  }
+  int blockIndexOffset = f.at();
+  for (i=0;i<numBlocks;i++) writeInt(f,blockOffsets[i]);
+
+  // write documents
+  uint *docOffsets = new uint[QMAX(numDocs,1)];
+  SDict<SearchDocEntry>::Iterator it(p->docEntries);
+  SearchDocEntry *doc;
+  for (it.toFirst();(doc=it.current());++it)
+  {
+    docOffsets[doc->index] = f.at();
+    writeString(f,doc->type);
+    writeString(f,doc->name);
+    writeString(f,doc->args);
+    writeString(f,doc->extId);
+    writeString(f,doc->url);
+  }
+  int docIndexOffset = f.at();
+  for (i=0;i<numDocs;i++) writeInt(f,docOffsets[i]);
+
+  f.at(offsetsPos);
+  writeInt(f,blockIndexOffset);
+  writeInt(f,docIndexOffset);
+
+  delete[] docOffsets;
+  delete[] blockOffsets;
+  delete[] postingOffsets;
+  delete[] terms;
+}
+
 //---------------------------------------------------------------------------
 // the following part is for the javascript based search engine
 
@@ -582,6 +784,7 @@ void SearchIndexExternal::write(const char *fileName)
 #include "language.h"
 #include "doxygen.h"
 #include "message.h"
+#include "profiler.h"
 
 static const char search_script[]=
 #include "search.js.h"
@@ -604,51 +807,94 @@ static const char search_script[]=
 #define SEARCH_INDEX_PAGES      14
 #define NUM_SEARCH_INDICES      15
 
-class SearchDefinitionList : public QList<Definition>
+/** Compact description of a symbol in the javascript search index */
+struct SearchSymbol
 {
-  public:
-    SearchDefinitionList(uint letter) : m_letter(letter) {}
-    uint letter() const { return m_letter; }
-  private:
-    uint m_letter;
+  Definition *def;
+  QCString    sortKey;   // name used for sorting, compared case insensitively
+  QCString    groupKey;  // symbols with the same key are shown as one entry
+  uint        letter;    // first letter of the symbol
+  int         category;  // SEARCH_INDEX_* category other than "all", or -1
+  bool        inAll;     // also listed in the "all" category
+  uint        seq;       // order in which the symbol was added
 };
 
-class SearchIndexList : public SDict< SearchDefinitionList >
+/** Flat list of all symbols in the javascript search index.
+ *  Once sorted, the symbols of each category and letter appear in the
+ *  order in which they are written, and symbols with the same name are
+ *  next to each other.
+ */
+class SearchSymbolList
 {
   public:
-    typedef Definition ElementType;
-    SearchIndexList(uint letter) : SDict<SearchDefinitionList>(17,FALSE), m_letter(letter)
-    {
-      setAutoDelete(TRUE);
-    }
-   ~SearchIndexList() {}
-    void append(Definition *d)
-    {
-      SearchDefinitionList *l = find(d->name());
-      if (l==0)
-      {
-        l=new SearchDefinitionList(m_letter);
-        SDict<SearchDefinitionList>::append(d->name(),l);
-      }
-      l->append(d);
-    }
-    int compareItems(QCollection::Item item1, QCollection::Item item2)
-    {
-      QList<Definition> *md1=(QList<Definition> *)item1;
-      QList<Definition> *md2=(QList<Definition> *)item2;
-      QCString n1 = md1->first()->localName();
-      QCString n2 = md2->first()->localName();
-      return qstricmp(n1.data(),n2.data());
-    }
-    uint letter() const { return m_letter; }
+    SearchSymbolList() : m_symbols(0), m_count(0), m_size(0) {}
+   ~SearchSymbolList() { clear(); }
+    void add(Definition *d,uint letter,int category,bool inAll=TRUE);
+    void sort();
+    void clear();
+    uint count() const { return m_count; }
+    const SearchSymbol *at(uint i) const { return m_symbols[i]; }
   private:
-    uint m_letter;
+    SearchSymbol **m_symbols;
+    uint m_count;
+    uint m_size;
 };
 
-static void addMemberToSearchIndex(
-         LetterToIndexMap<SearchIndexList> symbols[NUM_SEARCH_INDICES],
-         int symbolCount[NUM_SEARCH_INDICES],
-         MemberDef *md)
+static int g_searchIndexCount[NUM_SEARCH_INDICES];
+
+void SearchSymbolList::add(Definition *d,uint letter,int category,bool inAll)
+{
+  if (m_count==m_size)
+  {
+    m_size = m_size==0 ? 1024 : m_size*2;
+    SearchSymbol **symbols = new SearchSymbol*[m_size];
+    if (m_count>0) memcpy(symbols,m_symbols,m_count*sizeof(SearchSymbol*));
+    delete[] m_symbols;
+    m_symbols = symbols;
+  }
+  SearchSymbol *sym = new SearchSymbol;
+  sym->def      = d;
+  sym->sortKey  = d->localName();
+  sym->groupKey = d->name();
+  sym->letter   = letter;
+  sym->category = category;
+  sym->inAll    = inAll;
+  sym->seq      = m_count;
+  m_symbols[m_count++] = sym;
+  if (inAll)       g_searchIndexCount[SEARCH_INDEX_ALL]++;
+  if (category>=0) g_searchIndexCount[category]++;
+}
+
+static int compareSearchSymbols(const void *p1,const void *p2)
+{
+  const SearchSymbol *s1 = *(const SearchSymbol **)p1;
+  const SearchSymbol *s2 = *(const SearchSymbol **)p2;
+  if (s1->letter!=s2->letter) return s1->letter<s2->letter ? -1 : 1;
+  int r = qstricmp(s1->sortKey,s2->sortKey);
+  if (r!=0) return r;
+  r = qstrcmp(s1->groupKey,s2->groupKey);
+  if (r!=0) return r;
+  return s1->seq<s2->seq ? -1 : s1->seq>s2->seq ? 1 : 0;
+}
+
+void SearchSymbolList::sort()
+{
+  if (m_count>1)
+  {
+    qsort(m_symbols,m_count,sizeof(SearchSymbol*),compareSearchSymbols);
+  }
+}
+
+void SearchSymbolList::clear()
+{
+  uint i;
+  for (i=0;i<m_count;i++) delete m_symbols[i];
+  delete[] m_symbols;
+  m_symbols=0;
+  m_count=m_size=0;
+}
+
+static void addMemberToSearchIndex(SearchSymbolList &symbols,MemberDef *md)
 {
   static bool hideFriendCompounds = Config_getBool("HIDE_FRIEND_COMPOUNDS");
   bool isLinkable = md->isLinkable();
@@ -671,51 +917,44 @@ static void addMemberToSearchIndex(
         (QCString(md->typeString())=="friend class" || 
          QCString(md->typeString())=="friend struct" ||
          QCString(md->typeString())=="friend union");
-      if (!(md->isFriend() && isFriendToHide))
-      {
-        symbols[SEARCH_INDEX_ALL].append(letter,md);
-        symbolCount[SEARCH_INDEX_ALL]++;
-      }
+      bool inAll = !(md->isFriend() && isFriendToHide);
+      int category = -1;
       if (md->isFunction() || md->isSlot() || md->isSignal())
       {
-        symbols[SEARCH_INDEX_FUNCTIONS].append(letter,md);
-        symbolCount[SEARCH_INDEX_FUNCTIONS]++;
+        category = SEARCH_INDEX_FUNCTIONS;
       } 
       else if (md->isVariable())
       {
-        symbols[SEARCH_INDEX_VARIABLES].append(letter,md);
-        symbolCount[SEARCH_INDEX_VARIABLES]++;
+        category = SEARCH_INDEX_VARIABLES;
       }
       else if (md->isTypedef())
       {
-        symbols[SEARCH_INDEX_TYPEDEFS].append(letter,md);
-        symbolCount[SEARCH_INDEX_TYPEDEFS]++;
+        category = SEARCH_INDEX_TYPEDEFS;
       }
       else if (md->isEnumerate())
       {
-        symbols[SEARCH_INDEX_ENUMS].append(letter,md);
-        symbolCount[SEARCH_INDEX_ENUMS]++;
+        category = SEARCH_INDEX_ENUMS;
       }
       else if (md->isEnumValue())
       {
-        symbols[SEARCH_INDEX_ENUMVALUES].append(letter,md);
-        symbolCount[SEARCH_INDEX_ENUMVALUES]++;
+        category = SEARCH_INDEX_ENUMVALUES;
       }
       else if (md->isProperty())
       {
-        symbols[SEARCH_INDEX_PROPERTIES].append(letter,md);
-        symbolCount[SEARCH_INDEX_PROPERTIES]++;
+        category = SEARCH_INDEX_PROPERTIES;
       }
       else if (md->isEvent())
       {
-        symbols[SEARCH_INDEX_EVENTS].append(letter,md);
-        symbolCount[SEARCH_INDEX_EVENTS]++;
+        category = SEARCH_INDEX_EVENTS;
       }
       else if (md->isRelated() || md->isForeign() ||
                (md->isFriend() && !isFriendToHide))
       {
-        symbols[SEARCH_INDEX_RELATED].append(letter,md);
-        symbolCount[SEARCH_INDEX_RELATED]++;
+        category = SEARCH_INDEX_RELATED;
+      }
+      if (inAll || category!=-1)
+      {
+        symbols.add(md,letter,category,inAll);
       }
     }
   }
@@ -729,39 +968,32 @@ static void addMemberToSearchIndex(
     if (!n.isEmpty()) 
     {
       uint letter = getUtf8CodeToLower(n,0);
-      symbols[SEARCH_INDEX_ALL].append(letter,md);
-      symbolCount[SEARCH_INDEX_ALL]++;
-
+      int category = -1;
       if (md->isFunction()) 
       {
-        symbols[SEARCH_INDEX_FUNCTIONS].append(letter,md);
-        symbolCount[SEARCH_INDEX_FUNCTIONS]++;
+        category = SEARCH_INDEX_FUNCTIONS;
       }
       else if (md->isVariable()) 
       {
-        symbols[SEARCH_INDEX_VARIABLES].append(letter,md);
-        symbolCount[SEARCH_INDEX_VARIABLES]++;
+        category = SEARCH_INDEX_VARIABLES;
       }
       else if (md->isTypedef())
       {
-        symbols[SEARCH_INDEX_TYPEDEFS].append(letter,md);
-        symbolCount[SEARCH_INDEX_TYPEDEFS]++;
+        category = SEARCH_INDEX_TYPEDEFS;
       }
       else if (md->isEnumerate())
       {
-        symbols[SEARCH_INDEX_ENUMS].append(letter,md);
-        symbolCount[SEARCH_INDEX_ENUMS]++;
+        category = SEARCH_INDEX_ENUMS;
       }
       else if (md->isEnumValue())
       {
-        symbols[SEARCH_INDEX_ENUMVALUES].append(letter,md);
-        symbolCount[SEARCH_INDEX_ENUMVALUES]++;
+        category = SEARCH_INDEX_ENUMVALUES;
       }
       else if (md->isDefine())
       {
-        symbols[SEARCH_INDEX_DEFINES].append(letter,md);
-        symbolCount[SEARCH_INDEX_DEFINES]++;
+        category = SEARCH_INDEX_DEFINES;
       }
+      symbols.add(md,letter,category);
     }
   }
 }
@@ -794,8 +1026,6 @@ static QCString searchId(const QCString &s)
   return result;
 }
 
-static int g_searchIndexCount[NUM_SEARCH_INDICES];
-static LetterToIndexMap<SearchIndexList> g_searchIndexSymbols[NUM_SEARCH_INDICES];
 static const char *g_searchIndexName[NUM_SEARCH_INDICES] = 
 { 
     "all",
@@ -840,22 +1070,356 @@ class SearchIndexCategoryMapping
     QCString categoryLabel[NUM_SEARCH_INDICES];
 };
 
+/** A search index file that is ready to be written to disk */
+struct SearchIndexFile
+{
+  QCString name;
+  QGString data;
+};
+
+static void writeSearchIndexFile(const SearchIndexFile *sf)
+{
+  QFile f(sf->name);
+  if (f.open(IO_WriteOnly))
+  {
+    if (sf->data.length()>0)
+    {
+      f.writeBlock(sf->data.data(),sf->data.length());
+    }
+  }
+  else
+  {
+    err("Failed to open file '%s' for writing...\n",sf->name.data());
+  }
+}
+
+/** Bounded queue of search index files to be written by the
+ *  writer threads. Adding a file blocks while the queue is full,
+ *  so only a limited number of files is kept in memory.
+ */
+class SearchIndexFileQueue
+{
+  public:
+    SearchIndexFileQueue(uint maxFiles) : m_maxFiles(maxFiles) {}
+    void enqueue(SearchIndexFile *sf)
+    {
+      QMutexLocker locker(&m_mutex);
+      while (m_queue.count()>=m_maxFiles)
+      {
+        m_notFull.wait(&m_mutex);
+      }
+      m_queue.enqueue(sf);
+      m_notEmpty.wakeOne();
+    }
+    SearchIndexFile *dequeue()
+    {
+      QMutexLocker locker(&m_mutex);
+      while (m_queue.isEmpty())
+      {
+        m_notEmpty.wait(&m_mutex);
+      }
+      SearchIndexFile *sf = m_queue.dequeue();
+      m_notFull.wakeOne();
+      return sf;
+    }
+  private:
+    QQueue<SearchIndexFile> m_queue;
+    QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+    uint m_maxFiles;
+};
+
+/** Thread writing search index files taken from a queue, until it
+ *  finds a terminator (0).
+ */
+class SearchIndexWriterThread : public QThread
+{
+  public:
+    SearchIndexWriterThread(SearchIndexFileQueue *queue) : m_queue(queue) {}
+    void run()
+    {
+      Profiler::setThreadName("SearchIndexWriterThread");
+      SearchIndexFile *sf;
+      while ((sf=m_queue->dequeue()))
+      {
+        writeSearchIndexFile(sf);
+        delete sf;
+      }
+    }
+  private:
+    SearchIndexFileQueue *m_queue;
+};
+
+static void writeSearchResultsPage(FTextStream &t,const QCString &baseName)
+{
+  t << "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\""
+    " \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">" << endl;
+  t << "<html><head><title></title>" << endl;
+  t << "<meta http-equiv=\"Content-Type\" content=\"text/xhtml;charset=UTF-8\"/>" << endl;
+  t << "<meta name=\"generator\" content=\"Doxygen " << versionString << "\">" << endl;
+  t << "<link rel=\"stylesheet\" type=\"text/css\" href=\"search.css\"/>" << endl;
+  t << "<script type=\"text/javascript\" src=\"" << baseName << ".js\"></script>" << endl;
+  t << "<script type=\"text/javascript\" src=\"search.js\"></script>" << endl;
+  t << "</head>" << endl;
+  t << "<body class=\"SRPage\">" << endl;
+  t << "<div id=\"SRIndex\">" << endl;
+  t << "<div class=\"SRStatus\" id=\"Loading\">" << theTranslator->trLoading() << "</div>" << endl;
+  t << "<div id=\"SRResults\"></div>" << endl; // here the results will be inserted
+  t << "<script type=\"text/javascript\"><!--" << endl;
+  t << "createResults();" << endl; // this function will insert the results
+  t << "--></script>" << endl;
+  t << "<div class=\"SRStatus\" id=\"Searching\">" 
+    << theTranslator->trSearching() << "</div>" << endl;
+  t << "<div class=\"SRStatus\" id=\"NoMatches\">"
+    << theTranslator->trNoMatches() << "</div>" << endl;
+
+  t << "<script type=\"text/javascript\"><!--" << endl;
+  t << "document.getElementById(\"Loading\").style.display=\"none\";" << endl;
+  t << "document.getElementById(\"NoMatches\").style.display=\"none\";" << endl;
+  t << "var searchResults = new SearchResults(\"searchResults\");" << endl;
+  t << "searchResults.Search();" << endl;
+  t << "--></script>" << endl;
+  t << "</div>" << endl; // SRIndex
+  t << "</body>" << endl;
+  t << "</html>" << endl;
+}
+
+/*! Writes the search data for the \a count symbols in \a syms, which
+ *  are sorted and all belong to the same category and letter.
+ */
+static void writeSearchData(FTextStream &ti,const SearchSymbol **syms,uint count)
+{
+  static bool extLinksInWindow = Config_getBool("EXT_LINKS_IN_WINDOW");
+  ti << "var searchData=" << endl;
+  // format
+  // searchData[] = array of items
+  // searchData[x][0] = id
+  // searchData[x][1] = [ name + child1 + child2 + .. ]
+  // searchData[x][1][0] = name as shown
+  // searchData[x][1][y+1] = info for child y
+  // searchData[x][1][y+1][0] = url
+  // searchData[x][1][y+1][1] = 1 => target="_parent"
+  // searchData[x][1][y+1][2] = scope
+
+  ti << "[" << endl;
+  bool firstEntry=TRUE;
+
+  uint first=0;
+  while (first<count) // for each entry
+  {
+    // symbols with the same name form one entry
+    uint last=first+1;
+    while (last<count && syms[last]->groupKey==syms[first]->groupKey) last++;
+
+    Definition *d = syms[first]->def;
+
+    if (!firstEntry)
+    {
+      ti << "," << endl;
+    }
+    firstEntry=FALSE;
+
+    QCString dispName = d->localName();
+    if (d->definitionType()==Definition::TypeGroup)
+    {
+      dispName = ((GroupDef*)d)->groupTitle();
+    }
+    else if (d->definitionType()==Definition::TypePage)
+    {
+      dispName = ((PageDef*)d)->title();
+    }
+    ti << "  ['" << searchId(dispName) << "',['" 
+      << convertToXML(dispName) << "',[";
+
+    if (last-first==1) // item with a unique name
+    {
+      MemberDef  *md   = 0;
+      bool isMemberDef = d->definitionType()==Definition::TypeMember;
+      if (isMemberDef) md = (MemberDef*)d;
+      QCString anchor = d->anchor();
+
+      ti << "'" << externalRef("../",d->getReference(),TRUE)
+        << d->getOutputFileBase() << Doxygen::htmlFileExtension;
+      if (!anchor.isEmpty())
+      {
+        ti << "#" << anchor;
+      }
+      ti << "',";
+
+      if (!extLinksInWindow || d->getReference().isEmpty())
+      {
+        ti << "1,";
+      }
+      else
+      {
+        ti << "0,";
+      }
+
+      if (d->getOuterScope()!=Doxygen::globalScope)
+      {
+        ti << "'" << convertToXML(d->getOuterScope()->name()) << "'";
+      }
+      else if (md)
+      {
+        FileDef *fd = md->getBodyDef();
+        if (fd==0) fd = md->getFileDef();
+        if (fd)
+        {
+          ti << "'" << convertToXML(fd->localName()) << "'";
+        }
+      }
+      else
+      {
+        ti << "''";
+      }
+      ti << "]]";
+    }
+    else // multiple items with the same name
+    {
+      bool overloadedFunction = FALSE;
+      Definition *prevScope = 0;
+      int childCount=0;
+      uint i;
+      for (i=first;i<last;i++)
+      {
+        d = syms[i]->def;
+        Definition *scope     = d->getOuterScope();
+        Definition *next      = i+1<last ? syms[i+1]->def : 0;
+        Definition *nextScope = 0;
+        MemberDef  *md        = 0;
+        bool isMemberDef = d->definitionType()==Definition::TypeMember;
+        if (isMemberDef) md = (MemberDef*)d;
+        if (next) nextScope = next->getOuterScope();
+        QCString anchor = d->anchor();
+
+        if (childCount>0)
+        {
+          ti << "],[";
+        }
+        ti << "'" << externalRef("../",d->getReference(),TRUE)
+          << d->getOutputFileBase() << Doxygen::htmlFileExtension;
+        if (!anchor.isEmpty())
+        {
+          ti << "#" << anchor;
+        }
+        ti << "',";
+
+        if (!extLinksInWindow || d->getReference().isEmpty())
+        {
+          ti << "1,";
+        }
+        else
+        {
+          ti << "0,";
+        }
+        bool found=FALSE;
+        overloadedFunction = ((prevScope!=0 && scope==prevScope) ||
+            (scope && scope==nextScope)
+            ) && md && 
+          (md->isFunction() || md->isSlot());
+        QCString prefix;
+        if (md) prefix=convertToXML(md->localName());
+        if (overloadedFunction) // overloaded member function
+        {
+          prefix+=convertToXML(md->argsString()); 
+          // show argument list to disambiguate overloaded functions
+        }
+        else if (md) // unique member function
+        {
+          prefix+="()"; // only to show it is a function
+        }
+        QCString name;
+        if (d->definitionType()==Definition::TypeClass)
+        {
+          name = convertToXML(((ClassDef*)d)->displayName());
+          found = TRUE;
+        }
+        else if (d->definitionType()==Definition::TypeNamespace)
+        {
+          name = convertToXML(((NamespaceDef*)d)->displayName());
+          found = TRUE;
+        }
+        else if (scope==0 || scope==Doxygen::globalScope) // in global scope
+        {
+          if (md)
+          {
+            FileDef *fd = md->getBodyDef();
+            if (fd==0) fd = md->getFileDef();
+            if (fd)
+            {
+              if (!prefix.isEmpty()) prefix+=":&#160;";
+              name = prefix + convertToXML(fd->localName());
+              found = TRUE;
+            }
+          }
+        }
+        else if (md && (md->getClassDef() || md->getNamespaceDef())) 
+          // member in class or namespace scope
+        {
+          SrcLangExt lang = md->getLanguage();
+          name = convertToXML(d->getOuterScope()->qualifiedName()) 
+            + getLanguageSpecificSeparator(lang) + prefix;
+          found = TRUE;
+        }
+        else if (scope) // some thing else? -> show scope
+        {
+          name = prefix + convertToXML(scope->name());
+          found = TRUE;
+        }
+        if (!found) // fallback
+        {
+          name = prefix + "("+theTranslator->trGlobalNamespace()+")";
+        }
+
+        ti << "'" << name << "'";
+
+        prevScope = scope;
+        childCount++;
+      }
+
+      ti << "]]";
+    }
+    ti << "]";
+    first=last;
+  }
+  if (!firstEntry)
+  {
+    ti << endl;
+  }
+
+  ti << "];" << endl;
+}
+
+static void addToSearchIndex(SearchSymbolList &symbols,Definition *d,
+                             uint letter,int category)
+{
+  if (isId(letter)) symbols.add(d,letter,category);
+}
+
+static uint titleLetter(const QCString &title)
+{
+  uchar charCode = title.at(0);
+  return charCode<128 ? tolower(charCode) : charCode;
+}
+
 void writeJavascriptSearchIndex()
 {
   if (!Config_getBool("GENERATE_HTML")) return;
 
+  // Phase 1: collect all symbols into a flat sorted list
+
+  SearchSymbolList symbols;
+
   // index classes
   ClassSDict::Iterator cli(*Doxygen::classSDict);
   ClassDef *cd;
   for (;(cd=cli.current());++cli)
   {
-    uint letter = getUtf8CodeToLower(cd->localName(),0);
-    if (cd->isLinkable() && isId(letter))
+    if (cd->isLinkable())
     {
-      g_searchIndexSymbols[SEARCH_INDEX_ALL].append(letter,cd);
-      g_searchIndexSymbols[SEARCH_INDEX_CLASSES].append(letter,cd);
-      g_searchIndexCount[SEARCH_INDEX_ALL]++;
-      g_searchIndexCount[SEARCH_INDEX_CLASSES]++;
+      addToSearchIndex(symbols,cd,getUtf8CodeToLower(cd->localName(),0),
+                       SEARCH_INDEX_CLASSES);
     }
   }
 
@@ -864,13 +1428,10 @@ void writeJavascriptSearchIndex()
   NamespaceDef *nd;
   for (;(nd=nli.current());++nli)
   {
-    uint letter = getUtf8CodeToLower(nd->name(),0);
-    if (nd->isLinkable() && isId(letter))
+    if (nd->isLinkable())
     {
-      g_searchIndexSymbols[SEARCH_INDEX_ALL].append(letter,nd);
-      g_searchIndexSymbols[SEARCH_INDEX_NAMESPACES].append(letter,nd);
-      g_searchIndexCount[SEARCH_INDEX_ALL]++;
-      g_searchIndexCount[SEARCH_INDEX_NAMESPACES]++;
+      addToSearchIndex(symbols,nd,getUtf8CodeToLower(nd->name(),0),
+                       SEARCH_INDEX_NAMESPACES);
     }
   }
 
@@ -883,13 +1444,10 @@ void writeJavascriptSearchIndex()
     FileDef *fd;
     for (;(fd=fni.current());++fni)
     {
-      uint letter = getUtf8CodeToLower(fd->name(),0);
-      if (fd->isLinkable() && isId(letter))
+      if (fd->isLinkable())
       {
-        g_searchIndexSymbols[SEARCH_INDEX_ALL].append(letter,fd);
-        g_searchIndexSymbols[SEARCH_INDEX_FILES].append(letter,fd);
-        g_searchIndexCount[SEARCH_INDEX_ALL]++;
-        g_searchIndexCount[SEARCH_INDEX_FILES]++;
+        addToSearchIndex(symbols,fd,getUtf8CodeToLower(fd->name(),0),
+                         SEARCH_INDEX_FILES);
       }
     }
   }
@@ -906,7 +1464,7 @@ void writeJavascriptSearchIndex()
       // for each member definition
       for (mni.toFirst();(md=mni.current());++mni)
       {
-        addMemberToSearchIndex(g_searchIndexSymbols,g_searchIndexCount,md);
+        addMemberToSearchIndex(symbols,md);
       }
     }
   }
@@ -923,7 +1481,7 @@ void writeJavascriptSearchIndex()
       // for each member definition
       for (mni.toFirst();(md=mni.current());++mni)
       {
-        addMemberToSearchIndex(g_searchIndexSymbols,g_searchIndexCount,md);
+        addMemberToSearchIndex(symbols,md);
       }
     }
   }
@@ -938,15 +1496,7 @@ void writeJavascriptSearchIndex()
       QCString title = gd->groupTitle();
       if (!title.isEmpty()) // TODO: able searching for all word in the title
       {
-        uchar charCode = title.at(0);
-        uint letter = charCode<128 ? tolower(charCode) : charCode;
-        if (isId(letter))
-        {
-          g_searchIndexSymbols[SEARCH_INDEX_ALL].append(letter,gd);
-          g_searchIndexSymbols[SEARCH_INDEX_GROUPS].append(letter,gd);
-          g_searchIndexCount[SEARCH_INDEX_ALL]++;
-          g_searchIndexCount[SEARCH_INDEX_GROUPS]++;
-        }
+        addToSearchIndex(symbols,gd,titleLetter(title),SEARCH_INDEX_GROUPS);
       }
     }
   }
@@ -961,15 +1511,7 @@ void writeJavascriptSearchIndex()
       QCString title = pd->title();
       if (!title.isEmpty())
       {
-        uchar charCode = title.at(0);
-        uint letter = charCode<128 ? tolower(charCode) : charCode;
-        if (isId(letter))
-        {
-          g_searchIndexSymbols[SEARCH_INDEX_ALL].append(letter,pd);
-          g_searchIndexSymbols[SEARCH_INDEX_PAGES].append(letter,pd);
-          g_searchIndexCount[SEARCH_INDEX_ALL]++;
-          g_searchIndexCount[SEARCH_INDEX_PAGES]++;
-        }
+        addToSearchIndex(symbols,pd,titleLetter(title),SEARCH_INDEX_PAGES);
       }
     }
   }
@@ -978,293 +1520,109 @@ void writeJavascriptSearchIndex()
     QCString title = Doxygen::mainPage->title();
     if (!title.isEmpty())
     {
-      uchar charCode = title.at(0);
-      uint letter = charCode<128 ? tolower(charCode) : charCode;
-      if (isId(letter))
-      {
-        g_searchIndexSymbols[SEARCH_INDEX_ALL].append(letter,Doxygen::mainPage);
-        g_searchIndexSymbols[SEARCH_INDEX_PAGES].append(letter,Doxygen::mainPage);
-        g_searchIndexCount[SEARCH_INDEX_ALL]++;
-        g_searchIndexCount[SEARCH_INDEX_PAGES]++;
-      }
+      addToSearchIndex(symbols,Doxygen::mainPage,titleLetter(title),
+                       SEARCH_INDEX_PAGES);
     }
   }
   
-  // sort all lists
+  symbols.sort();
+
+  // Phase 2: write a data file and a results page for each category
+  // and letter. The files are produced one at a time and handed to a
+  // set of writer threads. Producing the contents stays on this thread,
+  // since it uses definition methods that are not thread safe.
+
+  QCString searchDirName = Config_getString("HTML_OUTPUT")+"/search";
+
+  int numThreads = numProcThreads();
+  SearchIndexFileQueue queue(numThreads*4);
+  QList<SearchIndexWriterThread> writers;
+  writers.setAutoDelete(TRUE);
   int i;
-  for (i=0;i<NUM_SEARCH_INDICES;i++)
+  if (numThreads>1)
   {
-    SIntDict<SearchIndexList>::Iterator it(g_searchIndexSymbols[i]);
-    SearchIndexList *sl;
-    for (it.toFirst();(sl=it.current());++it)
+    for (i=0;i<numThreads;i++)
     {
-      sl->sort();
+      SearchIndexWriterThread *thread = new SearchIndexWriterThread(&queue);
+      thread->start();
+      if (thread->isRunning())
+      {
+        writers.append(thread);
+      }
+      else // no more threads available!
+      {
+        delete thread;
+        break;
+      }
     }
   }
 
-  // write index files
-  QCString searchDirName = Config_getString("HTML_OUTPUT")+"/search";
-
+  uint numSymbols = symbols.count();
+  const SearchSymbol **bucket = new const SearchSymbol*[QMAX(1,numSymbols)];
+  QCString letters[NUM_SEARCH_INDICES]; // letters in use per category
   for (i=0;i<NUM_SEARCH_INDICES;i++) // for each index
   {
-    SIntDict<SearchIndexList>::Iterator it(g_searchIndexSymbols[i]);
-    SearchIndexList *sl;
+    uint first=0;
     int p=0;
-    for (it.toFirst();(sl=it.current());++it,++p) // for each letter
+    while (first<numSymbols) // for each letter
     {
-      QCString baseName;
-      baseName.sprintf("%s_%x",g_searchIndexName[i],p);
-
-      QCString fileName = searchDirName + "/"+baseName+".html";
-      QCString dataFileName = searchDirName + "/"+baseName+".js";
-
-      QFile outFile(fileName);
-      QFile dataOutFile(dataFileName);
-      if (outFile.open(IO_WriteOnly) && dataOutFile.open(IO_WriteOnly))
+      uint letter = symbols.at(first)->letter;
+      uint count=0;
+      uint j;
+      for (j=first;j<numSymbols && symbols.at(j)->letter==letter;j++)
       {
+        const SearchSymbol *sym = symbols.at(j);
+        if (i==SEARCH_INDEX_ALL ? sym->inAll : sym->category==i)
         {
-          FTextStream t(&outFile);
-
-          t << "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\""
-            " \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">" << endl;
-          t << "<html><head><title></title>" << endl;
-          t << "<meta http-equiv=\"Content-Type\" content=\"text/xhtml;charset=UTF-8\"/>" << endl;
-          t << "<meta name=\"generator\" content=\"Doxygen " << versionString << "\">" << endl;
-          t << "<link rel=\"stylesheet\" type=\"text/css\" href=\"search.css\"/>" << endl;
-          t << "<script type=\"text/javascript\" src=\"" << baseName << ".js\"></script>" << endl;
-          t << "<script type=\"text/javascript\" src=\"search.js\"></script>" << endl;
-          t << "</head>" << endl;
-          t << "<body class=\"SRPage\">" << endl;
-          t << "<div id=\"SRIndex\">" << endl;
-          t << "<div class=\"SRStatus\" id=\"Loading\">" << theTranslator->trLoading() << "</div>" << endl;
-          t << "<div id=\"SRResults\"></div>" << endl; // here the results will be inserted
-          t << "<script type=\"text/javascript\"><!--" << endl;
-          t << "createResults();" << endl; // this function will insert the results
-          t << "--></script>" << endl;
-          t << "<div class=\"SRStatus\" id=\"Searching\">" 
-            << theTranslator->trSearching() << "</div>" << endl;
-          t << "<div class=\"SRStatus\" id=\"NoMatches\">"
-            << theTranslator->trNoMatches() << "</div>" << endl;
-
-          t << "<script type=\"text/javascript\"><!--" << endl;
-          t << "document.getElementById(\"Loading\").style.display=\"none\";" << endl;
-          t << "document.getElementById(\"NoMatches\").style.display=\"none\";" << endl;
-          t << "var searchResults = new SearchResults(\"searchResults\");" << endl;
-          t << "searchResults.Search();" << endl;
-          t << "--></script>" << endl;
-          t << "</div>" << endl; // SRIndex
-          t << "</body>" << endl;
-          t << "</html>" << endl;
+          bucket[count++]=sym;
         }
-        FTextStream ti(&dataOutFile);
-
-        ti << "var searchData=" << endl;
-        // format
-        // searchData[] = array of items
-        // searchData[x][0] = id
-        // searchData[x][1] = [ name + child1 + child2 + .. ]
-        // searchData[x][1][0] = name as shown
-        // searchData[x][1][y+1] = info for child y
-        // searchData[x][1][y+1][0] = url
-        // searchData[x][1][y+1][1] = 1 => target="_parent"
-        // searchData[x][1][y+1][2] = scope
-
-        ti << "[" << endl;
-        bool firstEntry=TRUE;
-
-        SDict<SearchDefinitionList>::Iterator li(*sl);
-        SearchDefinitionList *dl;
-        int itemCount=0;
-        for (li.toFirst();(dl=li.current());++li)
-        {
-          Definition *d = dl->first();
-          QCString id = d->localName();
-
-          if (!firstEntry)
-          {
-            ti << "," << endl;
-          }
-          firstEntry=FALSE;
-
-          QCString dispName = d->localName();
-          if (d->definitionType()==Definition::TypeGroup)
-          {
-            dispName = ((GroupDef*)d)->groupTitle();
-          }
-          else if (d->definitionType()==Definition::TypePage)
-          {
-            dispName = ((PageDef*)d)->title();
-          }
-          ti << "  ['" << searchId(dispName) << "',['" 
-            << convertToXML(dispName) << "',[";
-
-          if (dl->count()==1) // item with a unique name
-          {
-            MemberDef  *md   = 0;
-            bool isMemberDef = d->definitionType()==Definition::TypeMember;
-            if (isMemberDef) md = (MemberDef*)d;
-            QCString anchor = d->anchor();
-
-            ti << "'" << externalRef("../",d->getReference(),TRUE)
-              << d->getOutputFileBase() << Doxygen::htmlFileExtension;
-            if (!anchor.isEmpty())
-            {
-              ti << "#" << anchor;
-            }
-            ti << "',";
-
-            static bool extLinksInWindow = Config_getBool("EXT_LINKS_IN_WINDOW");
-            if (!extLinksInWindow || d->getReference().isEmpty())
-            {
-              ti << "1,";
-            }
-            else
-            {
-              ti << "0,";
-            }
+      }
+      first=j;
+      if (count==0) continue;
 
-            if (d->getOuterScope()!=Doxygen::globalScope)
-            {
-              ti << "'" << convertToXML(d->getOuterScope()->name()) << "'";
-            }
-            else if (md)
-            {
-              FileDef *fd = md->getBodyDef();
-              if (fd==0) fd = md->getFileDef();
-              if (fd)
-              {
-                ti << "'" << convertToXML(fd->localName()) << "'";
-              }
-            }
-            else
-            {
-              ti << "''";
-            }
-            ti << "]]";
-          }
-          else // multiple items with the same name
-          {
-            QListIterator<Definition> di(*dl);
-            bool overloadedFunction = FALSE;
-            Definition *prevScope = 0;
-            int childCount=0;
-            for (di.toFirst();(d=di.current());)
-            {
-              ++di;
-              Definition *scope     = d->getOuterScope();
-              Definition *next      = di.current();
-              Definition *nextScope = 0;
-              MemberDef  *md        = 0;
-              bool isMemberDef = d->definitionType()==Definition::TypeMember;
-              if (isMemberDef) md = (MemberDef*)d;
-              if (next) nextScope = next->getOuterScope();
-              QCString anchor = d->anchor();
-
-              if (childCount>0)
-              {
-                ti << "],[";
-              }
-              ti << "'" << externalRef("../",d->getReference(),TRUE)
-                << d->getOutputFileBase() << Doxygen::htmlFileExtension;
-              if (!anchor.isEmpty())
-              {
-                ti << "#" << anchor;
-              }
-              ti << "',";
-
-              static bool extLinksInWindow = Config_getBool("EXT_LINKS_IN_WINDOW");
-              if (!extLinksInWindow || d->getReference().isEmpty())
-              {
-                ti << "1,";
-              }
-              else
-              {
-                ti << "0,";
-              }
-              bool found=FALSE;
-              overloadedFunction = ((prevScope!=0 && scope==prevScope) ||
-                  (scope && scope==nextScope)
-                  ) && md && 
-                (md->isFunction() || md->isSlot());
-              QCString prefix;
-              if (md) prefix=convertToXML(md->localName());
-              if (overloadedFunction) // overloaded member function
-              {
-                prefix+=convertToXML(md->argsString()); 
-                // show argument list to disambiguate overloaded functions
-              }
-              else if (md) // unique member function
-              {
-                prefix+="()"; // only to show it is a function
-              }
-              QCString name;
-              if (d->definitionType()==Definition::TypeClass)
-              {
-                name = convertToXML(((ClassDef*)d)->displayName());
-                found = TRUE;
-              }
-              else if (d->definitionType()==Definition::TypeNamespace)
-              {
-                name = convertToXML(((NamespaceDef*)d)->displayName());
-                found = TRUE;
-              }
-              else if (scope==0 || scope==Doxygen::globalScope) // in global scope
-              {
-                if (md)
-                {
-                  FileDef *fd = md->getBodyDef();
-                  if (fd==0) fd = md->getFileDef();
-                  if (fd)
-                  {
-                    if (!prefix.isEmpty()) prefix+=":&#160;";
-                    name = prefix + convertToXML(fd->localName());
-                    found = TRUE;
-                  }
-                }
-              }
-              else if (md && (md->getClassDef() || md->getNamespaceDef())) 
-                // member in class or namespace scope
-              {
-                SrcLangExt lang = md->getLanguage();
-                name = convertToXML(d->getOuterScope()->qualifiedName()) 
-                  + getLanguageSpecificSeparator(lang) + prefix;
-                found = TRUE;
-              }
-              else if (scope) // some thing else? -> show scope
-              {
-                name = prefix + convertToXML(scope->name());
-                found = TRUE;
-              }
-              if (!found) // fallback
-              {
-                name = prefix + "("+theTranslator->trGlobalNamespace()+")";
-              }
-
-              ti << "'" << name << "'";
-
-              prevScope = scope;
-              childCount++;
-            }
+      letters[i] += QString(QChar(letter)).utf8();
 
-            ti << "]]";
-          }
-          ti << "]";
-          itemCount++;
-        }
-        if (!firstEntry)
-        {
-          ti << endl;
-        }
-
-        ti << "];" << endl;
+      QCString baseName;
+      baseName.sprintf("%s_%x",g_searchIndexName[i],p++);
 
+      SearchIndexFile *page = new SearchIndexFile;
+      page->name = searchDirName + "/"+baseName+".html";
+      {
+        FTextStream t(&page->data);
+        writeSearchResultsPage(t,baseName);
+      }
+      SearchIndexFile *data = new SearchIndexFile;
+      data->name = searchDirName + "/"+baseName+".js";
+      {
+        FTextStream ti(&data->data);
+        writeSearchData(ti,bucket,count);
+      }
+      if (writers.count()>0)
+      {
+        queue.enqueue(page);
+        queue.enqueue(data);
       }
       else
       {
-        err("Failed to open file '%s' for writing...\n",fileName.data());
+        writeSearchIndexFile(page);
+        writeSearchIndexFile(data);
+        delete page;
+        delete data;
       }
     }
   }
+  delete[] bucket;
+  symbols.clear();
+
+  // wait for the writers to finish
+  for (i=0;i<(int)writers.count();i++)
+  {
+    queue.enqueue(0); // add terminator for each writer
+  }
+  for (i=0;i<(int)writers.count();i++)
+  {
+    writers.at(i)->wait();
+  }
 
   {
     QFile f(searchDirName+"/search.js");
@@ -1287,13 +1645,7 @@ void writeJavascriptSearchIndex()
           if (!first) t << "," << endl;
           t << "  " << j << ": \"";
 
-          SIntDict<SearchIndexList>::Iterator it(g_searchIndexSymbols[i]);
-          SearchIndexList *sl;
-          for (it.toFirst();(sl=it.current());++it) // for each letter
-          {
-            t << QString( QChar( sl->letter() ) ).utf8();
-          }
-          t << "\"";
+          t << letters[i] << "\"";
           first=FALSE;
           j++;
         }
@@ -103,6 +103,7 @@ class SearchIndexExternal : public SearchIndexIntf
     void setCurrentDoc(Definition *ctx,const char *anchor,bool isSourceFile);
     void addWord(const char *word,bool hiPriority);
     void write(const char *file);
+    void writeCompactIndex(const char *file);
   private:
     Private *p;
 };
@@ -39,6 +39,8 @@
 #include "dirdef.h"
 
 #include <qdir.h>
+#include <qdict.h>
+#include <qptrdict.h>
 #include <string.h>
 #include <sqlite3.h>
 
@@ -47,34 +49,163 @@
 
 static void generateSqlite3ForMember(sqlite3*db,MemberDef *md,Definition *def);
 
+/** Number of rows written by a single multi-row INSERT statement.
+ *  Together with the number of columns this must stay below
+ *  SQLITE_MAX_VARIABLE_NUMBER (999 by default).
+ */
+#define SQLITE3_BATCH_ROWS 100
+
+/** Collects the rows for a table and inserts them using multi-row INSERT
+ *  statements, so only one statement needs to be executed per batch.
+ */
+class InsertBatch
+{
+  public:
+    InsertBatch(const char *table,const char *columns,int numColumns);
+   ~InsertBatch();
+    int  prepare(sqlite3 *db);
+    void addText(const char *value);
+    void addInt(int value);
+    void endRow();
+    void flush();
+    void finalize();
+
+  private:
+    struct Value
+    {
+      Value() : intValue(0), isText(FALSE) {}
+      QCString text;
+      int intValue;
+      bool isText;
+    };
+    sqlite3_stmt *prepareInsert(int numRows);
+    void bindRows(sqlite3_stmt *stmt,int firstRow,int numRows);
+    QCString      m_table;
+    QCString      m_columns;
+    int           m_numColumns;
+    Value        *m_values;
+    int           m_numValues;
+    sqlite3      *m_db;
+    sqlite3_stmt *m_batchStmt; // inserts SQLITE3_BATCH_ROWS rows
+    sqlite3_stmt *m_rowStmt;   // inserts a single row
+};
+
+InsertBatch::InsertBatch(const char *table,const char *columns,int numColumns)
+  : m_table(table), m_columns(columns), m_numColumns(numColumns),
+    m_values(0), m_numValues(0), m_db(0), m_batchStmt(0), m_rowStmt(0)
+{
+}
+
+InsertBatch::~InsertBatch()
+{
+  delete[] m_values;
+}
+
+sqlite3_stmt *InsertBatch::prepareInsert(int numRows)
+{
+  QCString row = "(?";
+  int i;
+  for (i=1;i<m_numColumns;i++) row+=",?";
+  row+=")";
+  QCString query = "INSERT OR REPLACE INTO "+m_table+" ("+m_columns+") VALUES "+row;
+  for (i=1;i<numRows;i++) query+=","+row;
+  sqlite3_stmt *stmt=0;
+  if (sqlite3_prepare_v2(m_db,query,-1,&stmt,0)!=SQLITE_OK)
+  {
+    msg("prepare failed for %s\n%s\n", query.data(), sqlite3_errmsg(m_db));
+    return 0;
+  }
+  return stmt;
+}
+
+int InsertBatch::prepare(sqlite3 *db)
+{
+  m_db = db;
+  if (m_values==0) m_values = new Value[SQLITE3_BATCH_ROWS*m_numColumns];
+  m_numValues = 0;
+  m_batchStmt = prepareInsert(SQLITE3_BATCH_ROWS);
+  m_rowStmt   = prepareInsert(1);
+  return m_batchStmt && m_rowStmt ? 0 : -1;
+}
+
+void InsertBatch::addText(const char *value)
+{
+  Value &v = m_values[m_numValues++];
+  v.text   = value;
+  v.isText = TRUE;
+}
+
+void InsertBatch::addInt(int value)
+{
+  Value &v = m_values[m_numValues++];
+  v.intValue = value;
+  v.isText   = FALSE;
+}
+
+void InsertBatch::endRow()
+{
+  if (m_numValues==SQLITE3_BATCH_ROWS*m_numColumns) flush();
+}
+
+void InsertBatch::bindRows(sqlite3_stmt *stmt,int firstRow,int numRows)
+{
+  int i,first=firstRow*m_numColumns,n=numRows*m_numColumns;
+  for (i=0;i<n;i++)
+  {
+    const Value &v = m_values[first+i];
+    if (v.isText)
+    {
+      // a null string is bound as "" to satisfy the NOT NULL constraints
+      sqlite3_bind_text(stmt,i+1,v.text.isNull() ? "" : v.text.data(),-1,SQLITE_STATIC);
+    }
+    else
+    {
+      sqlite3_bind_int(stmt,i+1,v.intValue);
+    }
+  }
+  if (sqlite3_step(stmt)!=SQLITE_DONE)
+  {
+    msg("sqlite3_step failed: %s\n", sqlite3_errmsg(m_db));
+  }
+  sqlite3_reset(stmt);
+}
+
+void InsertBatch::flush()
+{
+  int numRows = m_numValues/m_numColumns;
+  if (numRows==SQLITE3_BATCH_ROWS)
+  {
+    bindRows(m_batchStmt,0,numRows);
+  }
+  else
+  {
+    int row;
+    for (row=0;row<numRows;row++) bindRows(m_rowStmt,row,1);
+  }
+  m_numValues = 0;
+}
+
+void InsertBatch::finalize()
+{
+  if (m_db) flush();
+  sqlite3_finalize(m_batchStmt);
+  sqlite3_finalize(m_rowStmt);
+  m_batchStmt = m_rowStmt = 0;
+  m_db = 0;
+}
+
 //////////////////////////////////////////////////////
-const char *i_q_includes="INSERT OR REPLACE INTO includes "
-                            "( local, id_src, dst ) "
-                            "VALUES "
-                            "(:local,:id_src,:dst )" ;
-const char *c_q_includes="SELECT count(*) FROM includes WHERE local=:local and id_src=:id_src and dst=:dst";
-static sqlite3_stmt *c_s_includes=0;
-static sqlite3_stmt *i_s_includes=0;
+static InsertBatch b_includes("includes","local, id_src, dst",3);
 //////////////////////////////////////////////////////
-const char *i_q_innerclass="INSERT OR REPLACE INTO innerclass "
-                            "( refid, prot, name )"
-                            "VALUES "
-                            "(:refid,:prot,:name )";
-static sqlite3_stmt *i_s_innerclass=0;
+static InsertBatch b_innerclass("innerclass","refid, prot, name",3);
 //////////////////////////////////////////////////////
 const char *i_q_files="INSERT OR REPLACE INTO files "
                             "( name )"
                             "VALUES "
                             "(:name )";
-const char *id_q_files="SELECT id FROM files WHERE name=:name";
-static sqlite3_stmt *id_s_files=0;
 static sqlite3_stmt *i_s_files=0;
 //////////////////////////////////////////////////////
-const char *i_q_xrefs="INSERT OR REPLACE INTO xrefs "
-                            "( src, dst, id_file, line, column )"
-                            "VALUES "
-                            "(:src,:dst,:id_file,:line,:column )";
-static sqlite3_stmt *i_s_xrefs=0;
+static InsertBatch b_xrefs("xrefs","src, dst, id_file, line, column",5);
 //////////////////////////////////////////////////////
 const char *i_q_memberdef="INSERT OR REPLACE INTO memberdef "
                             "( refid, prot, static, const, explicit, inline, final, sealed, new, optional, required, virt, mutable, initonly, readable, writable, gettable, settable, accessor, addable, removable, raisable, name, type, definition, argsstring, scope, initializer, kind, id_bfile, bline, bcolumn, id_file, line, column)"
@@ -211,6 +342,27 @@ const char * schema_queries[][2] =
   },
 };
 
+/** Indexes are created after all data has been inserted, which is faster
+ *  than updating them for every row. */
+const char * index_queries[] =
+{
+  "CREATE INDEX IF NOT EXISTS idx_files_name ON files (name)",
+  "CREATE INDEX IF NOT EXISTS idx_compounddef_refid ON compounddef (refid)",
+  "CREATE INDEX IF NOT EXISTS idx_memberdef_refid ON memberdef (refid)",
+  "CREATE INDEX IF NOT EXISTS idx_xrefs_src ON xrefs (src)",
+  "CREATE INDEX IF NOT EXISTS idx_xrefs_dst ON xrefs (dst)",
+  "CREATE INDEX IF NOT EXISTS idx_includes_id_src ON includes (id_src)",
+};
+
+/** ids of the rows in the files table, so no query is needed to find them */
+static QDict<int> g_fileIds(10007);
+
+/** the includes that have been written, as "local:id_src:dst" */
+static QDict<void> g_includes(10007);
+
+/** the members that have been written, a member can be part of several lists */
+static QPtrDict<void> g_members(10007);
+
 
 class TextGeneratorSqlite3Impl : public TextGeneratorIntf
 {
@@ -270,34 +422,42 @@ static int step(sqlite3 *db, sqlite3_stmt *stmt,bool getRowId=FALSE)
 
 static int insertFile(sqlite3 *db, const char* name)
 {
-  int id=-1;
   if (name==0) return -1;
 
   // see if it's already in DB
-  bindTextParameter(id_s_files,":name",name);
-  id=step(db,id_s_files,TRUE);
-  if (id==0)
-  {
-    // insert it
-    bindTextParameter(i_s_files,":name",name);
-
-    step(db,i_s_files);
-    id=sqlite3_last_insert_rowid(db);
-  }
+  int *pId = g_fileIds.find(name);
+  if (pId) return *pId;
+
+  // insert it
+  bindTextParameter(i_s_files,":name",name);
+  if (-1==step(db,i_s_files)) return -1;
+  int id=sqlite3_last_insert_rowid(db);
+  g_fileIds.insert(name,new int(id));
   return id;
 }
 
-static int insertMemberReference(sqlite3 *db, const char*src, const char*dst, const char *file, int line, int column)
+static void insertInclude(bool local,int id_src,const char *dst,bool unique=FALSE)
 {
-  int id_file = insertFile(db,file);
-  bindTextParameter(i_s_xrefs,":src",src);
-  bindTextParameter(i_s_xrefs,":dst",dst);
-
-  bindIntParameter(i_s_xrefs,":id_file",id_file);
-  bindIntParameter(i_s_xrefs,":line",line);
-  bindIntParameter(i_s_xrefs,":column",column);
+  QCString key;
+  key.sprintf("%d:%d:",local,id_src);
+  key+=dst;
+  if (unique && g_includes.find(key)) return;
+  g_includes.insert(key,(void*)0x8);
+  b_includes.addInt(local);
+  b_includes.addInt(id_src);
+  b_includes.addText(dst);
+  b_includes.endRow();
+}
 
-return step(db,i_s_xrefs);
+static void insertMemberReference(sqlite3 *db, const char*src, const char*dst, const char *file, int line, int column)
+{
+  int id_file = insertFile(db,file);
+  b_xrefs.addText(src);
+  b_xrefs.addText(dst);
+  b_xrefs.addInt(id_file);
+  b_xrefs.addInt(line);
+  b_xrefs.addInt(column);
+  b_xrefs.endRow();
 }
 
 static void insertMemberReference(sqlite3 *db, MemberDef *src, MemberDef *dst, const char*floc)
@@ -343,16 +503,14 @@ static int prepareStatements(sqlite3 *db)
 {
   if (
   -1==prepareStatement(db, id_q_memberdef, &id_s_memberdef) ||
-  -1==prepareStatement(db, id_q_files, &id_s_files) ||
   -1==prepareStatement(db, i_q_files, &i_s_files) ||
-  -1==prepareStatement(db, i_q_xrefs, &i_s_xrefs) ||
-  -1==prepareStatement(db, i_q_innerclass, &i_s_innerclass) ||
+  -1==b_xrefs.prepare(db) ||
+  -1==b_innerclass.prepare(db) ||
   -1==prepareStatement(db, i_q_memberdef, &i_s_memberdef) ||
   -1==prepareStatement(db, i_q_compounddef, &i_s_compounddef) ||
   -1==prepareStatement(db, i_q_basecompoundref, &i_s_basecompoundref) ||
   -1==prepareStatement(db, i_q_derivedcompoundref, &i_s_derivedcompoundref) ||
-  -1==prepareStatement(db, i_q_includes, &i_s_includes)||
-  -1==prepareStatement(db, c_q_includes, &c_s_includes)
+  -1==b_includes.prepare(db)
   )
   {
     return -1;
@@ -360,6 +518,21 @@ static int prepareStatements(sqlite3 *db)
   return 0;
 }
 
+static void finalizeStatements()
+{
+  b_xrefs.finalize();
+  b_innerclass.finalize();
+  b_includes.finalize();
+  sqlite3_finalize(id_s_memberdef);
+  sqlite3_finalize(i_s_files);
+  sqlite3_finalize(i_s_memberdef);
+  sqlite3_finalize(i_s_compounddef);
+  sqlite3_finalize(i_s_basecompoundref);
+  sqlite3_finalize(i_s_derivedcompoundref);
+  id_s_memberdef=i_s_files=i_s_memberdef=i_s_compounddef=0;
+  i_s_basecompoundref=i_s_derivedcompoundref=0;
+}
+
 static void beginTransaction(sqlite3 *db)
 {
   char * sErrMsg = 0;
@@ -407,8 +580,22 @@ static int initializeSchema(sqlite3* db)
   return 0;
 }
 
+static void createIndexes(sqlite3* db)
+{
+  msg("Creating DB indexes...\n");
+  for (unsigned int k = 0; k < sizeof(index_queries) / sizeof(index_queries[0]); k++)
+  {
+    char * sErrMsg = 0;
+    if (sqlite3_exec(db, index_queries[k], NULL, NULL, &sErrMsg)!=SQLITE_OK)
+    {
+      msg("failed to execute query: %s\n\t%s\n", index_queries[k], sErrMsg);
+      sqlite3_free(sErrMsg);
+    }
+  }
+}
+
 ////////////////////////////////////////////
-static void writeInnerClasses(sqlite3*db,const ClassSDict *cl)
+static void writeInnerClasses(sqlite3* /*db*/,const ClassSDict *cl)
 {
   if (!cl) return;
 
@@ -418,11 +605,10 @@ static void writeInnerClasses(sqlite3*db,const ClassSDict *cl)
   {
     if (!cd->isHidden() && cd->name().find('@')==-1) // skip anonymous scopes
     {
-      bindTextParameter(i_s_innerclass,":refid",cd->getOutputFileBase(),FALSE);
-      bindIntParameter(i_s_innerclass,":prot",cd->protection());
-      bindTextParameter(i_s_innerclass,":name",cd->name());
-      if (-1==step(db,i_s_innerclass))
-          return;
+      b_innerclass.addText(cd->getOutputFileBase());
+      b_innerclass.addInt(cd->protection());
+      b_innerclass.addText(cd->name());
+      b_innerclass.endRow();
     }
   }
 }
@@ -476,11 +662,14 @@ static void generateSqlite3ForMember(sqlite3*db,MemberDef *md,Definition *def)
   // + template arguments
   //     (templateArguments(), definitionTemplateParameterLists())
   // - call graph
-  msg("=====%s\n",md->name().data());
+  DBG_CTX(("=====%s\n",md->name().data()));
 
   // enum values are written as part of the enum
   if (md->memberType()==MemberType_EnumValue) return;
   if (md->isHidden()) return;
+  // a member can appear in several member lists, but is written only once
+  if (g_members.find(md)) return;
+  g_members.insert(md,(void*)0x8);
   //if (md->name().at(0)=='@') return; // anonymous member
 
   // group members are only visible in their group
@@ -762,7 +951,7 @@ static void generateSqlite3Section(sqlite3*db,
   int count=0;
   for (mli.toFirst();(md=mli.current());++mli)
   {
-    msg("I:%s\n",md->name().data());
+    DBG_CTX(("I:%s\n",md->name().data()));
     // namespace members are also inserted in the file scope, but
     // to prevent this duplication in the XML output, we filter those here.
     if (d->definitionType()!=Definition::TypeFile || md->getNamespaceDef()==0)
@@ -877,18 +1066,7 @@ static void generateSqlite3ForClass(sqlite3 *db, ClassDef *cd)
     if (nm.isEmpty() && ii->fileDef) nm = ii->fileDef->docName();
     if (!nm.isEmpty())
     {
-      bindIntParameter(c_s_includes,":local",ii->local);
-      bindIntParameter(c_s_includes,":id_src",id_file);
-      bindTextParameter(c_s_includes,":dst",nm);
-      int count=step(db,c_s_includes,TRUE);
-      if (count==0)
-      {
-        bindIntParameter(i_s_includes,":local",ii->local);
-        bindIntParameter(i_s_includes,":id_src",id_file);
-        bindTextParameter(i_s_includes,":dst",nm);
-        if (-1==step(db,i_s_includes))
-          return;
-      }
+      insertInclude(ii->local,id_file,nm,TRUE);
     }
   }
 
@@ -991,11 +1169,7 @@ static void generateSqlite3ForFile(sqlite3 *db, FileDef *fd)
     for (ili.toFirst();(ii=ili.current());++ili)
     {
       int id_file=insertFile(db,fd->absFilePath().data());
-      bindIntParameter(i_s_includes,":local",ii->local);
-      bindIntParameter(i_s_includes,":id_src",id_file);
-      bindTextParameter(i_s_includes,":dst",ii->includeName.data(),FALSE);
-      if (-1==step(db,i_s_includes))
-        continue;
+      insertInclude(ii->local,id_file,ii->includeName);
     }
   }
 
@@ -1006,12 +1180,7 @@ static void generateSqlite3ForFile(sqlite3 *db, FileDef *fd)
     for (ili.toFirst();(ii=ili.current());++ili)
     {
       int id_file=insertFile(db,ii->includeName);
-      bindIntParameter(i_s_includes,":local",ii->local);
-      bindIntParameter(i_s_includes,":id_src",id_file);
-      bindTextParameter(i_s_includes,":dst",fd->absFilePath().data(),FALSE);
-      if (-1==step(db,i_s_includes))
-        continue;
-
+      insertInclude(ii->local,id_file,fd->absFilePath());
     }
   }
 
@@ -1078,6 +1247,12 @@ void generateSqlite3()
 
   QCString outputDirectory = Config_getString("OUTPUT_DIRECTORY");
   QDir sqlite3Dir(outputDirectory);
+  // start from an empty database, so the in-memory id maps are complete
+  sqlite3Dir.remove("doxygen_sqlite3.db");
+  g_fileIds.setAutoDelete(TRUE);
+  g_fileIds.clear();
+  g_includes.clear();
+  g_members.clear();
   sqlite3 *db;
   sqlite3_initialize();
   int rc = sqlite3_open_v2(outputDirectory+"/doxygen_sqlite3.db", &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, 0);
@@ -1087,8 +1262,8 @@ void generateSqlite3()
     msg("database open failed: %s\n", "doxygen_sqlite3.db");
     return;
   }
-  beginTransaction(db);
   pragmaTuning(db);
+  beginTransaction(db);
 
   if (-1==initializeSchema(db))
     return;
@@ -1180,7 +1355,13 @@ void generateSqlite3()
     generateSqlite3ForPage(db,Doxygen::mainPage,FALSE);
   }
 
+  finalizeStatements();
+  createIndexes(db);
   endTransaction(db);
+  sqlite3_close(db);
+  g_fileIds.clear();
+  g_includes.clear();
+  g_members.clear();
 }
 
 #else // USE_SQLITE3
@@ -94,6 +94,12 @@ class Store : public StorageIntf
 
     void printStats();
 
+    /*! Returns the number of blocks read so far */
+    int reads() const { return m_reads; }
+
+    /*! Returns the number of blocks written so far */
+    int writes() const { return m_writes; }
+
     portable_off_t pos() const { return m_cur; }
 
     void dumpBlock(portable_off_t start,portable_off_t end);
@@ -20,6 +20,8 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include <qxml.h>
 #include <qstack.h>
@@ -27,7 +29,9 @@
 #include <qfileinfo.h>
 #include <qlist.h>
 #include <qstring.h>
-#include <qstringlist.h>
+#include <qvaluelist.h>
+#include <qfile.h>
+#include <qdir.h>
 
 #include "entry.h"
 #include "classdef.h"
@@ -39,6 +43,14 @@
 #include "filedef.h"
 #include "filename.h"
 #include "section.h"
+#include "config.h"
+#include "filestorage.h"
+#include "marshal.h"
+#include "md5.h"
+#include "portable.h"
+
+/** List of names as they appear in the tag file (in UTF-8) */
+typedef QValueList<QCString> TagStringList;
 
 /** Information about an linkable anchor */
 class TagAnchorInfo
@@ -105,7 +117,7 @@ class TagClassInfo
     QList<BaseInfo> *bases;
     QList<TagMemberInfo> members;
     QList<QCString> *templateArguments;
-    QStringList classList;
+    TagStringList classList;
     Kind kind;
     bool isObjC;
 };
@@ -118,8 +130,8 @@ class TagNamespaceInfo
     QCString name;
     QCString filename;
     QCString clangId;
-    QStringList classList;
-    QStringList namespaceList;
+    TagStringList classList;
+    TagStringList namespaceList;
     TagAnchorInfoList docAnchors;
     QList<TagMemberInfo> members;
 };
@@ -133,7 +145,7 @@ class TagPackageInfo
     QCString filename;
     TagAnchorInfoList docAnchors;
     QList<TagMemberInfo> members;
-    QStringList classList;
+    TagStringList classList;
 };
 
 /** Container for include info that can be read from a tagfile */
@@ -157,8 +169,8 @@ class TagFileInfo
     QCString filename;
     TagAnchorInfoList docAnchors;
     QList<TagMemberInfo> members;
-    QStringList classList;
-    QStringList namespaceList;
+    TagStringList classList;
+    TagStringList namespaceList;
     QList<TagIncludeInfo> includes;
 };
 
@@ -172,12 +184,12 @@ class TagGroupInfo
     QCString filename;
     TagAnchorInfoList docAnchors;
     QList<TagMemberInfo> members;
-    QStringList subgroupList;
-    QStringList classList;
-    QStringList namespaceList;
-    QStringList fileList;
-    QStringList pageList;
-    QStringList dirList;
+    TagStringList subgroupList;
+    TagStringList classList;
+    TagStringList namespaceList;
+    TagStringList fileList;
+    TagStringList pageList;
+    TagStringList dirList;
 };
 
 /** Container for page specific info that can be read from a tagfile */
@@ -197,11 +209,19 @@ class TagDirInfo
     QCString name;
     QCString filename;
     QCString path;
-    QStringList subdirList;
-    QStringList fileList;
+    TagStringList subdirList;
+    TagStringList fileList;
     TagAnchorInfoList docAnchors;
 };
 
+/** Identifies the contents of a tag file, see parseTagFile() */
+struct TagFileStamp
+{
+  QCString path;
+  uint64   size;
+  uint64   mtime;
+};
+
 /** Tag file parser. 
  *
  *  Reads an XML-structured tagfile and builds up the structure in
@@ -247,10 +267,17 @@ class TagFileParser : public QXmlDefaultHandler
   public:
     TagFileParser(const char *tagName) : m_startElementHandlers(17),
                                          m_endElementHandlers(17),
-                                         m_tagName(tagName)
+                                         m_tagName(tagName), m_locator(0)
     {
       m_startElementHandlers.setAutoDelete(TRUE);
       m_endElementHandlers.setAutoDelete(TRUE);
+      m_tagFileClasses.setAutoDelete(TRUE);
+      m_tagFileFiles.setAutoDelete(TRUE);
+      m_tagFileNamespaces.setAutoDelete(TRUE);
+      m_tagFileGroups.setAutoDelete(TRUE);
+      m_tagFilePages.setAutoDelete(TRUE);
+      m_tagFilePackages.setAutoDelete(TRUE);
+      m_tagFileDirs.setAutoDelete(TRUE);
     }
     
     void setDocumentLocator ( QXmlLocator * locator )
@@ -265,11 +292,11 @@ class TagFileParser : public QXmlDefaultHandler
 
     void warn(const char *fmt)
     {
-      ::warn(m_inputFileName,m_locator->lineNumber(),fmt);
+      ::warn(m_inputFileName,m_locator ? m_locator->lineNumber() : 0,fmt);
     }
     void warn(const char *fmt,const char *s)
     {
-      ::warn(m_inputFileName,m_locator->lineNumber(),fmt,s);
+      ::warn(m_inputFileName,m_locator ? m_locator->lineNumber() : 0,fmt,s);
     }
 
     void startCompound( const QXmlAttributes& attrib )
@@ -778,13 +805,6 @@ class TagFileParser : public QXmlDefaultHandler
       m_curDir=0;
 
       m_stateStack.setAutoDelete(TRUE);
-      m_tagFileClasses.setAutoDelete(TRUE);
-      m_tagFileFiles.setAutoDelete(TRUE);
-      m_tagFileNamespaces.setAutoDelete(TRUE);
-      m_tagFileGroups.setAutoDelete(TRUE);
-      m_tagFilePages.setAutoDelete(TRUE);
-      m_tagFilePackages.setAutoDelete(TRUE);
-      m_tagFileDirs.setAutoDelete(TRUE);
 
       m_startElementHandlers.insert("compound",    new StartElementHandler(this,&TagFileParser::startCompound));
       m_startElementHandlers.insert("member",      new StartElementHandler(this,&TagFileParser::startMember));
@@ -877,6 +897,8 @@ class TagFileParser : public QXmlDefaultHandler
     void dump();
     void buildLists(Entry *root);
     void addIncludes();
+    void writeCache(StorageIntf *s,const TagFileStamp &stamp);
+    bool readCache(StorageIntf *s,const TagFileStamp &stamp);
     
   private:
     void buildMemberList(Entry *ce,QList<TagMemberInfo> &members);
@@ -979,11 +1001,11 @@ void TagFileParser::dump()
   {
     msg("namespace `%s'\n",nd->name.data());
     msg("  filename `%s'\n",nd->filename.data());
-    QStringList::Iterator it;
+    TagStringList::Iterator it;
     for ( it = nd->classList.begin(); 
         it != nd->classList.end(); ++it ) 
     {
-      msg( "  class: %s \n", (*it).latin1() );
+      msg( "  class: %s \n", (*it).data() );
     }
 
     QListIterator<TagMemberInfo> mci(nd->members);
@@ -1004,16 +1026,16 @@ void TagFileParser::dump()
   {
     msg("file `%s'\n",fd->name.data());
     msg("  filename `%s'\n",fd->filename.data());
-    QStringList::Iterator it;
+    TagStringList::Iterator it;
     for ( it = fd->namespaceList.begin(); 
         it != fd->namespaceList.end(); ++it ) 
     {
-      msg( "  namespace: %s \n", (*it).latin1() );
+      msg( "  namespace: %s \n", (*it).data() );
     }
     for ( it = fd->classList.begin(); 
         it != fd->classList.end(); ++it ) 
     {
-      msg( "  class: %s \n", (*it).latin1() );
+      msg( "  class: %s \n", (*it).data() );
     }
 
     QListIterator<TagMemberInfo> mci(fd->members);
@@ -1042,31 +1064,31 @@ void TagFileParser::dump()
   {
     msg("group `%s'\n",gd->name.data());
     msg("  filename `%s'\n",gd->filename.data());
-    QStringList::Iterator it;
+    TagStringList::Iterator it;
     for ( it = gd->namespaceList.begin(); 
         it != gd->namespaceList.end(); ++it ) 
     {
-      msg( "  namespace: %s \n", (*it).latin1() );
+      msg( "  namespace: %s \n", (*it).data() );
     }
     for ( it = gd->classList.begin(); 
         it != gd->classList.end(); ++it ) 
     {
-      msg( "  class: %s \n", (*it).latin1() );
+      msg( "  class: %s \n", (*it).data() );
     }
     for ( it = gd->fileList.begin(); 
         it != gd->fileList.end(); ++it ) 
     {
-      msg( "  file: %s \n", (*it).latin1() );
+      msg( "  file: %s \n", (*it).data() );
     }
     for ( it = gd->subgroupList.begin(); 
         it != gd->subgroupList.end(); ++it ) 
     {
-      msg( "  subgroup: %s \n", (*it).latin1() );
+      msg( "  subgroup: %s \n", (*it).data() );
     }
     for ( it = gd->pageList.begin(); 
         it != gd->pageList.end(); ++it ) 
     {
-      msg( "  page: %s \n", (*it).latin1() );
+      msg( "  page: %s \n", (*it).data() );
     }
 
     QListIterator<TagMemberInfo> mci(gd->members);
@@ -1096,16 +1118,16 @@ void TagFileParser::dump()
   {
     msg("dir `%s'\n",dd->name.data());
     msg("  path `%s'\n",dd->path.data());
-    QStringList::Iterator it;
+    TagStringList::Iterator it;
     for ( it = dd->fileList.begin(); 
         it != dd->fileList.end(); ++it ) 
     {
-      msg( "  file: %s \n", (*it).latin1() );
+      msg( "  file: %s \n", (*it).data() );
     }
     for ( it = dd->subdirList.begin(); 
         it != dd->subdirList.end(); ++it ) 
     {
-      msg( "  subdir: %s \n", (*it).latin1() );
+      msg( "  subdir: %s \n", (*it).data() );
     }
   }
 }
@@ -1495,19 +1517,507 @@ void TagFileParser::addIncludes()
   }
 }
 
+//---------------------------------------------------------------------------
+// Compiled tag files
+//
+// A compiled tag file holds the structures built by the XML parser in the
+// binary format of marshal.h, so loading it only needs to copy strings out
+// of a memory mapping. Layout:
+//
+//   header:   magic, version, path, size and modification time of the tag
+//             file, number of classes, files, namespaces, packages,
+//             groups, pages and dirs
+//   body:     the compounds of each kind, in the order of the header
+//   trailer:  magic
+
+#define TAGCACHE_MAGIC   0x44585443 // "DXTC"
+#define TAGCACHE_VERSION 1
+
+static void marshalTagStringList(StorageIntf *s,const TagStringList &l)
+{
+  marshalUInt(s,l.count());
+  TagStringList::ConstIterator it;
+  for (it=l.begin();it!=l.end();++it)
+  {
+    marshalQCString(s,*it);
+  }
+}
+
+static void unmarshalTagStringList(StorageIntf *s,TagStringList &l)
+{
+  uint i,count=unmarshalUInt(s);
+  for (i=0;i<count;i++)
+  {
+    l.append(unmarshalQCString(s));
+  }
+}
+
+static void marshalTagAnchors(StorageIntf *s,const TagAnchorInfoList &l)
+{
+  marshalUInt(s,l.count());
+  QListIterator<TagAnchorInfo> tli(l);
+  TagAnchorInfo *ta;
+  for (;(ta=tli.current());++tli)
+  {
+    marshalQCString(s,ta->label);
+    marshalQCString(s,ta->fileName);
+    marshalQCString(s,ta->title);
+  }
+}
+
+static void unmarshalTagAnchors(StorageIntf *s,TagAnchorInfoList &l)
+{
+  uint i,count=unmarshalUInt(s);
+  for (i=0;i<count;i++)
+  {
+    QCString label    = unmarshalQCString(s);
+    QCString fileName = unmarshalQCString(s);
+    QCString title    = unmarshalQCString(s);
+    l.append(new TagAnchorInfo(fileName,label,title));
+  }
+}
+
+static void marshalTagMembers(StorageIntf *s,const QList<TagMemberInfo> &l)
+{
+  marshalUInt(s,l.count());
+  QListIterator<TagMemberInfo> mii(l);
+  TagMemberInfo *tmi;
+  for (;(tmi=mii.current());++mii)
+  {
+    marshalQCString(s,tmi->type);
+    marshalQCString(s,tmi->name);
+    marshalQCString(s,tmi->anchorFile);
+    marshalQCString(s,tmi->anchor);
+    marshalQCString(s,tmi->arglist);
+    marshalQCString(s,tmi->kind);
+    marshalQCString(s,tmi->clangId);
+    marshalTagAnchors(s,tmi->docAnchors);
+    marshalInt(s,(int)tmi->prot);
+    marshalInt(s,(int)tmi->virt);
+    marshalBool(s,tmi->isStatic);
+    marshalUInt(s,tmi->enumValues.count());
+    QListIterator<TagEnumValueInfo> evii(tmi->enumValues);
+    TagEnumValueInfo *evi;
+    for (;(evi=evii.current());++evii)
+    {
+      marshalQCString(s,evi->name);
+      marshalQCString(s,evi->file);
+      marshalQCString(s,evi->anchor);
+      marshalQCString(s,evi->clangid);
+    }
+  }
+}
+
+static void unmarshalTagMembers(StorageIntf *s,QList<TagMemberInfo> &l)
+{
+  uint i,count=unmarshalUInt(s);
+  for (i=0;i<count;i++)
+  {
+    TagMemberInfo *tmi = new TagMemberInfo;
+    tmi->type       = unmarshalQCString(s);
+    tmi->name       = unmarshalQCString(s);
+    tmi->anchorFile = unmarshalQCString(s);
+    tmi->anchor     = unmarshalQCString(s);
+    tmi->arglist    = unmarshalQCString(s);
+    tmi->kind       = unmarshalQCString(s);
+    tmi->clangId    = unmarshalQCString(s);
+    unmarshalTagAnchors(s,tmi->docAnchors);
+    tmi->prot       = (Protection)unmarshalInt(s);
+    tmi->virt       = (Specifier)unmarshalInt(s);
+    tmi->isStatic   = unmarshalBool(s);
+    uint j,numValues=unmarshalUInt(s);
+    for (j=0;j<numValues;j++)
+    {
+      TagEnumValueInfo *evi = new TagEnumValueInfo;
+      evi->name    = unmarshalQCString(s);
+      evi->file    = unmarshalQCString(s);
+      evi->anchor  = unmarshalQCString(s);
+      evi->clangid = unmarshalQCString(s);
+      tmi->enumValues.append(evi);
+    }
+    l.append(tmi);
+  }
+}
+
+/*! Writes the structures read from the tag file identified by
+ *  \a stamp to \a s, in the format read by readCache().
+ */
+void TagFileParser::writeCache(StorageIntf *s,const TagFileStamp &stamp)
+{
+  marshalUInt(s,TAGCACHE_MAGIC);
+  marshalUInt(s,TAGCACHE_VERSION);
+  marshalQCString(s,stamp.path);
+  marshalUInt64(s,stamp.size);
+  marshalUInt64(s,stamp.mtime);
+  marshalUInt(s,m_tagFileClasses.count());
+  marshalUInt(s,m_tagFileFiles.count());
+  marshalUInt(s,m_tagFileNamespaces.count());
+  marshalUInt(s,m_tagFilePackages.count());
+  marshalUInt(s,m_tagFileGroups.count());
+  marshalUInt(s,m_tagFilePages.count());
+  marshalUInt(s,m_tagFileDirs.count());
+
+  QListIterator<TagClassInfo> cli(m_tagFileClasses);
+  TagClassInfo *tci;
+  for (;(tci=cli.current());++cli)
+  {
+    marshalQCString(s,tci->name);
+    marshalQCString(s,tci->filename);
+    marshalQCString(s,tci->clangId);
+    marshalTagAnchors(s,tci->docAnchors);
+    marshalBaseInfoList(s,tci->bases);
+    marshalTagMembers(s,tci->members);
+    if (tci->templateArguments)
+    {
+      marshalUInt(s,tci->templateArguments->count());
+      QListIterator<QCString> sli(*tci->templateArguments);
+      QCString *argName;
+      for (;(argName=sli.current());++sli)
+      {
+        marshalQCString(s,*argName);
+      }
+    }
+    else
+    {
+      marshalUInt(s,NULL_LIST);
+    }
+    marshalTagStringList(s,tci->classList);
+    marshalInt(s,(int)tci->kind);
+    marshalBool(s,tci->isObjC);
+  }
+
+  QListIterator<TagFileInfo> fli(m_tagFileFiles);
+  TagFileInfo *tfi;
+  for (;(tfi=fli.current());++fli)
+  {
+    marshalQCString(s,tfi->name);
+    marshalQCString(s,tfi->path);
+    marshalQCString(s,tfi->filename);
+    marshalTagAnchors(s,tfi->docAnchors);
+    marshalTagMembers(s,tfi->members);
+    marshalTagStringList(s,tfi->classList);
+    marshalTagStringList(s,tfi->namespaceList);
+    marshalUInt(s,tfi->includes.count());
+    QListIterator<TagIncludeInfo> ili(tfi->includes);
+    TagIncludeInfo *ii;
+    for (;(ii=ili.current());++ili)
+    {
+      marshalQCString(s,ii->id);
+      marshalQCString(s,ii->name);
+      marshalQCString(s,ii->text);
+      marshalBool(s,ii->isLocal);
+      marshalBool(s,ii->isImported);
+    }
+  }
+
+  QListIterator<TagNamespaceInfo> nli(m_tagFileNamespaces);
+  TagNamespaceInfo *tni;
+  for (;(tni=nli.current());++nli)
+  {
+    marshalQCString(s,tni->name);
+    marshalQCString(s,tni->filename);
+    marshalQCString(s,tni->clangId);
+    marshalTagStringList(s,tni->classList);
+    marshalTagStringList(s,tni->namespaceList);
+    marshalTagAnchors(s,tni->docAnchors);
+    marshalTagMembers(s,tni->members);
+  }
+
+  QListIterator<TagPackageInfo> pkli(m_tagFilePackages);
+  TagPackageInfo *tpgi;
+  for (;(tpgi=pkli.current());++pkli)
+  {
+    marshalQCString(s,tpgi->name);
+    marshalQCString(s,tpgi->filename);
+    marshalTagAnchors(s,tpgi->docAnchors);
+    marshalTagMembers(s,tpgi->members);
+    marshalTagStringList(s,tpgi->classList);
+  }
+
+  QListIterator<TagGroupInfo> gli(m_tagFileGroups);
+  TagGroupInfo *tgi;
+  for (;(tgi=gli.current());++gli)
+  {
+    marshalQCString(s,tgi->name);
+    marshalQCString(s,tgi->title);
+    marshalQCString(s,tgi->filename);
+    marshalTagAnchors(s,tgi->docAnchors);
+    marshalTagMembers(s,tgi->members);
+    marshalTagStringList(s,tgi->subgroupList);
+    marshalTagStringList(s,tgi->classList);
+    marshalTagStringList(s,tgi->namespaceList);
+    marshalTagStringList(s,tgi->fileList);
+    marshalTagStringList(s,tgi->pageList);
+    marshalTagStringList(s,tgi->dirList);
+  }
+
+  QListIterator<TagPageInfo> pli(m_tagFilePages);
+  TagPageInfo *tpi;
+  for (;(tpi=pli.current());++pli)
+  {
+    marshalQCString(s,tpi->name);
+    marshalQCString(s,tpi->title);
+    marshalQCString(s,tpi->filename);
+    marshalTagAnchors(s,tpi->docAnchors);
+  }
+
+  QListIterator<TagDirInfo> dli(m_tagFileDirs);
+  TagDirInfo *tdi;
+  for (;(tdi=dli.current());++dli)
+  {
+    marshalQCString(s,tdi->name);
+    marshalQCString(s,tdi->filename);
+    marshalQCString(s,tdi->path);
+    marshalTagStringList(s,tdi->subdirList);
+    marshalTagStringList(s,tdi->fileList);
+    marshalTagAnchors(s,tdi->docAnchors);
+  }
+  marshalUInt(s,TAGCACHE_MAGIC);
+}
+
+/*! Reads the structures written by writeCache() from \a s. Returns FALSE
+ *  if \a s was not made from the tag file identified by \a stamp
+ *  or by this version of doxygen.
+ */
+bool TagFileParser::readCache(StorageIntf *s,const TagFileStamp &stamp)
+{
+  if (unmarshalUInt(s)!=TAGCACHE_MAGIC ||
+      unmarshalUInt(s)!=TAGCACHE_VERSION ||
+      unmarshalQCString(s)!=stamp.path ||
+      unmarshalUInt64(s)!=stamp.size ||
+      unmarshalUInt64(s)!=stamp.mtime)
+  {
+    return FALSE;
+  }
+  uint numClasses    = unmarshalUInt(s);
+  uint numFiles      = unmarshalUInt(s);
+  uint numNamespaces = unmarshalUInt(s);
+  uint numPackages   = unmarshalUInt(s);
+  uint numGroups     = unmarshalUInt(s);
+  uint numPages      = unmarshalUInt(s);
+  uint numDirs       = unmarshalUInt(s);
+  uint i,j,count;
+
+  for (i=0;i<numClasses;i++)
+  {
+    TagClassInfo *tci = new TagClassInfo;
+    tci->name     = unmarshalQCString(s);
+    tci->filename = unmarshalQCString(s);
+    tci->clangId  = unmarshalQCString(s);
+    unmarshalTagAnchors(s,tci->docAnchors);
+    tci->bases    = unmarshalBaseInfoList(s);
+    unmarshalTagMembers(s,tci->members);
+    count = unmarshalUInt(s);
+    if (count!=NULL_LIST)
+    {
+      tci->templateArguments = new QList<QCString>;
+      tci->templateArguments->setAutoDelete(TRUE);
+      for (j=0;j<count;j++)
+      {
+        tci->templateArguments->append(new QCString(unmarshalQCString(s)));
+      }
+    }
+    unmarshalTagStringList(s,tci->classList);
+    tci->kind     = (TagClassInfo::Kind)unmarshalInt(s);
+    tci->isObjC   = unmarshalBool(s);
+    m_tagFileClasses.append(tci);
+  }
+
+  for (i=0;i<numFiles;i++)
+  {
+    TagFileInfo *tfi = new TagFileInfo;
+    tfi->name     = unmarshalQCString(s);
+    tfi->path     = unmarshalQCString(s);
+    tfi->filename = unmarshalQCString(s);
+    unmarshalTagAnchors(s,tfi->docAnchors);
+    unmarshalTagMembers(s,tfi->members);
+    unmarshalTagStringList(s,tfi->classList);
+    unmarshalTagStringList(s,tfi->namespaceList);
+    count = unmarshalUInt(s);
+    for (j=0;j<count;j++)
+    {
+      TagIncludeInfo *ii = new TagIncludeInfo;
+      ii->id         = unmarshalQCString(s);
+      ii->name       = unmarshalQCString(s);
+      ii->text       = unmarshalQCString(s);
+      ii->isLocal    = unmarshalBool(s);
+      ii->isImported = unmarshalBool(s);
+      tfi->includes.append(ii);
+    }
+    m_tagFileFiles.append(tfi);
+  }
+
+  for (i=0;i<numNamespaces;i++)
+  {
+    TagNamespaceInfo *tni = new TagNamespaceInfo;
+    tni->name     = unmarshalQCString(s);
+    tni->filename = unmarshalQCString(s);
+    tni->clangId  = unmarshalQCString(s);
+    unmarshalTagStringList(s,tni->classList);
+    unmarshalTagStringList(s,tni->namespaceList);
+    unmarshalTagAnchors(s,tni->docAnchors);
+    unmarshalTagMembers(s,tni->members);
+    m_tagFileNamespaces.append(tni);
+  }
+
+  for (i=0;i<numPackages;i++)
+  {
+    TagPackageInfo *tpgi = new TagPackageInfo;
+    tpgi->name     = unmarshalQCString(s);
+    tpgi->filename = unmarshalQCString(s);
+    unmarshalTagAnchors(s,tpgi->docAnchors);
+    unmarshalTagMembers(s,tpgi->members);
+    unmarshalTagStringList(s,tpgi->classList);
+    m_tagFilePackages.append(tpgi);
+  }
+
+  for (i=0;i<numGroups;i++)
+  {
+    TagGroupInfo *tgi = new TagGroupInfo;
+    tgi->name     = unmarshalQCString(s);
+    tgi->title    = unmarshalQCString(s);
+    tgi->filename = unmarshalQCString(s);
+    unmarshalTagAnchors(s,tgi->docAnchors);
+    unmarshalTagMembers(s,tgi->members);
+    unmarshalTagStringList(s,tgi->subgroupList);
+    unmarshalTagStringList(s,tgi->classList);
+    unmarshalTagStringList(s,tgi->namespaceList);
+    unmarshalTagStringList(s,tgi->fileList);
+    unmarshalTagStringList(s,tgi->pageList);
+    unmarshalTagStringList(s,tgi->dirList);
+    m_tagFileGroups.append(tgi);
+  }
+
+  for (i=0;i<numPages;i++)
+  {
+    TagPageInfo *tpi = new TagPageInfo;
+    tpi->name     = unmarshalQCString(s);
+    tpi->title    = unmarshalQCString(s);
+    tpi->filename = unmarshalQCString(s);
+    unmarshalTagAnchors(s,tpi->docAnchors);
+    m_tagFilePages.append(tpi);
+  }
+
+  for (i=0;i<numDirs;i++)
+  {
+    TagDirInfo *tdi = new TagDirInfo;
+    tdi->name     = unmarshalQCString(s);
+    tdi->filename = unmarshalQCString(s);
+    tdi->path     = unmarshalQCString(s);
+    unmarshalTagStringList(s,tdi->subdirList);
+    unmarshalTagStringList(s,tdi->fileList);
+    unmarshalTagAnchors(s,tdi->docAnchors);
+    m_tagFileDirs.append(tdi);
+  }
+  if (unmarshalUInt(s)!=TAGCACHE_MAGIC) // out of sync, discard what was read
+  {
+    m_tagFileClasses.clear();
+    m_tagFileFiles.clear();
+    m_tagFileNamespaces.clear();
+    m_tagFilePackages.clear();
+    m_tagFileGroups.clear();
+    m_tagFilePages.clear();
+    m_tagFileDirs.clear();
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/*! Returns the size and modification time of the tag file \a fullName
+ *  in \a stamp. Returns FALSE if the file cannot be found.
+ */
+static bool getTagFileStamp(const char *fullName,TagFileStamp &stamp)
+{
+  struct stat st;
+  if (stat(fullName,&st)!=0) return FALSE;
+  stamp.path  = fullName;
+  stamp.size  = (uint64)st.st_size;
+  stamp.mtime = (uint64)st.st_mtime;
+  return TRUE;
+}
+
+/*! Returns the name of the compiled version of tag file \a fullName
+ *  in directory \a cacheDir. The name is based on the md5 of the path,
+ *  so each tag file has a single compiled version, which is replaced
+ *  when the tag file changes.
+ */
+static QCString tagCacheFileName(const char *fullName,const QCString &cacheDir)
+{
+  uchar md5_sig[16];
+  QCString sigStr(33);
+  MD5Buffer((const unsigned char *)fullName,qstrlen(fullName),md5_sig);
+  MD5SigToString(md5_sig,sigStr.data(),33);
+  return cacheDir+"/"+sigStr+".tagc";
+}
+
+/*! Loads the compiled tag file \a cacheName into \a handler. Returns
+ *  FALSE if it does not exist or was made from a different tag file.
+ */
+static bool readTagCache(TagFileParser &handler,const QCString &cacheName,
+                         const TagFileStamp &stamp)
+{
+  QFileInfo fi(cacheName);
+  // check the trailer first, so a damaged file is never read beyond its end
+  if (!fi.exists() || fi.size()<8) return FALSE;
+  FileStorage f(cacheName);
+  if (!f.open(IO_ReadOnly) || !f.seek(fi.size()-4) ||
+      unmarshalUInt(&f)!=TAGCACHE_MAGIC || !f.seek(0))
+  {
+    return FALSE;
+  }
+  return handler.readCache(&f,stamp);
+}
+
+/*! Stores the structures of \a handler as the compiled tag file
+ *  \a cacheName. The file is written under a temporary name first,
+ *  so concurrent runs never see a partial result.
+ */
+static void writeTagCache(TagFileParser &handler,const QCString &cacheName,
+                          const TagFileStamp &stamp)
+{
+  QCString tmpName;
+  tmpName.sprintf("%s.%d",cacheName.data(),portable_pid());
+  FileStorage f(tmpName);
+  if (f.open(IO_WriteOnly))
+  {
+    handler.writeCache(&f,stamp);
+    f.close();
+    QDir dir;
+    if (!dir.rename(tmpName,cacheName))
+    {
+      dir.remove(tmpName);
+    }
+  }
+}
+
 void parseTagFile(Entry *root,const char *fullName)
 {
   QFileInfo fi(fullName);
   if (!fi.exists()) return;
   TagFileParser handler( fullName ); // tagName
   handler.setFileName(fullName);
-  TagFileErrorHandler errorHandler;
-  QFile xmlFile( fullName );
-  QXmlInputSource source( xmlFile );
+  QCString cacheDir = Config_getString("TAGFILE_CACHE_DIR");
+  TagFileStamp stamp;
+  QCString cacheName;
+  if (!cacheDir.isEmpty() && getTagFileStamp(fullName,stamp))
+  {
+    cacheName = tagCacheFileName(fullName,cacheDir);
+  }
+  // the reader owns the locator that the handler uses in its warnings,
+  // so it must live until the lists have been built
   QXmlSimpleReader reader;
-  reader.setContentHandler( &handler );
-  reader.setErrorHandler( &errorHandler );
-  reader.parse( source );
+  TagFileErrorHandler errorHandler;
+  if (cacheName.isEmpty() || !readTagCache(handler,cacheName,stamp))
+  {
+    QFile xmlFile( fullName );
+    QXmlInputSource source( xmlFile );
+    reader.setContentHandler( &handler );
+    reader.setErrorHandler( &errorHandler );
+    if (reader.parse( source ) && !cacheName.isEmpty())
+    {
+      writeTagCache(handler,cacheName,stamp);
+    }
+  }
   handler.buildLists(root);
   handler.addIncludes();
   //handler.dump();
@@ -93,112 +93,80 @@ static QCString replace(const char *s,char csrc,char cdst)
 
 //- TemplateVariant implementation -------------------------------------------
 
-/** @brief Private data of a template variant object */
-class TemplateVariant::Private
+TemplateVariant::TemplateVariant() : m_type(None), m_raw(FALSE)
 {
-  public:
-    Private() : raw(FALSE) {}
-    Type                type;
-    int                 intVal;
-    QCString            strVal;
-    bool                boolVal;
-    const TemplateStructIntf *strukt;
-    const TemplateListIntf   *list;
-    Delegate            delegate;
-    bool                raw;
-};
-
-TemplateVariant::TemplateVariant()
-{
-  p = new Private;
-  p->type=None;
 }
 
-TemplateVariant::TemplateVariant(bool b)
+TemplateVariant::TemplateVariant(bool b) : m_type(Bool), m_raw(FALSE)
 {
-  p = new Private;
-  p->type = Bool;
-  p->boolVal = b;
+  m_boolVal = b;
 }
 
-TemplateVariant::TemplateVariant(int v)
+TemplateVariant::TemplateVariant(int v) : m_type(Integer), m_raw(FALSE)
 {
-  p = new Private;
-  p->type = Integer;
-  p->intVal = v;
+  m_intVal = v;
 }
 
 TemplateVariant::TemplateVariant(const char *s,bool raw)
+  : m_type(String), m_strVal(s), m_raw(raw)
 {
-  p = new Private;
-  p->type = String;
-  p->strVal = s;
-  p->raw = raw;
 }
 
 TemplateVariant::TemplateVariant(const QCString &s,bool raw)
+  : m_type(String), m_strVal(s), m_raw(raw)
 {
-  p = new Private;
-  p->type = String;
-  p->strVal = s;
-  p->raw = raw;
 }
 
 TemplateVariant::TemplateVariant(const TemplateStructIntf *s)
+  : m_type(Struct), m_raw(FALSE)
 {
-  p = new Private;
-  p->type = Struct;
-  p->strukt = s; }
+  m_strukt = s;
+}
 
 TemplateVariant::TemplateVariant(const TemplateListIntf *l)
+  : m_type(List), m_raw(FALSE)
 {
-  p = new Private;
-  p->type = List;
-  p->list = l;
+  m_list = l;
 }
 
 TemplateVariant::TemplateVariant(const TemplateVariant::Delegate &delegate)
+  : m_type(Function), m_delegate(delegate), m_raw(FALSE)
 {
-  p = new Private;
-  p->type = Function;
-  p->delegate = delegate;
 }
 
 TemplateVariant::~TemplateVariant()
 {
-  delete p;
 }
 
 TemplateVariant::TemplateVariant(const TemplateVariant &v)
 {
-  p = new Private;
-  p->type    = v.p->type;
-  p->raw     = v.p->raw;
-  switch (p->type)
+  m_type    = v.m_type;
+  m_raw     = v.m_raw;
+  switch (m_type)
   {
     case None: break;
-    case Bool:     p->boolVal = v.p->boolVal; break;
-    case Integer:  p->intVal  = v.p->intVal;  break;
-    case String:   p->strVal  = v.p->strVal;  break;
-    case Struct:   p->strukt  = v.p->strukt;  break;
-    case List:     p->list    = v.p->list;    break;
-    case Function: p->delegate= v.p->delegate;break;
+    case Bool:     m_boolVal = v.m_boolVal; break;
+    case Integer:  m_intVal  = v.m_intVal;  break;
+    case String:   m_strVal  = v.m_strVal;  break;
+    case Struct:   m_strukt  = v.m_strukt;  break;
+    case List:     m_list    = v.m_list;    break;
+    case Function: m_delegate= v.m_delegate;break;
   }
 }
 
 TemplateVariant &TemplateVariant::operator=(const TemplateVariant &v)
 {
-  p->type    = v.p->type;
-  p->raw     = v.p->raw;
-  switch (p->type)
+  m_type    = v.m_type;
+  m_raw     = v.m_raw;
+  switch (m_type)
   {
     case None: break;
-    case Bool:     p->boolVal = v.p->boolVal; break;
-    case Integer:  p->intVal  = v.p->intVal;  break;
-    case String:   p->strVal  = v.p->strVal;  break;
-    case Struct:   p->strukt  = v.p->strukt;  break;
-    case List:     p->list    = v.p->list;    break;
-    case Function: p->delegate= v.p->delegate;break;
+    case Bool:     m_boolVal = v.m_boolVal; break;
+    case Integer:  m_intVal  = v.m_intVal;  break;
+    case String:   m_strVal  = v.m_strVal;  break;
+    case Struct:   m_strukt  = v.m_strukt;  break;
+    case List:     m_list    = v.m_list;    break;
+    case Function: m_delegate= v.m_delegate;break;
   }
   return *this;
 }
@@ -206,18 +174,18 @@ TemplateVariant &TemplateVariant::operator=(const TemplateVariant &v)
 QCString TemplateVariant::toString() const
 {
   QCString result;
-  switch (p->type)
+  switch (m_type)
   {
     case None:
       break;
     case Bool:
-      result=p->boolVal ? "true" : "false";
+      result=m_boolVal ? "true" : "false";
       break;
     case Integer:
-      result=QCString().setNum(p->intVal);
+      result=QCString().setNum(m_intVal);
       break;
     case String:
-      result=p->strVal;
+      result=m_strVal;
       break;
     case Struct:
       result="[struct]";
@@ -235,24 +203,24 @@ QCString TemplateVariant::toString() const
 bool TemplateVariant::toBool() const
 {
   bool result=FALSE;
-  switch (p->type)
+  switch (m_type)
   {
     case None:
       break;
     case Bool:
-      result = p->boolVal;
+      result = m_boolVal;
       break;
     case Integer:
-      result = p->intVal!=0;
+      result = m_intVal!=0;
       break;
     case String:
-      result = !p->strVal.isEmpty(); // && p->strVal!="false" && p->strVal!="0";
+      result = !m_strVal.isEmpty(); // && m_strVal!="false" && m_strVal!="0";
       break;
     case Struct:
       result = TRUE;
       break;
     case List:
-      result = p->list->count()!=0;
+      result = m_list->count()!=0;
       break;
     case Function:
       result = FALSE;
@@ -264,23 +232,23 @@ bool TemplateVariant::toBool() const
 int TemplateVariant::toInt() const
 {
   int result=0;
-  switch (p->type)
+  switch (m_type)
   {
     case None:
       break;
     case Bool:
-      result = p->boolVal ? 1 : 0;
+      result = m_boolVal ? 1 : 0;
       break;
     case Integer:
-      result = p->intVal;
+      result = m_intVal;
       break;
     case String:
-      result = p->strVal.toInt();
+      result = m_strVal.toInt();
       break;
     case Struct:
       break;
     case List:
-      result = p->list->count();
+      result = m_list->count();
       break;
     case Function:
       result = 0;
@@ -291,33 +259,33 @@ int TemplateVariant::toInt() const
 
 const TemplateStructIntf *TemplateVariant::toStruct() const
 {
-  return p->type==Struct ? p->strukt : 0;
+  return m_type==Struct ? m_strukt : 0;
 }
 
 const TemplateListIntf *TemplateVariant::toList() const
 {
-  return p->type==List ? p->list : 0;
+  return m_type==List ? m_list : 0;
 }
 
 TemplateVariant TemplateVariant::call(const QValueList<TemplateVariant> &args)
 {
-  if (p->type==Function) return p->delegate(args);
+  if (m_type==Function) return m_delegate(args);
   return TemplateVariant();
 }
 
 bool TemplateVariant::operator==(TemplateVariant &other)
 {
-  if (p->type==None)
+  if (m_type==None)
   {
     return FALSE;
   }
-  if (p->type==TemplateVariant::List && other.p->type==TemplateVariant::List)
+  if (m_type==TemplateVariant::List && other.m_type==TemplateVariant::List)
   {
-    return p->list==other.p->list; // TODO: improve me
+    return m_list==other.m_list; // TODO: improve me
   }
-  else if (p->type==TemplateVariant::Struct && other.p->type==TemplateVariant::Struct)
+  else if (m_type==TemplateVariant::Struct && other.m_type==TemplateVariant::Struct)
   {
-    return p->strukt==other.p->strukt; // TODO: improve me
+    return m_strukt==other.m_strukt; // TODO: improve me
   }
   else
   {
@@ -327,22 +295,22 @@ bool TemplateVariant::operator==(TemplateVariant &other)
 
 TemplateVariant::Type TemplateVariant::type() const
 {
-  return p->type;
+  return m_type;
 }
 
 bool TemplateVariant::isValid() const
 {
-  return p->type!=None;
+  return m_type!=None;
 }
 
 void TemplateVariant::setRaw(bool b)
 {
-  p->raw = b;
+  m_raw = b;
 }
 
 bool TemplateVariant::raw() const
 {
-  return p->raw;
+  return m_raw;
 }
 
 //- Template struct implementation --------------------------------------------
@@ -576,10 +544,13 @@ class TemplateContextImpl : public TemplateContext
     { m_escapeIntf = intf; }
     void setSpacelessIntf(TemplateSpacelessIntf *intf)
     { m_spacelessIntf = intf; }
+    void setCreateIntf(TemplateCreateIntf *intf)
+    { m_createIntf = intf; }
 
     // internal methods
     TemplateBlockContext *blockContext();
     TemplateVariant getPrimary(const QCString &name) const;
+    TemplateVariant getPath(const QValueList<QCString> &path) const;
     void setLocation(const QCString &templateName,int line)
     { m_templateName=templateName; m_line=line; }
     QCString templateName() const { return m_templateName; }
@@ -587,6 +558,7 @@ class TemplateContextImpl : public TemplateContext
     QCString outputDirectory() const { return m_outputDir; }
     TemplateEscapeIntf *escapeIntf() const { return m_escapeIntf; }
     TemplateSpacelessIntf *spacelessIntf() const { return m_spacelessIntf; }
+    TemplateCreateIntf *createIntf() const { return m_createIntf; }
     void enableSpaceless(bool b) { m_spacelessEnabled=b; }
     bool spacelessEnabled() const { return m_spacelessEnabled && m_spacelessIntf; }
 
@@ -598,6 +570,7 @@ class TemplateContextImpl : public TemplateContext
     TemplateBlockContext m_blockContext;
     TemplateEscapeIntf *m_escapeIntf;
     TemplateSpacelessIntf *m_spacelessIntf;
+    TemplateCreateIntf *m_createIntf;
     bool m_spacelessEnabled;
 };
 
@@ -865,13 +838,13 @@ class ExprAstNumber : public ExprAst
 class ExprAstVariable : public ExprAst
 {
   public:
-    ExprAstVariable(const char *name) : m_name(name)
+    ExprAstVariable(const char *name) : m_name(name), m_path(split(name,".",FALSE,FALSE))
     { TRACE(("ExprAstVariable(%s)\n",name)); }
     const QCString &name() const { return m_name; }
     virtual TemplateVariant resolve(TemplateContext *c)
     {
       TemplateContextImpl *ci = dynamic_cast<TemplateContextImpl*>(c);
-      TemplateVariant v = c->get(m_name);
+      TemplateVariant v = ci->getPath(m_path);
       if (!v.isValid())
       {
         warn(ci->templateName(),ci->line(),"undefined variable '%s' in expression",m_name.data());
@@ -880,6 +853,7 @@ class ExprAstVariable : public ExprAst
     }
   private:
     QCString m_name;
+    QValueList<QCString> m_path; // m_name split at the dots
 };
 
 class ExprAstFunctionVariable : public ExprAst
@@ -1576,7 +1550,7 @@ class TemplateImpl : public TemplateNode, public Template
 
 TemplateContextImpl::TemplateContextImpl()
   : m_templateName("<unknown>"), m_line(1), m_escapeIntf(0),
-    m_spacelessIntf(0), m_spacelessEnabled(FALSE)
+    m_spacelessIntf(0), m_createIntf(0), m_spacelessEnabled(FALSE)
 {
   m_contextStack.setAutoDelete(TRUE);
   push();
@@ -1590,80 +1564,68 @@ TemplateContextImpl::~TemplateContextImpl()
 void TemplateContextImpl::set(const char *name,const TemplateVariant &v)
 {
   TemplateVariant *pv = m_contextStack.first()->find(name);
-  if (pv)
+  if (pv) // change existing variable
+  {
+    *pv = v;
+  }
+  else // insert new variable
   {
-    m_contextStack.first()->remove(name);
+    m_contextStack.first()->insert(name,new TemplateVariant(v));
   }
-  m_contextStack.first()->insert(name,new TemplateVariant(v));
 }
 
 TemplateVariant TemplateContextImpl::get(const QCString &name) const
 {
-  int i=name.find('.');
-  if (i==-1) // simple name
+  if (name.find('.')==-1) // simple name
   {
     return getPrimary(name);
   }
   else // obj.prop
   {
-    TemplateVariant v;
-    QCString objName = name.left(i);
-    v = getPrimary(objName);
-    QCString propName = name.mid(i+1);
-    while (!propName.isEmpty())
+    return getPath(split(name,".",FALSE,FALSE));
+  }
+}
+
+TemplateVariant TemplateContextImpl::getPath(const QValueList<QCString> &path) const
+{
+  QValueList<QCString>::ConstIterator it = path.begin();
+  if (it==path.end()) return TemplateVariant();
+  QCString objName = *it;
+  TemplateVariant v = getPrimary(objName);
+  for (++it;it!=path.end();++it)
+  {
+    const QCString &propName = *it;
+    //printf("getPrimary(%s) type=%d:%s\n",objName.data(),v.type(),v.toString().data());
+    if (v.type()==TemplateVariant::Struct)
     {
-      //printf("getPrimary(%s) type=%d:%s\n",objName.data(),v.type(),v.toString().data());
-      if (v.type()==TemplateVariant::Struct)
+      v = v.toStruct()->get(propName);
+      if (!v.isValid())
       {
-        i = propName.find(".");
-        int l = i==-1 ? propName.length() : i;
-        v = v.toStruct()->get(propName.left(l));
-        if (!v.isValid())
-        {
-          warn(m_templateName,m_line,"requesting non-existing property '%s' for object '%s'",propName.left(l).data(),objName.data());
-        }
-        if (i!=-1)
-        {
-          objName = propName.left(i);
-          propName = propName.mid(i+1);
-        }
-        else
-        {
-          propName.resize(0);
-        }
+        warn(m_templateName,m_line,"requesting non-existing property '%s' for object '%s'",propName.data(),objName.data());
       }
-      else if (v.type()==TemplateVariant::List)
+      objName = propName;
+    }
+    else if (v.type()==TemplateVariant::List)
+    {
+      bool b;
+      int index = propName.toInt(&b);
+      if (b)
       {
-        i = propName.find(".");
-        int l = i==-1 ? propName.length() : i;
-        bool b;
-        int index = propName.left(l).toInt(&b);
-        if (b)
-        {
-          v = v.toList()->at(index);
-        }
-        else
-        {
-          warn(m_templateName,m_line,"list index '%s' is not valid",propName.data());
-          break;
-        }
-        if (i!=-1)
-        {
-          propName = propName.mid(i+1);
-        }
-        else
-        {
-          propName.resize(0);
-        }
+        v = v.toList()->at(index);
       }
       else
       {
-        warn(m_templateName,m_line,"using . on an object '%s' is not an struct or list",objName.data());
+        warn(m_templateName,m_line,"list index '%s' is not valid",propName.data());
         return TemplateVariant();
       }
-    } while (i!=-1);
-    return v;
+    }
+    else
+    {
+      warn(m_templateName,m_line,"using . on an object '%s' is not an struct or list",objName.data());
+      return TemplateVariant();
+    }
   }
+  return v;
 }
 
 const TemplateVariant *TemplateContextImpl::getRef(const QCString &name) const
@@ -2013,20 +1975,21 @@ class TemplateNodeFor : public TemplateNodeCreator<TemplateNodeFor>
           TemplateVariant v;
           const TemplateVariant *parentLoop = c->getRef("forloop");
           uint index = m_reversed ? listSize-1 : 0;
+          // the loop state is updated in place for each iteration
+          TemplateStruct s;
+          s.set("parentloop",parentLoop ? *parentLoop : TemplateVariant());
+          c->set("forloop",&s);
           TemplateListIntf::ConstIterator *it = list->createIterator();
           for (m_reversed ? it->toLast() : it->toFirst();
               (it->current(v));
               m_reversed ? it->toPrev() : it->toNext())
           {
-            TemplateStruct s;
             s.set("counter0",    (int)index);
             s.set("counter",     (int)(index+1));
             s.set("revcounter",  (int)(listSize-index));
             s.set("revcounter0", (int)(listSize-index-1));
             s.set("first",index==0);
             s.set("last", index==listSize-1);
-            s.set("parentloop",parentLoop ? *parentLoop : TemplateVariant());
-            c->set("forloop",&s);
 
             // add variables for this loop to the context
             //obj->addVariableToContext(index,m_vars,c);
@@ -2391,7 +2354,13 @@ class TemplateNodeCreate : public TemplateNodeCreator<TemplateNodeCreate>
               if (f.open(IO_WriteOnly))
               {
                 FTextStream ts(&f);
+                TemplateCreateIntf *intf = ci->createIntf();
+                if (intf) intf->beginCreate(outputFile);
+                // variables set by the created file stay local to it
+                c->push();
                 createTemplate->render(ts,c);
+                c->pop();
+                if (intf) intf->endCreate(outputFile);
                 //delete createTemplate;
               }
               else
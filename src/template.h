@@ -217,8 +217,17 @@ class TemplateVariant
     bool raw() const;
 
   private:
-    class Private;
-    Private *p;
+    Type                m_type;
+    union
+    {
+      bool                      m_boolVal;
+      int                       m_intVal;
+      const TemplateStructIntf *m_strukt;
+      const TemplateListIntf   *m_list;
+    };
+    QCString            m_strVal;
+    Delegate            m_delegate;
+    bool                m_raw;
 };
 
 //------------------------------------------------------------------------
@@ -350,6 +359,18 @@ class TemplateSpacelessIntf
 
 //------------------------------------------------------------------------
 
+/** @brief Interface used to get notified about the files written by a create block */
+class TemplateCreateIntf
+{
+  public:
+    /** Called before the output file \a fileName is rendered */
+    virtual void beginCreate(const QCString &fileName) = 0;
+    /** Called after the output file \a fileName has been written */
+    virtual void endCreate(const QCString &fileName) = 0;
+};
+
+//------------------------------------------------------------------------
+
 /** @brief Abstract interface for a template context. 
  *  
  *  A Context consists of a stack of dictionaries.
@@ -405,6 +426,11 @@ class TemplateContext
      *  to remove any redundant whitespace.
      */
     virtual void setSpacelessIntf(TemplateSpacelessIntf *intf) = 0;
+
+    /** Sets the interface that will be notified when a create block
+     *  starts and finishes writing a file.
+     */
+    virtual void setCreateIntf(TemplateCreateIntf *intf) = 0;
 };
 
 //------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <math.h>
+#include <sys/stat.h>
 
 #include "md5.h"
 
@@ -27,12 +28,15 @@
 #include <qdir.h>
 #include <qdatetime.h>
 #include <qcache.h>
+#include <qthread.h>
+#include <qvector.h>
 
 #include "util.h"
 #include "message.h"
 #include "classdef.h"
 #include "filedef.h"
 #include "doxygen.h"
+#include "lookupcache.h"
 #include "outputlist.h"
 #include "defargs.h"
 #include "language.h"
@@ -1435,59 +1439,35 @@ static ClassDef *getResolvedClassRec(Definition *scope,
   // Since it is often the case that the same name is searched in the same
   // scope over an over again (especially for the linked source code generation)
   // we use a cache to collect previous results. This is possible since the
-  // result of a lookup is deterministic. As the key we use the concatenated
-  // scope, the name to search for and the explicit scope prefix. The speedup
+  // result of a lookup is deterministic. As the key we use the scope, the
+  // name to search for and the explicit scope prefix. The speedup
   // achieved by this simple cache can be enormous.
-  int scopeNameLen = scope->name().length()+1;
-  int nameLen = name.length()+1;
-  int explicitPartLen = explicitScopePart.length();
-  int fileScopeLen = hasUsingStatements ? 1+fileScope->absFilePath().length() : 0;
-
-  // below is a more efficient coding of
-  // QCString key=scope->name()+"+"+name+"+"+explicitScopePart;
-  QCString key(scopeNameLen+nameLen+explicitPartLen+fileScopeLen+1);
-  char *p=key.data();
-  qstrcpy(p,scope->name()); *(p+scopeNameLen-1)='+';
-  p+=scopeNameLen;
-  qstrcpy(p,name); *(p+nameLen-1)='+';
-  p+=nameLen;
-  qstrcpy(p,explicitScopePart);
-  p+=explicitPartLen;
-
-  // if a file scope is given and it contains using statements we should
-  // also use the file part in the key (as a class name can be in
-  // two different namespaces and a using statement in a file can select 
+  //
+  // If a file scope is given and it contains using statements we should
+  // also use the file in the key (as a class name can be in
+  // two different namespaces and a using statement in a file can select
   // one of them).
-  if (hasUsingStatements)
-  {
-    // below is a more efficient coding of
-    // key+="+"+fileScope->name();
-    *p++='+';
-    qstrcpy(p,fileScope->absFilePath());
-    p+=fileScopeLen-1;
-  }
-  *p='\0';
+  LookupKey key(scope,hasUsingStatements ? fileScope : 0,name,explicitScopePart);
 
-  LookupInfo *pval=Doxygen::lookupCache->find(key);
-  //printf("Searching for %s result=%p\n",key.data(),pval);
-  if (pval)
+  LookupInfo cached;
+  if (Doxygen::lookupCache->find(key,cached))
   {
     //printf("LookupInfo %p %p '%s' %p\n", 
-    //    pval->classDef, pval->typeDef, pval->templSpec.data(), 
-    //    pval->resolvedType.data()); 
-    if (pTemplSpec)    *pTemplSpec=pval->templSpec;
-    if (pTypeDef)      *pTypeDef=pval->typeDef;
-    if (pResolvedType) *pResolvedType=pval->resolvedType;
+    //    cached.classDef, cached.typeDef, cached.templSpec.data(), 
+    //    cached.resolvedType.data()); 
+    if (pTemplSpec)    *pTemplSpec=cached.templSpec;
+    if (pTypeDef)      *pTypeDef=cached.typeDef;
+    if (pResolvedType) *pResolvedType=cached.resolvedType;
     //printf("] cachedMatch=%s\n",
-    //    pval->classDef?pval->classDef->name().data():"<none>");
+    //    cached.classDef?cached.classDef->name().data():"<none>");
     //if (pTemplSpec) 
     //  printf("templSpec=%s\n",pTemplSpec->data());
-    return pval->classDef; 
+    return cached.classDef; 
   }
   else // not found yet; we already add a 0 to avoid the possibility of 
     // endless recursion.
   {
-    Doxygen::lookupCache->insert(key,new LookupInfo);
+    Doxygen::lookupCache->insert(key,LookupInfo());
   }
 
   ClassDef *bestMatch=0;
@@ -1533,18 +1513,7 @@ static ClassDef *getResolvedClassRec(Definition *scope,
   //printf("getResolvedClassRec: bestMatch=%p pval->resolvedType=%s\n",
   //    bestMatch,bestResolvedType.data());
 
-  pval=Doxygen::lookupCache->find(key);
-  if (pval)
-  {
-    pval->classDef     = bestMatch;
-    pval->typeDef      = bestTypedef;
-    pval->templSpec    = bestTemplSpec;
-    pval->resolvedType = bestResolvedType;
-  }
-  else
-  {
-    Doxygen::lookupCache->insert(key,new LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
-  }
+  Doxygen::lookupCache->insert(key,LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
   //printf("] bestMatch=%s distance=%d\n",
   //    bestMatch?bestMatch->name().data():"<none>",minDistance);
   //if (pTemplSpec) 
@@ -2364,7 +2333,7 @@ QCString transcodeCharacterStringToUTF8(const QCString &input)
   {
     size_t iLeft=inputSize;
     size_t oLeft=outputSize;
-    char *inputPtr = input.data();
+    char *inputPtr = (char *)input.data(); // iconv does not modify the input
     char *outputPtr = output.data();
     if (!portable_iconv(cd, &inputPtr, &iLeft, &outputPtr, &oLeft))
     {
@@ -7397,8 +7366,135 @@ static int transcodeCharacterBuffer(const char *fileName,BufStr &srcBuf,int size
   return newSize;
 }
 
+/*! Adds the size and modification time of each file named in the
+ *  filter command \a filterName to the md5 \a ctx, so that editing a
+ *  filter script (e.g. \c myfilter.py in "python myfilter.py") makes the
+ *  cached output of that filter stale.
+ */
+static void addFilterFilesToMd5(struct MD5Context *ctx,const QCString &filterName)
+{
+  int i=0,l=filterName.length();
+  while (i<l)
+  {
+    while (i<l && isspace((uchar)filterName.at(i))) i++;
+    QCString word;
+    if (i<l && filterName.at(i)=='"') // quoted file name
+    {
+      int e=filterName.find('"',i+1);
+      if (e==-1) e=l;
+      word=filterName.mid(i+1,e-i-1);
+      i=e+1;
+    }
+    else
+    {
+      int s=i;
+      while (i<l && !isspace((uchar)filterName.at(i))) i++;
+      word=filterName.mid(s,i-s);
+    }
+    if (word.isEmpty()) continue;
+    // stat() rather than QFileInfo, since this runs on the read-ahead
+    // threads and QDateTime uses the non reentrant localtime()
+    struct stat st;
+    if (stat(word,&st)==0 && (st.st_mode&S_IFMT)==S_IFREG)
+    {
+      uint64 stamp[2];
+      stamp[0] = (uint64)st.st_size;
+      stamp[1] = (uint64)st.st_mtime;
+      MD5Update(ctx,(const unsigned char *)word.data(),word.length()+1);
+      MD5Update(ctx,(const unsigned char *)stamp,sizeof(stamp));
+    }
+  }
+}
+
+/*! Returns the name of the file in \a cacheDir that holds the output of
+ *  running filter \a filterName on file \a fileName. The name is based on
+ *  the md5 of the filter command, the size and time stamp of the files
+ *  named in it, the file name and the file's contents.
+ *  Returns an empty string if the file cannot be read.
+ */
+static QCString filterCacheFileName(const char *fileName,
+                    const QCString &filterName,const QCString &cacheDir)
+{
+  QFile f(fileName);
+  if (!f.open(IO_ReadOnly)) return QCString();
+  QByteArray contents = f.readAll();
+  struct MD5Context ctx;
+  uchar md5_sig[16];
+  QCString sigStr(33);
+  MD5Init(&ctx);
+  MD5Update(&ctx,(const unsigned char *)filterName.data(),filterName.length()+1);
+  addFilterFilesToMd5(&ctx,filterName);
+  MD5Update(&ctx,(const unsigned char *)fileName,qstrlen(fileName)+1);
+  MD5Update(&ctx,(const unsigned char *)contents.data(),contents.size());
+  MD5Final(md5_sig,&ctx);
+  MD5SigToString(md5_sig,sigStr.data(),33);
+  return cacheDir+"/"+sigStr+".flt";
+}
+
+/*! Reads the cached filter output \a cacheName into \a inBuf.
+ *  Returns the number of bytes read or -1 if there is no cached output.
+ */
+static int readCachedFilterOutput(const QCString &cacheName,BufStr &inBuf)
+{
+  QFile f(cacheName);
+  if (!f.open(IO_ReadOnly)) return -1;
+  int size=f.size();
+  inBuf.skip(size);
+  if (f.readBlock(inBuf.data(),size)!=size)
+  {
+    inBuf.shrink(0);
+    return -1;
+  }
+  inBuf.at(inBuf.curPos()) ='\0';
+  return size;
+}
+
+/*! Stores the first \a size bytes of \a inBuf as the cached filter
+ *  output \a cacheName. The file is written under a temporary name
+ *  first, so concurrent runs never see a partial result.
+ */
+static void writeCachedFilterOutput(const QCString &cacheName,const BufStr &inBuf,int size)
+{
+  QCString tmpName;
+  tmpName.sprintf("%s.%d.%p",cacheName.data(),portable_pid(),(const void*)&inBuf);
+  QFile f(tmpName);
+  if (f.open(IO_WriteOnly))
+  {
+    bool ok = f.writeBlock(inBuf.data(),size)==size;
+    f.close();
+    QDir dir;
+    if (!ok || !dir.rename(tmpName,cacheName))
+    {
+      dir.remove(tmpName);
+    }
+  }
+}
+
 //! read a file name \a fileName and optionally filter and transcode it
 bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceCode)
+{
+  QCString filterName;
+  if (filter)
+  {
+    filterName = getFileFilter(fileName,isSourceCode);
+  }
+  return readInputFileWithFilter(fileName,inBuf,filterName,
+                                 Config_getString("INPUT_ENCODING"),
+                                 Config_getString("FILTER_CACHE_DIR"));
+}
+
+/*! read a file name \a fileName, pass it through the filter command
+ *  \a filterName (if not empty) and transcode it from \a inputEncoding
+ *  to UTF-8. If \a filterCacheDir is not empty the output of the filter
+ *  is stored in that directory and reused by later runs for as long as
+ *  the file and the filter command do not change.
+ *  Unlike readInputFile() this function does not consult the
+ *  configuration, so it can be used from a worker thread.
+ */
+bool readInputFileWithFilter(const char *fileName,BufStr &inBuf,
+                             const QCString &filterName,
+                             const QCString &inputEncoding,
+                             const QCString &filterCacheDir)
 {
   // try to open file
   int size=0;
@@ -7407,8 +7503,7 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
 
   QFileInfo fi(fileName);
   if (!fi.exists()) return FALSE;
-  QCString filterName = getFileFilter(fileName,isSourceCode);
-  if (filterName.isEmpty() || !filter)
+  if (filterName.isEmpty())
   {
     QFile f(fileName);
     if (!f.open(IO_ReadOnly))
@@ -7427,24 +7522,42 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
   }
   else
   {
-    QCString cmd=filterName+" \""+fileName+"\"";
-    Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",cmd.data());
-    FILE *f=portable_popen(cmd,"r");
-    if (!f)
+    QCString cacheName;
+    if (!filterCacheDir.isEmpty())
     {
-      err("could not execute filter %s\n",filterName.data());
-      return FALSE;
+      cacheName = filterCacheFileName(fileName,filterName,filterCacheDir);
     }
-    const int bufSize=1024;
-    char buf[bufSize];
-    int numRead;
-    while ((numRead=(int)fread(buf,1,bufSize,f))>0)
+    if (cacheName.isEmpty() || (size=readCachedFilterOutput(cacheName,inBuf))==-1)
     {
-      //printf(">>>>>>>>Reading %d bytes\n",numRead);
-      inBuf.addArray(buf,numRead),size+=numRead;
+      size=0;
+      QCString cmd=filterName+" \""+fileName+"\"";
+      Debug::print(Debug::ExtCmd,0,"Executing popen(`%s`)\n",cmd.data());
+      FILE *f=portable_popen(cmd,"r");
+      if (!f)
+      {
+        err("could not execute filter %s\n",filterName.data());
+        return FALSE;
+      }
+      const int bufSize=1024;
+      char buf[bufSize];
+      int numRead;
+      while ((numRead=(int)fread(buf,1,bufSize,f))>0)
+      {
+        //printf(">>>>>>>>Reading %d bytes\n",numRead);
+        inBuf.addArray(buf,numRead),size+=numRead;
+      }
+      // only cache the output of filters that finished successfully
+      if (portable_pclose(f)==0 && !cacheName.isEmpty())
+      {
+        writeCachedFilterOutput(cacheName,inBuf,size);
+      }
+      inBuf.at(inBuf.curPos()) ='\0';
+    }
+    else
+    {
+      Debug::print(Debug::ExtCmd,0,"Using cached output of `%s` for %s\n",
+                   filterName.data(),fileName);
     }
-    portable_pclose(f);
-    inBuf.at(inBuf.curPos()) ='\0';
     Debug::print(Debug::FilterOutput, 0, "Filter output\n");
     Debug::print(Debug::FilterOutput,0,"-------------\n%s\n-------------\n",inBuf.data());
   }
@@ -7471,7 +7584,7 @@ bool readInputFile(const char *fileName,BufStr &inBuf,bool filter,bool isSourceC
   {
     // do character transcoding if needed.
     transcodeCharacterBuffer(fileName,inBuf,inBuf.curPos(),
-        Config_getString("INPUT_ENCODING"),"UTF-8");
+        inputEncoding,"UTF-8");
   }
 
   //inBuf.addChar('\n'); /* to prevent problems under Windows ? */
@@ -7513,30 +7626,120 @@ bool patternMatch(const QFileInfo &fi,const QStrList *patList)
 {
   bool found=FALSE;
   if (patList)
+  { 
+    FilePatternMatcher matcher(patList);
+    found = matcher.match(fi.fileName().data(),fi.filePath().data(),
+                          fi.absFilePath().data());
+  }
+  return found;
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Private data of a FilePatternMatcher */
+class FilePatternMatcher::Private
+{
+  public:
+    Private()
+    {
+      suffixes.setAutoDelete(TRUE);
+      regExps.setAutoDelete(TRUE);
+    }
+    // Patterns of the form *.ext. Since a wildcard pattern must match the
+    // whole string, these match a path exactly when they match the end of
+    // the file name, so they can be checked without a regular expression.
+    // Vectors are used since, unlike a QList, they can be read by several
+    // threads at the same time.
+    QVector<QCString> suffixes;
+    // all other patterns
+    QVector<QRegExp> regExps;
+};
+
+// returns TRUE if pattern is a '*' followed by plain characters only
+static bool isSuffixPattern(const QCString &pattern)
+{
+  if (pattern.length()<2 || pattern.at(0)!='*') return FALSE;
+  const char *p = pattern.data()+1;
+  char c;
+  while ((c=*p++))
+  {
+    if (!isalnum((uchar)c) && c!='.' && c!='_' && c!='-' && c!='+' && c!='~' && c!='#')
+    {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+FilePatternMatcher::FilePatternMatcher(const QStrList *patList)
+{
+  p = new Private;
+  if (patList)
   { 
     QStrListIterator it(*patList);
     QCString pattern;
     for (it.toFirst();(pattern=it.current());++it)
     {
-      if (!pattern.isEmpty() && !found)
+      if (!pattern.isEmpty())
       {
         int i=pattern.find('=');
         if (i!=-1) pattern=pattern.left(i); // strip of the extension specific filter name
-
+        if (isSuffixPattern(pattern))
+        {
+          uint n = p->suffixes.size();
+          p->suffixes.resize(n+1);
+          p->suffixes.insert(n,new QCString(pattern.mid(1)));
+        }
+        else
+        {
+          uint n = p->regExps.size();
+          p->regExps.resize(n+1);
 #if defined(_WIN32) || defined(__MACOSX__) // Windows or MacOSX
-        QRegExp re(pattern,FALSE,TRUE); // case insensitive match 
+          p->regExps.insert(n,new QRegExp(pattern,FALSE,TRUE)); // case insensitive match 
 #else                // unix
-        QRegExp re(pattern,TRUE,TRUE);  // case sensitive match
+          p->regExps.insert(n,new QRegExp(pattern,TRUE,TRUE));  // case sensitive match
 #endif
-        found = found || re.match(fi.fileName().data())!=-1 || 
-                         re.match(fi.filePath().data())!=-1 ||
-                         re.match(fi.absFilePath().data())!=-1;
-        //printf("Matching `%s' against pattern `%s' found=%d\n",
-        //    fi->fileName().data(),pattern.data(),found);
+        }
       }
     }
   }
-  return found;
+}
+
+FilePatternMatcher::~FilePatternMatcher()
+{
+  delete p;
+}
+
+bool FilePatternMatcher::match(const QCString &fileName,const QCString &filePath,
+                               const QCString &absFilePath) const
+{
+  uint nameLen = fileName.length();
+  uint i;
+  for (i=0;i<p->suffixes.size();i++)
+  {
+    const QCString &suffix = *p->suffixes.at(i);
+    uint suffixLen = suffix.length();
+    if (suffixLen<=nameLen &&
+#if defined(_WIN32) || defined(__MACOSX__) // Windows or MacOSX
+        qstricmp(fileName.data()+nameLen-suffixLen,suffix)==0
+#else
+        qstrcmp(fileName.data()+nameLen-suffixLen,suffix)==0
+#endif
+       )
+    {
+      return TRUE;
+    }
+  }
+  for (i=0;i<p->regExps.size();i++)
+  {
+    const QRegExp *re = p->regExps.at(i);
+    if (re->match(fileName)!=-1 || re->match(filePath)!=-1 ||
+        re->match(absFilePath)!=-1)
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
 }
 
 #if 0 // move to HtmlGenerator::writeSummaryLink
@@ -7678,6 +7881,16 @@ QCString replaceColorMarkers(const char *str)
   return result;
 }
 
+/** Returns the number of threads doxygen may use for processing, based
+ *  on the NUM_PROC_THREADS option.
+ */
+int numProcThreads()
+{
+  int numThreads = QMIN(32,Config_getInt("NUM_PROC_THREADS"));
+  if (numThreads==0) numThreads = QMAX(1,QThread::idealThreadCount());
+  return numThreads;
+}
+
 /** Copies the contents of file with name \a src to the newly created 
  *  file with name \a dest. Returns TRUE if successful.
  */
@@ -405,10 +405,34 @@ void stackTrace();
 
 bool readInputFile(const char *fileName,BufStr &inBuf,
                    bool filter=TRUE,bool isSourceCode=FALSE);
+bool readInputFileWithFilter(const char *fileName,BufStr &inBuf,
+                   const QCString &filterName,const QCString &inputEncoding,
+                   const QCString &filterCacheDir=QCString());
 QCString filterTitle(const QCString &title);
 
 bool patternMatch(const QFileInfo &fi,const QStrList *patList);
 
+/** @brief A list of wildcard patterns, such as FILE_PATTERNS or
+ *  EXCLUDE_PATTERNS, that is compiled once and can then be matched against
+ *  many files. A compiled list can be used from several threads at once.
+ */
+class FilePatternMatcher
+{
+  public:
+    FilePatternMatcher(const QStrList *patList);
+   ~FilePatternMatcher();
+
+    /** Returns TRUE if one of the patterns matches the name \a fileName
+     *  of a file, its path \a filePath or its absolute path \a absFilePath.
+     */
+    bool match(const QCString &fileName,const QCString &filePath,
+               const QCString &absFilePath) const;
+
+  private:
+    class Private;
+    Private *p;
+};
+
 QCString externalLinkTarget();
 QCString externalRef(const QCString &relPath,const QCString &ref,bool href);
 int nextUtf8CharPosition(const QCString &utf8Str,int len,int startPos);
@@ -428,6 +452,8 @@ void writeColoredImgData(const char *dir,ColoredImgDataItem data[]);
 QCString replaceColorMarkers(const char *str);
 
 bool copyFile(const QCString &src,const QCString &dest);
+
+int numProcThreads();
 QCString extractBlock(const QCString text,const QCString marker);
 
 QCString correctURL(const QCString &url,const QCString &relPath);
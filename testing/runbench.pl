@@ -0,0 +1,411 @@
+#!/usr/bin/perl
+
+# perl script to run doxygen's performance benchmark.
+#
+# Copyright (C) 1997-2013 by Dimitri van Heesch.
+#
+# Permission to use, copy, modify, and distribute this software and its
+# documentation under the terms of the GNU General Public License is hereby
+# granted. No representations are made about the suitability of this software
+# for any purpose. It is provided "as is" without express or implied warranty.
+# See the GNU General Public License for more details.
+#
+# Documents produced by Doxygen are derivative works derived from the
+# input used in their production; they are not affected by this license.
+
+use strict;
+use warnings;
+
+use Getopt::Long;
+use File::Path qw(make_path remove_tree);
+use File::Find;
+use JSON::PP;
+use Time::HiRes qw(time);
+
+my $opt_doxygen_exe = 'doxygen';
+my $opt_dot_exe     = 'dot';
+my $opt_files       = 50;   # number of files per language
+my $opt_classes     = 10;   # number of classes per file
+my $opt_depth       = 6;    # depth of the template hierarchies
+my $opt_seed        = 1;
+my $opt_repeat      = 1;
+my $opt_output      = 'bench_results.json';
+my $opt_baseline    = '';
+my $opt_tolerance   = 10;   # allowed slow down in percent
+my $opt_workdir     = 'bench_output';
+my $opt_generate    = '';
+my $opt_keep        = '';
+my @opt_configs;
+
+GetOptions( 'doxygen=s'   => \$opt_doxygen_exe,
+            'dot=s'       => \$opt_dot_exe,
+            'files=i'     => \$opt_files,
+            'classes=i'   => \$opt_classes,
+            'depth=i'     => \$opt_depth,
+            'seed=i'      => \$opt_seed,
+            'repeat=i'    => \$opt_repeat,
+            'output=s'    => \$opt_output,
+            'baseline=s'  => \$opt_baseline,
+            'tolerance=f' => \$opt_tolerance,
+            'workdir=s'   => \$opt_workdir,
+            'generate'    => \$opt_generate,
+            'keep'        => \$opt_keep,
+            'config=s'    => \@opt_configs
+          );
+
+# the doxygen configurations that are measured, on top of the common settings
+my %configs = (
+  'html'        => [ 'GENERATE_HTML = YES' ],
+  'xml'         => [ 'GENERATE_XML = YES' ],
+  'html_source' => [ 'GENERATE_HTML = YES',
+                     'SOURCE_BROWSER = YES',
+                     'REFERENCED_BY_RELATION = YES',
+                     'REFERENCES_RELATION = YES' ],
+  'callgraph'   => [ 'GENERATE_HTML = YES',
+                     'SOURCE_BROWSER = YES',
+                     'HAVE_DOT = YES',
+                     'CALL_GRAPH = YES',
+                     'CALLER_GRAPH = YES' ]
+);
+my @config_order = ('html','xml','html_source','callgraph');
+
+my @common_config = (
+  'QUIET = NO', # the timing summary is printed via the progress messages
+  'WARNINGS = NO',
+  'EXTRACT_ALL = YES',
+  'RECURSIVE = YES',
+  'ENABLE_PREPROCESSING = YES',
+  'MACRO_EXPANSION = YES',
+  'GENERATE_HTML = NO',
+  'GENERATE_LATEX = NO',
+  'GENERATE_XML = NO',
+  'SEARCHENGINE = NO',
+  'FILE_PATTERNS = *.h *.cpp *.java *.py *.md'
+);
+
+#---------------------------------------------------------------------------
+# deterministic corpus generator
+#---------------------------------------------------------------------------
+
+# linear congruential generator, so the corpus is the same on every platform
+my $rand_state;
+
+sub rand_init {
+  $rand_state = shift;
+}
+
+sub rand_int {
+  my $n = shift;
+  $rand_state = ($rand_state * 1103515245 + 12345) % 2147483648;
+  return int(($rand_state / 65536) % $n);
+}
+
+my @words = qw(buffer stream parser node tree graph cache index table entry
+               reader writer filter handle queue block token symbol scope
+               context layout engine driver channel record source target);
+
+sub rand_word {
+  return $words[rand_int(scalar(@words))];
+}
+
+sub rand_sentence {
+  my $n = shift;
+  my @s;
+  for (my $i=0;$i<$n;$i++) { push @s, rand_word(); }
+  return ucfirst(join(' ',@s)).'.';
+}
+
+sub write_file {
+  my $name = shift;
+  my $text = shift;
+  open(F,">$name") or die "Failed to open $name for writing: $!\n";
+  print F $text;
+  close(F);
+}
+
+sub cpp_class_name {
+  my ($f,$c) = @_;
+  return "Class${f}_${c}";
+}
+
+sub generate_cpp {
+  my $dir = shift;
+  make_path("$dir/cpp");
+  for (my $f=0;$f<$opt_files;$f++) {
+    my $h = "/** \\file file$f.h\n *  \\brief ".rand_sentence(6)."\n */\n\n";
+    $h .= "#ifndef FILE${f}_H\n#define FILE${f}_H\n\n";
+    $h .= "#include \"file".($f-1).".h\"\n\n" if $f>0;
+    $h .= "#define DECLARE_PROPERTY_$f(type,name) \\\n".
+          "  public: type get_##name() const { return m_##name; } \\\n".
+          "          void set_##name(type v) { m_##name = v; } \\\n".
+          "  private: type m_##name;\n\n";
+    $h .= "namespace ns$f {\n\n";
+    # a template hierarchy
+    $h .= "/** \\brief Root of template hierarchy $f. */\n";
+    $h .= "template<class T> class Base${f}_0\n{\n  public:\n".
+          "    /** Returns the value. */\n    T value() const { return T(); }\n};\n\n";
+    for (my $d=1;$d<$opt_depth;$d++) {
+      $h .= "/** \\brief Level $d of template hierarchy $f, see Base${f}_".($d-1).". */\n";
+      $h .= "template<class T,int N=$d> class Base${f}_$d : public Base${f}_".($d-1)."<T>\n{\n".
+            "  public:\n    /** ".rand_sentence(5)." */\n    virtual T level$d(T t) const { return t; }\n};\n\n";
+    }
+    my $cpp = "#include \"file$f.h\"\n\nnamespace ns$f {\n\n";
+    for (my $c=0;$c<$opt_classes;$c++) {
+      my $name = cpp_class_name($f,$c);
+      my $base = $c>0 ? cpp_class_name($f,rand_int($c)) : "Base${f}_".($opt_depth-1)."<int>";
+      my $rf   = rand_int($f+1);
+      my $ref  = ($rf==$f ? '' : "ns${rf}::").cpp_class_name($rf,rand_int($opt_classes));
+      $h .= "/** \\brief ".rand_sentence(8)."\n *\n *  ".rand_sentence(20)."\n".
+            " *  \\sa $ref\n */\n";
+      $h .= "class $name : public $base\n{\n";
+      $h .= "    DECLARE_PROPERTY_$f(int,count)\n";
+      $h .= "    DECLARE_PROPERTY_$f(const char *,label)\n";
+      $h .= "  public:\n";
+      $h .= "    /** Creates a new $name. */\n    $name();\n";
+      for (my $m=0;$m<4;$m++) {
+        my $word = rand_word();
+        $h .= "    /** ".rand_sentence(6)."\n     *  \\param $word the $word to use\n".
+              "     *  \\returns the number of ".rand_word()."s\n     */\n";
+        $h .= "    int method$m(int $word);\n";
+        $cpp .= "int ${name}::method$m(int $word)\n{\n";
+        $cpp .= "  $name other;\n  return method".(($m+1)%4)."($word-1)+other.get_count();\n" if $m<3;
+        $cpp .= "  return $word;\n" if $m==3;
+        $cpp .= "}\n\n";
+      }
+      $h .= "};\n\n";
+      $cpp .= "${name}::$name()\n{\n  set_count(0);\n}\n\n";
+    }
+    $h .= "} // namespace ns$f\n\n#endif\n";
+    $cpp .= "} // namespace ns$f\n";
+    write_file("$dir/cpp/file$f.h",$h);
+    write_file("$dir/cpp/file$f.cpp",$cpp);
+  }
+}
+
+sub generate_java {
+  my $dir = shift;
+  make_path("$dir/java");
+  for (my $f=0;$f<$opt_files;$f++) {
+    my $j = "package pkg$f;\n\n";
+    $j .= "import pkg".($f-1).".*;\n\n" if $f>0;
+    $j .= "/** ".rand_sentence(8)." */\npublic class Java$f\n{\n";
+    for (my $c=0;$c<$opt_classes;$c++) {
+      my $base = $c>0 ? "Inner${f}_".($c-1) : "Object";
+      $j .= "  /**\n   * ".rand_sentence(12)."\n   * \@see Inner${f}_".rand_int($opt_classes)."\n   */\n";
+      $j .= "  public static class Inner${f}_$c extends $base\n  {\n";
+      for (my $m=0;$m<3;$m++) {
+        my $word = rand_word();
+        $j .= "    /**\n     * ".rand_sentence(6)."\n     * \@param $word the $word\n".
+              "     * \@return the result\n     */\n";
+        $j .= "    public int method$m(int $word) { return $word+$m; }\n";
+      }
+      $j .= "  }\n";
+    }
+    $j .= "}\n";
+    write_file("$dir/java/Java$f.java",$j);
+  }
+}
+
+sub generate_python {
+  my $dir = shift;
+  make_path("$dir/python");
+  for (my $f=0;$f<$opt_files;$f++) {
+    my $p = "## \@package module$f\n#  ".rand_sentence(8)."\n\n";
+    for (my $c=0;$c<$opt_classes;$c++) {
+      my $base = $c>0 ? "Py$f"."_".rand_int($c) : "object";
+      $p .= "## ".rand_sentence(10)."\nclass Py$f"."_$c($base):\n";
+      for (my $m=0;$m<3;$m++) {
+        my $word = rand_word();
+        $p .= "    ## ".rand_sentence(6)."\n    #  \@param $word the $word\n";
+        $p .= "    def method$m(self, $word):\n        return $word\n\n";
+      }
+    }
+    write_file("$dir/python/module$f.py",$p);
+  }
+}
+
+sub generate_markdown {
+  my $dir = shift;
+  make_path("$dir/markdown");
+  for (my $f=0;$f<$opt_files;$f++) {
+    my $m = "Page $f {#page$f}\n=======\n\n";
+    for (my $s=0;$s<5;$s++) {
+      $m .= "Section $s {#page${f}_sec$s}\n-------\n\n".rand_sentence(30)."\n\n";
+      my $rf = rand_int($opt_files);
+      $m .= "- See ns${rf}::".cpp_class_name($rf,rand_int($opt_classes))."\n";
+      $m .= "- See \\ref page".rand_int($opt_files)."\n";
+      $m .= "- *".rand_word()."* and **".rand_word()."**\n\n";
+      $m .= "    int code_$s = $s;\n\n";
+    }
+    write_file("$dir/markdown/page$f.md",$m);
+  }
+}
+
+sub generate_corpus {
+  my $dir = shift;
+  remove_tree($dir);
+  rand_init($opt_seed);
+  generate_cpp($dir);
+  generate_java($dir);
+  generate_python($dir);
+  generate_markdown($dir);
+}
+
+#---------------------------------------------------------------------------
+# running and measuring doxygen
+#---------------------------------------------------------------------------
+
+sub dir_size {
+  my $dir = shift;
+  my $size = 0;
+  find(sub { $size += -s $_ if -f $_; }, $dir) if -d $dir;
+  return $size;
+}
+
+sub read_trace {
+  my $file = shift;
+  my $peak = 0;
+  local $/;
+  open(F,"<$file") or return 0;
+  my $trace = decode_json(<F>);
+  close(F);
+  foreach my $e (@{$trace->{'traceEvents'}}) {
+    if ($e->{'ph'} eq 'C' && $e->{'name'} eq 'peak RSS (kB)') {
+      $peak = $e->{'args'}{'value'} if $e->{'args'}{'value'}>$peak;
+    }
+  }
+  return $peak;
+}
+
+sub run_config {
+  my ($name,$corpus) = @_;
+  my $out = "$opt_workdir/$name";
+  my $best;
+  for (my $r=0;$r<$opt_repeat;$r++) {
+    remove_tree($out);
+    make_path($out);
+    open(F,">$out/Doxyfile");
+    foreach my $cfg (@common_config,@{$configs{$name}}) {
+      print F "$cfg\n";
+    }
+    print F "DOT_PATH = $opt_dot_exe\n" if $opt_dot_exe =~ /\//;
+    print F "INPUT = $corpus\n";
+    print F "OUTPUT_DIRECTORY = $out/out\n";
+    close(F);
+
+    my $start = time();
+    my @lines = `$opt_doxygen_exe -d time -t $out/trace.json $out/Doxyfile`;
+    my $wall = time()-$start;
+    if ($?!=0) {
+      print "Error: failed to run doxygen for configuration $name\n";
+      return undef;
+    }
+    my %phases;
+    my $total = 0;
+    foreach my $line (@lines) {
+      if ($line =~ /^Spent\s+([\d.]+)\s+seconds in (.*?)\s*$/) {
+        my ($secs,$phase) = ($1,$2);
+        $phase =~ s/\.+$//;
+        $phases{$phase} += $secs;
+      } elsif ($line =~ /Total elapsed time:\s+([\d.]+)/) {
+        $total = $1+0;
+      }
+    }
+    my %result = (
+      'wall'         => $wall+0,
+      'total'        => $total,
+      'peak_rss_kb'  => read_trace("$out/trace.json"),
+      'output_bytes' => dir_size("$out/out"),
+      'phases'       => \%phases
+    );
+    $best = \%result if !defined($best) || $result{'wall'}<$best->{'wall'};
+  }
+  remove_tree("$out/out") unless $opt_keep;
+  return $best;
+}
+
+sub compare_baseline {
+  my ($results,$baseline) = @_;
+  my $regressions = 0;
+  my $limit = 1+$opt_tolerance/100;
+  # differences below these are considered noise
+  my %min_diff = ( 'wall' => 0.1, 'peak_rss_kb' => 1024 );
+  foreach my $name (@config_order) {
+    my $new = $results->{'runs'}{$name};
+    my $old = $baseline->{'runs'}{$name};
+    next unless defined($new) && defined($old);
+    foreach my $key ('wall','peak_rss_kb') {
+      next unless $old->{$key}>0;
+      my $ratio = $new->{$key}/$old->{$key};
+      my $slower = $ratio>$limit && $new->{$key}-$old->{$key}>$min_diff{$key};
+      printf("%-12s %-12s %12.2f %12.2f %+7.1f%%  %s\n",$name,$key,
+             $old->{$key},$new->{$key},($ratio-1)*100,$slower ? 'REGRESSION' : 'ok');
+      $regressions++ if $slower;
+    }
+    if ($new->{'output_bytes'}!=$old->{'output_bytes'}) {
+      printf("%-12s %-12s %12d %12d  changed\n",$name,'output_bytes',
+             $old->{'output_bytes'},$new->{'output_bytes'});
+    }
+  }
+  return $regressions;
+}
+
+#---------------------------------------------------------------------------
+
+my $corpus = "$opt_workdir/corpus";
+print "Generating corpus in $corpus\n";
+generate_corpus($corpus);
+exit(0) if $opt_generate;
+
+@opt_configs = @config_order if scalar(@opt_configs)==0;
+foreach my $name (@opt_configs) {
+  die "Unknown configuration $name, should be one of @config_order\n" unless $configs{$name};
+}
+if (grep { $_ eq 'callgraph' } @opt_configs) {
+  if (system("$opt_dot_exe -V >/dev/null 2>&1")!=0) {
+    print "Skipping configuration callgraph: $opt_dot_exe not found\n";
+    @opt_configs = grep { $_ ne 'callgraph' } @opt_configs;
+  }
+}
+
+my $version = `$opt_doxygen_exe --version`;
+chomp $version;
+my %results = (
+  'doxygen' => $version,
+  'corpus'  => { 'files' => $opt_files, 'classes' => $opt_classes,
+                 'depth' => $opt_depth, 'seed'    => $opt_seed },
+  'runs'    => {}
+);
+my $failed = 0;
+foreach my $name (@opt_configs) {
+  print "Running configuration $name\n";
+  my $result = run_config($name,$corpus);
+  if (defined($result)) {
+    $results{'runs'}{$name} = $result;
+    printf("  %.2f seconds, peak RSS %d kB, %d bytes of output\n",
+           $result->{'wall'},$result->{'peak_rss_kb'},$result->{'output_bytes'});
+  } else {
+    $failed = 1;
+  }
+}
+
+open(F,">$opt_output") or die "Failed to open $opt_output for writing: $!\n";
+print F JSON::PP->new->pretty->canonical->encode(\%results);
+close(F);
+print "Results written to $opt_output\n";
+
+if ($opt_baseline) {
+  local $/;
+  open(F,"<$opt_baseline") or die "Failed to open baseline $opt_baseline: $!\n";
+  my $baseline = decode_json(<F>);
+  close(F);
+  if ($baseline->{'corpus'}{'files'}!=$opt_files || $baseline->{'corpus'}{'classes'}!=$opt_classes ||
+      $baseline->{'corpus'}{'depth'}!=$opt_depth || $baseline->{'corpus'}{'seed'}!=$opt_seed) {
+    print "Warning: baseline was measured with a different corpus\n";
+  }
+  my $regressions = compare_baseline(\%results,$baseline);
+  print "$regressions regression(s) of more than $opt_tolerance% compared to $opt_baseline\n";
+  $failed = 1 if $regressions>0;
+}
+
+exit($failed);